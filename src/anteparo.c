@@ -22,24 +22,17 @@ typedef struct{
 
 
 
-typedef struct 
-{
-    tipo_forma tipo;
-    void* data;
-}Forma_t;
-
-
-static Anteparo transforma_circulo(Forma_t* circulo_original, char h_ou_v, int maior_id);
-static Anteparo transforma_retangulo(Forma_t* retangulo_original, int *maior_id, Anteparo *anteparos);
-static Anteparo transforma_linha(Forma_t* linha_original, int maior_id);
-static Anteparo transforma_texto(Forma_t* texto_original, int maior_id);
+static Anteparo transforma_circulo(Forma circulo_original, char h_ou_v, int maior_id);
+static Anteparo transforma_retangulo(Forma retangulo_original, int *maior_id, Anteparo *anteparos);
+static Anteparo transforma_linha(Forma linha_original, int maior_id);
+static Anteparo transforma_texto(Forma texto_original, int maior_id);
 
 
 Anteparo transforma_em_anteparo(void* forma_original,  char h_ou_v, int maior_id){
 
-    Forma_t* forma = (Forma_t*)forma_original;
+    Forma forma = (Forma)forma_original;
     
-    switch (forma->tipo)
+    switch (getTipoForma(forma))
     {
     case CIRCLE:
         return transforma_circulo(forma, h_ou_v, maior_id);
@@ -61,7 +54,7 @@ Anteparo transforma_em_anteparo(void* forma_original,  char h_ou_v, int maior_id
 }
 
 
-static Anteparo transforma_circulo(Forma_t* circulo_original, char h_ou_v, int maior_id){
+static Anteparo transforma_circulo(Forma circulo_original, char h_ou_v, int maior_id){
 
 
     Anteparo_T* a =(Anteparo_T*)malloc(sizeof(Anteparo_T)); 
@@ -77,34 +70,34 @@ static Anteparo transforma_circulo(Forma_t* circulo_original, char h_ou_v, int m
       
       if(h_ou_v == 'h'){
 
-        a->x1 = getXCirculo(circulo_original->data) - getRaioCirculo(circulo_original->data);
-        a->x2 = getXCirculo(circulo_original->data) + getRaioCirculo(circulo_original->data);   
-        a->y1 = getYCirculo(circulo_original->data);
+        a->x1 = getXCirculo(getDataForma(circulo_original)) - getRaioCirculo(getDataForma(circulo_original));
+        a->x2 = getXCirculo(getDataForma(circulo_original)) + getRaioCirculo(getDataForma(circulo_original));   
+        a->y1 = getYCirculo(getDataForma(circulo_original));
         a->y2 = a->y1;
 
 
       }else {
 
 
-        a->y1 = getYCirculo(circulo_original->data) - getRaioCirculo(circulo_original->data);
-        a->y2 = getYCirculo(circulo_original->data) + getRaioCirculo(circulo_original->data);
-        a->x1 = getXCirculo(circulo_original->data);
+        a->y1 = getYCirculo(getDataForma(circulo_original)) - getRaioCirculo(getDataForma(circulo_original));
+        a->y2 = getYCirculo(getDataForma(circulo_original)) + getRaioCirculo(getDataForma(circulo_original));
+        a->x1 = getXCirculo(getDataForma(circulo_original));
         a->x2 = a->x1; 
       }
 
-      a->cor =(char*)malloc(sizeof(char)*(strlen(getCorBCirculo(circulo_original->data)) + 1));
+      a->cor =(char*)malloc(sizeof(char)*(strlen(getCorBCirculo(getDataForma(circulo_original))) + 1));
       if(a->cor == NULL){
 
         printf("erro de alocação para a cor do anteparo");
         exit(1);
     }
-      strcpy(a->cor, getCorBCirculo(circulo_original->data));
+      strcpy(a->cor, getCorBCirculo(getDataForma(circulo_original)));
       return a;
 }
 
-static Anteparo transforma_retangulo(Forma_t* retangulo_original, int *maior_id, Anteparo *anteparos){
+static Anteparo transforma_retangulo(Forma retangulo_original, int *maior_id, Anteparo *anteparos){
   
-  RETANGULO r = (RETANGULO)retangulo_original->data;
+  RETANGULO r = (RETANGULO)getDataForma(retangulo_original);
   float x = getXRetangulo(r);
   float y = getYRetangulo(r);
   float largura = getLarguraRetangulo(r);
@@ -165,7 +158,7 @@ static Anteparo transforma_retangulo(Forma_t* retangulo_original, int *maior_id,
 }
 
 
-static Anteparo transforma_linha(Forma_t* linha_original, int maior_id){
+static Anteparo transforma_linha(Forma linha_original, int maior_id){
 
   Anteparo_T* a = (Anteparo_T*)malloc(sizeof(Anteparo_T));
 
@@ -176,12 +169,12 @@ static Anteparo transforma_linha(Forma_t* linha_original, int maior_id){
   }
 
   a->id = maior_id;
-  a->x1 = getX1Linha(linha_original->data);
-  a->x2 = getX2Linha(linha_original->data);
-  a->y1 = getY1Linha(linha_original->data);
-  a->y2 = getY2Linha(linha_original->data);
+  a->x1 = getX1Linha(getDataForma(linha_original));
+  a->x2 = getX2Linha(getDataForma(linha_original));
+  a->y1 = getY1Linha(getDataForma(linha_original));
+  a->y2 = getY2Linha(getDataForma(linha_original));
 
-  a->cor =(char*)malloc(sizeof(char)*(strlen(getCorLinha(linha_original->data)) + 1));
+  a->cor =(char*)malloc(sizeof(char)*(strlen(getCorLinha(getDataForma(linha_original))) + 1));
 
   if(a->cor == NULL){
 
@@ -189,14 +182,14 @@ static Anteparo transforma_linha(Forma_t* linha_original, int maior_id){
     exit(1);
   }
 
-  strcpy(a->cor, getCorLinha(linha_original->data));
+  strcpy(a->cor, getCorLinha(getDataForma(linha_original)));
 
   return a;
 }
 
 
 
-static Anteparo transforma_texto(Forma_t* texto_original, int maior_id){
+static Anteparo transforma_texto(Forma texto_original, int maior_id){
 
     Anteparo_T* a = (Anteparo_T*)malloc(sizeof(Anteparo_T));
 
@@ -209,37 +202,37 @@ static Anteparo transforma_texto(Forma_t* texto_original, int maior_id){
   a->id = maior_id;
 
   
-  char ancora = getAncoraTexto(texto_original->data);
+  char ancora = getAncoraTexto(getDataForma(texto_original));
 
 
   if(ancora == 'i'){
 
-    a->x1 = getXTexto(texto_original->data);
-    a->x2 = a->x1 + 10*strlen(getTxtTexto(texto_original->data));
-    a->y1 = getYTexto(texto_original->data);
+    a->x1 = getXTexto(getDataForma(texto_original));
+    a->x2 = a->x1 + 10*strlen(getTxtTexto(getDataForma(texto_original)));
+    a->y1 = getYTexto(getDataForma(texto_original));
     a->y2 = a->y1;
   }else if(ancora == 'f'){
 
 
-    a->x2 = getXTexto(texto_original->data);
-    a->y2 = getYTexto(texto_original->data);
+    a->x2 = getXTexto(getDataForma(texto_original));
+    a->y2 = getYTexto(getDataForma(texto_original));
     a->y1 = a->y2;
-    a->x1 = a->x2 -10*strlen(getTxtTexto(texto_original->data));
+    a->x1 = a->x2 -10*strlen(getTxtTexto(getDataForma(texto_original)));
   }else if(ancora == 'm'){
 
-    a->x1 = getXTexto(texto_original->data) - 5*strlen(getTxtTexto(texto_original->data));
-    a->x2 = getXTexto(texto_original->data) + 5*strlen(getTxtTexto(texto_original->data));
-    a->y1 = getYTexto(texto_original->data);
+    a->x1 = getXTexto(getDataForma(texto_original)) - 5*strlen(getTxtTexto(getDataForma(texto_original)));
+    a->x2 = getXTexto(getDataForma(texto_original)) + 5*strlen(getTxtTexto(getDataForma(texto_original)));
+    a->y1 = getYTexto(getDataForma(texto_original));
     a->y2 = a->y1;
 
   }
   
-  a->cor = (char*)malloc(sizeof(char)*(strlen(getCorBTexto(texto_original->data)) + 1));
+  a->cor = (char*)malloc(sizeof(char)*(strlen(getCorBTexto(getDataForma(texto_original))) + 1));
   if(a->cor == NULL){
     printf("erro de alocação da cor do anteparo");
     exit(1);
   }
-  strcpy(a->cor, getCorBTexto(texto_original->data));
+  strcpy(a->cor, getCorBTexto(getDataForma(texto_original)));
   
   return a;
 }
@@ -289,18 +282,26 @@ char* getCorAnteparo(Anteparo a){
 void desalocaAnteparo(Anteparo a){
   if(a == NULL) return;
   
+  desalocaCamposAnteparo(a);
+  free(a);
+}
+
+void desalocaCamposAnteparo(Anteparo a){
+  if(a == NULL) return;
+  
   Anteparo_T* aTemp = ((Anteparo_T*)a);
   
   if(aTemp->cor != NULL){
     free(aTemp->cor);
   }
-  
-  free(aTemp);
+}
+
+size_t getTamanhoAnteparo(void){
+  return sizeof(Anteparo_T);
 }
 
 Anteparo transforma_retangulo_em_anteparos(void* forma_original, int *maior_id, Anteparo *anteparos){
-  Forma_t* forma = (Forma_t*)forma_original;
-  return transforma_retangulo(forma, maior_id, anteparos);
+  return transforma_retangulo((Forma)forma_original, maior_id, anteparos);
 }
 
 void setCorAnteparo(Anteparo a, const char* nova_cor){
@@ -325,7 +326,6 @@ void setCorAnteparo(Anteparo a, const char* nova_cor){
 Anteparo clonaAnteparo(Anteparo a, int novo_id, float dx, float dy){
   if(a == NULL) return NULL;
   
-  Anteparo_T* aTemp = ((Anteparo_T*)a);
   Anteparo_T* clone = (Anteparo_T*)malloc(sizeof(Anteparo_T));
   
   if(clone == NULL){
@@ -333,6 +333,14 @@ Anteparo clonaAnteparo(Anteparo a, int novo_id, float dx, float dy){
     exit(1);
   }
   
+  clonaAnteparoEm(clone, a, novo_id, dx, dy);
+  return clone;
+}
+
+void clonaAnteparoEm(void* destino, Anteparo a, int novo_id, float dx, float dy){
+  Anteparo_T* aTemp = ((Anteparo_T*)a);
+  Anteparo_T* clone = ((Anteparo_T*)destino);
+  
   clone->id = novo_id;
   clone->x1 = aTemp->x1 + dx;
   clone->x2 = aTemp->x2 + dx;
@@ -346,6 +354,4 @@ Anteparo clonaAnteparo(Anteparo a, int novo_id, float dx, float dy){
     exit(1);
   }
   strcpy(clone->cor, aTemp->cor);
-  
-  return clone;
 }
@@ -63,9 +63,25 @@ void setCorAnteparo(Anteparo a, const char* nova_cor);
  */
 Anteparo clonaAnteparo(Anteparo a, int novo_id, float dx, float dy);
 
+/**
+ * @brief Escreve um clone do anteparo na memória indicada, que deve ter
+ * getTamanhoAnteparo() bytes (ver clonaAnteparo()).
+ */
+void clonaAnteparoEm(void* destino, Anteparo a, int novo_id, float dx, float dy);
+
 /**
  * @brief Desaloca um anteparo
  */
 void desalocaAnteparo(Anteparo a);
 
+/**
+ * @brief Libera a cor do anteparo, mas não a estrutura em si (ver criaForma()).
+ */
+void desalocaCamposAnteparo(Anteparo a);
+
+/**
+ * @brief Retorna o tamanho, em bytes, da estrutura de um anteparo.
+ */
+size_t getTamanhoAnteparo(void);
+
 #endif
\ No newline at end of file
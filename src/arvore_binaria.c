@@ -10,17 +10,92 @@ typedef struct NoImpl {
     struct NoImpl* pai;
 } NoImpl;
 
+// Bloco de nós do pool; os blocos formam uma lista e nunca são liberados
+// antes da árvore
+typedef struct BlocoNos {
+    struct BlocoNos* prox;
+    int usados;
+    NoImpl nos[];
+} BlocoNos;
+
+// Pool de nós: os nós vêm de blocos, e os removidos vão para uma lista livre
+// encadeada pelo campo esq
+typedef struct {
+    BlocoNos* primeiro;
+    BlocoNos* atual;    // Bloco de onde saem os nós ainda não usados
+    NoImpl* livres;
+    int nos_por_bloco;
+} PoolNos;
+
 typedef struct {
     NoImpl* raiz;
     FuncaoComparacao comparar;
     void* contexto;
     int tamanho;
+    PoolNos* pool;      // NULL: cada nó é alocado com malloc
 } ArvoreImpl;
 
+// Nós por bloco quando nenhum número é pedido
+#define POOL_NOS_POR_BLOCO_PADRAO 256
+
+
+
+static NoImpl* alocar_no_pool(PoolNos* pool) {
+    if (pool->livres != NULL) {
+        NoImpl* no = pool->livres;
+        pool->livres = no->esq;
+        return no;
+    }
+
+    BlocoNos* bloco = pool->atual;
+    if (bloco != NULL && bloco->usados == pool->nos_por_bloco) {
+        // Depois de um reset os blocos seguintes são reaproveitados
+        bloco = bloco->prox;
+        if (bloco != NULL) {
+            bloco->usados = 0;
+            pool->atual = bloco;
+        }
+    }
+
+    if (bloco == NULL) {
+        bloco = malloc(sizeof(BlocoNos) + pool->nos_por_bloco * sizeof(NoImpl));
+        if (bloco == NULL) {
+            return NULL;
+        }
+        bloco->prox = NULL;
+        bloco->usados = 0;
+        if (pool->atual != NULL) {
+            pool->atual->prox = bloco;
+        } else {
+            pool->primeiro = bloco;
+        }
+        pool->atual = bloco;
+    }
 
+    return &bloco->nos[bloco->usados++];
+}
 
-static NoImpl* criar_no(void* dado) {
-    NoImpl* no = malloc(sizeof(NoImpl));
+static void devolver_no(ArvoreImpl* arvore, NoImpl* no) {
+    if (arvore->pool == NULL) {
+        free(no);
+        return;
+    }
+
+    no->esq = arvore->pool->livres;
+    arvore->pool->livres = no;
+}
+
+// Todos os nós voltam a estar livres, sem percorrer a árvore
+static void resetar_pool(PoolNos* pool) {
+    pool->livres = NULL;
+    pool->atual = pool->primeiro;
+    if (pool->primeiro != NULL) {
+        pool->primeiro->usados = 0;
+    }
+}
+
+static NoImpl* criar_no(ArvoreImpl* arvore, void* dado) {
+    NoImpl* no = arvore->pool ? alocar_no_pool(arvore->pool) : malloc(sizeof(NoImpl));
     if (no == NULL) {
         return NULL;
     }
@@ -73,19 +148,22 @@ static void transplantar(ArvoreImpl* arvore, NoImpl* u, NoImpl* v) {
     }
 }
 
-static void limpar_subarvore(NoImpl* no, FuncaoDesalocacao desalocar) {
+// Com pool os nós não são liberados um a um (liberar_nos == false)
+static void limpar_subarvore(NoImpl* no, FuncaoDesalocacao desalocar, bool liberar_nos) {
     if (no == NULL) {
         return;
     }
 
-    limpar_subarvore(no->esq, desalocar);
-    limpar_subarvore(no->dir, desalocar);
+    limpar_subarvore(no->esq, desalocar, liberar_nos);
+    limpar_subarvore(no->dir, desalocar, liberar_nos);
 
     if (desalocar != NULL && no->dado != NULL) {
         desalocar(no->dado);
     }
 
-    free(no);
+    if (liberar_nos) {
+        free(no);
+    }
 }
 
 
@@ -104,6 +182,29 @@ ArvoreBinaria criaArvoreBinaria(FuncaoComparacao comparar, void* contexto) {
     arvore->comparar = comparar;
     arvore->contexto = contexto;
     arvore->tamanho = 0;
+    arvore->pool = NULL;
+
+    return (ArvoreBinaria)arvore;
+}
+
+ArvoreBinaria criaArvoreBinariaComPool(FuncaoComparacao comparar, void* contexto,
+                                       int nos_por_bloco) {
+    ArvoreImpl* arvore = (ArvoreImpl*)criaArvoreBinaria(comparar, contexto);
+    if (arvore == NULL) {
+        return NULL;
+    }
+
+    PoolNos* pool = malloc(sizeof(PoolNos));
+    if (pool == NULL) {
+        free(arvore);
+        return NULL;
+    }
+
+    pool->primeiro = NULL;
+    pool->atual = NULL;
+    pool->livres = NULL;
+    pool->nos_por_bloco = nos_por_bloco > 0 ? nos_por_bloco : POOL_NOS_POR_BLOCO_PADRAO;
+    arvore->pool = pool;
 
     return (ArvoreBinaria)arvore;
 }
@@ -114,7 +215,7 @@ NoArvore insereArvoreBinaria(ArvoreBinaria arvore, void* dado) {
     }
 
     ArvoreImpl* impl = (ArvoreImpl*)arvore;
-    NoImpl* novo_no = criar_no(dado);
+    NoImpl* novo_no = criar_no(impl, dado);
     if (novo_no == NULL) {
         return NULL;
     }
@@ -188,7 +289,7 @@ void removeNoArvore(ArvoreBinaria arvore, NoArvore no) {
         y->esq->pai = y;
     }
 
-    free(z);
+    devolver_no(impl, z);
     impl->tamanho--;
 }
 
@@ -258,10 +359,61 @@ NoArvore getMenorNo(ArvoreBinaria arvore) {
 }
 
 void* getMaiorElemento(ArvoreBinaria arvore) {
-    if (arvore == NULL) return NULL;
+    NoArvore no = getMaiorNo(arvore);
+    return getDadoNo(no);
+}
+
+NoArvore getMaiorNo(ArvoreBinaria arvore) {
+    if (arvore == NULL) {
+        return NULL;
+    }
+
+    ArvoreImpl* impl = (ArvoreImpl*)arvore;
+    return (NoArvore)encontrar_maximo_interno(impl->raiz);
+}
+
+NoArvore getPrimeiroNoMaiorOuIgual(ArvoreBinaria arvore, const void* chave) {
+    if (arvore == NULL || chave == NULL) {
+        return NULL;
+    }
+
+    ArvoreImpl* impl = (ArvoreImpl*)arvore;
+    NoImpl* atual = impl->raiz;
+    NoImpl* candidato = NULL;
+
+    // Desce guardando o último nó que não é menor que a chave
+    while (atual != NULL) {
+        if (impl->comparar(chave, atual->dado, impl->contexto) <= 0) {
+            candidato = atual;
+            atual = atual->esq;
+        } else {
+            atual = atual->dir;
+        }
+    }
+
+    return (NoArvore)candidato;
+}
+
+NoArvore getPrimeiroNoMaior(ArvoreBinaria arvore, const void* chave) {
+    if (arvore == NULL || chave == NULL) {
+        return NULL;
+    }
+
     ArvoreImpl* impl = (ArvoreImpl*)arvore;
-    NoImpl* max_no = encontrar_maximo_interno(impl->raiz);
-    return max_no ? max_no->dado : NULL;
+    NoImpl* atual = impl->raiz;
+    NoImpl* candidato = NULL;
+
+    // Desce guardando o último nó estritamente maior que a chave
+    while (atual != NULL) {
+        if (impl->comparar(chave, atual->dado, impl->contexto) < 0) {
+            candidato = atual;
+            atual = atual->esq;
+        } else {
+            atual = atual->dir;
+        }
+    }
+
+    return (NoArvore)candidato;
 }
 
 void* getDadoNo(NoArvore no) {
@@ -273,6 +425,58 @@ void* getDadoNo(NoArvore no) {
     return impl->dado;
 }
 
+NoArvore getProximoNo(NoArvore no) {
+    if (no == NULL) {
+        return NULL;
+    }
+
+    NoImpl* atual = (NoImpl*)no;
+    if (atual->dir != NULL) {
+        return (NoArvore)encontrar_minimo_interno(atual->dir);
+    }
+
+    // Sobe até chegar por um filho esquerdo
+    NoImpl* pai = atual->pai;
+    while (pai != NULL && atual == pai->dir) {
+        atual = pai;
+        pai = pai->pai;
+    }
+
+    return (NoArvore)pai;
+}
+
+NoArvore getAnteriorNo(NoArvore no) {
+    if (no == NULL) {
+        return NULL;
+    }
+
+    NoImpl* atual = (NoImpl*)no;
+    if (atual->esq != NULL) {
+        return (NoArvore)encontrar_maximo_interno(atual->esq);
+    }
+
+    // Sobe até chegar por um filho direito
+    NoImpl* pai = atual->pai;
+    while (pai != NULL && atual == pai->esq) {
+        atual = pai;
+        pai = pai->pai;
+    }
+
+    return (NoArvore)pai;
+}
+
+void trocaDadosNos(NoArvore a, NoArvore b) {
+    if (a == NULL || b == NULL) {
+        return;
+    }
+
+    NoImpl* na = (NoImpl*)a;
+    NoImpl* nb = (NoImpl*)b;
+    void* temp = na->dado;
+    na->dado = nb->dado;
+    nb->dado = temp;
+}
+
 bool arvoreVazia(ArvoreBinaria arvore) {
     if (arvore == NULL) {
         return true;
@@ -291,6 +495,25 @@ int tamanhoArvore(ArvoreBinaria arvore) {
     return impl->tamanho;
 }
 
+static int altura_subarvore(NoImpl* no) {
+    if (no == NULL) {
+        return 0;
+    }
+
+    int he = altura_subarvore(no->esq);
+    int hd = altura_subarvore(no->dir);
+    return 1 + (he > hd ? he : hd);
+}
+
+int alturaArvore(ArvoreBinaria arvore) {
+    if (arvore == NULL) {
+        return 0;
+    }
+
+    ArvoreImpl* impl = (ArvoreImpl*)arvore;
+    return altura_subarvore(impl->raiz);
+}
+
 
 void limpaArvoreBinaria(ArvoreBinaria arvore, FuncaoDesalocacao desalocar) {
     if (arvore == NULL) {
@@ -298,7 +521,15 @@ void limpaArvoreBinaria(ArvoreBinaria arvore, FuncaoDesalocacao desalocar) {
     }
 
     ArvoreImpl* impl = (ArvoreImpl*)arvore;
-    limpar_subarvore(impl->raiz, desalocar);
+    if (impl->pool == NULL) {
+        limpar_subarvore(impl->raiz, desalocar, true);
+    } else {
+        // Só é preciso percorrer a árvore se os dados também são liberados
+        if (desalocar != NULL) {
+            limpar_subarvore(impl->raiz, desalocar, false);
+        }
+        resetar_pool(impl->pool);
+    }
     impl->raiz = NULL;
     impl->tamanho = 0;
 }
@@ -309,18 +540,22 @@ void liberaArvoreBinaria(ArvoreBinaria arvore, FuncaoDesalocacao desalocar) {
     }
 
     limpaArvoreBinaria(arvore, desalocar);
+
+    ArvoreImpl* impl = (ArvoreImpl*)arvore;
+    if (impl->pool != NULL) {
+        BlocoNos* bloco = impl->pool->primeiro;
+        while (bloco != NULL) {
+            BlocoNos* prox = bloco->prox;
+            free(bloco);
+            bloco = prox;
+        }
+        free(impl->pool);
+    }
     free(arvore);
 }
 
 
 
-static void percorre_em_ordem_rec(NoImpl* no, void (*visita)(void*, void*), void* contexto) {
-    if (no == NULL) return;
-    percorre_em_ordem_rec(no->esq, visita, contexto);
-    visita(no->dado, contexto);
-    percorre_em_ordem_rec(no->dir, visita, contexto);
-}
-
 void** arvoreParaArray(ArvoreBinaria arvore, int* tamanho) {
     if (arvore == NULL || tamanho == NULL) {
         if (tamanho) *tamanho = 0;
@@ -335,19 +570,10 @@ void** arvoreParaArray(ArvoreBinaria arvore, int* tamanho) {
     void** array = malloc(sizeof(void*) * impl->tamanho);
     if (!array) return NULL;
 
-    // Estrutura auxiliar para preencher array
-    struct {
-        void** arr;
-        int idx;
-    } ctx = { array, 0 };
-
-   
-    void preencher(void* dado, void* c) {
-        struct { void** arr; int idx; } *contexto = c;
-        contexto->arr[contexto->idx++] = dado;
+    int i = 0;
+    for (NoImpl* no = encontrar_minimo_interno(impl->raiz); no; no = getProximoNo(no)) {
+        array[i++] = no->dado;
     }
 
-    percorre_em_ordem_rec(impl->raiz, preencher, &ctx);
-
     return array;
 }
@@ -43,6 +43,24 @@ typedef int (*FuncaoComparacao)(const void* a, const void* b, void* contexto);
  */
 ArvoreBinaria criaArvoreBinaria(FuncaoComparacao comparar, void* contexto);
 
+/**
+ * @brief Cria uma árvore binária de busca vazia cujos nós vêm de um pool.
+ * 
+ * Os nós são alocados em blocos de `nos_por_bloco`, e os removidos voltam
+ * para uma lista livre em vez de irem para o free. limpaArvoreBinaria()
+ * devolve todos os nós ao pool em O(1) (sem percorrer a árvore, se não há
+ * dados a desalocar), e os blocos só são liberados com a árvore. Indicada
+ * para árvores esvaziadas e preenchidas de novo muitas vezes, como o status
+ * de uma varredura.
+ * 
+ * @param comparar Função de comparação para ordenar elementos
+ * @param contexto Contexto adicional passado para a função de comparação
+ * @param nos_por_bloco Número de nós em cada bloco do pool (0 para o padrão)
+ * @return Ponteiro para a árvore criada ou NULL em caso de erro
+ */
+ArvoreBinaria criaArvoreBinariaComPool(FuncaoComparacao comparar, void* contexto,
+                                       int nos_por_bloco);
+
 /**
  * @brief Libera toda a memória da árvore.
  * 
@@ -54,6 +72,9 @@ void liberaArvoreBinaria(ArvoreBinaria arvore, FuncaoDesalocacao desalocar);
 /**
  * @brief Limpa todos os elementos da árvore sem liberar a estrutura.
  * 
+ * Numa árvore com pool os nós voltam para o pool, que guarda a memória
+ * para as próximas inserções.
+ * 
  * @param arvore Ponteiro para a árvore
  * @param desalocar Função para desalocar cada elemento (pode ser NULL)
  */
@@ -122,6 +143,43 @@ NoArvore getMenorNo(ArvoreBinaria arvore);
  */
 void* getMaiorElemento(ArvoreBinaria arvore);
 
+/**
+ * @brief Retorna o nó com o maior elemento da árvore.
+ * 
+ * @param arvore Ponteiro para a árvore
+ * @return NoArvore com maior elemento ou NULL se árvore vazia
+ */
+NoArvore getMaiorNo(ArvoreBinaria arvore);
+
+/**
+ * @brief Retorna o primeiro nó, na ordem da árvore, cujo elemento não é
+ *        menor que `chave`.
+ * 
+ * Junto com getPrimeiroNoMaior() e getProximoNo() permite percorrer uma
+ * faixa [inicio, fim] sem alocar memória:
+ * 
+ *     NoArvore fim_faixa = getPrimeiroNoMaior(arvore, fim);
+ *     for (NoArvore no = getPrimeiroNoMaiorOuIgual(arvore, inicio);
+ *          no != fim_faixa; no = getProximoNo(no)) { ... }
+ * 
+ * A chave é comparada com a função da árvore (como primeiro argumento).
+ * 
+ * @param arvore Ponteiro para a árvore
+ * @param chave Limite inferior da busca
+ * @return Nó encontrado ou NULL se todos os elementos são menores que `chave`
+ */
+NoArvore getPrimeiroNoMaiorOuIgual(ArvoreBinaria arvore, const void* chave);
+
+/**
+ * @brief Retorna o primeiro nó, na ordem da árvore, cujo elemento é
+ *        estritamente maior que `chave`.
+ * 
+ * @param arvore Ponteiro para a árvore
+ * @param chave Limite da busca
+ * @return Nó encontrado ou NULL se nenhum elemento é maior que `chave`
+ */
+NoArvore getPrimeiroNoMaior(ArvoreBinaria arvore, const void* chave);
+
 /**
  * @brief Retorna o dado armazenado em um nó.
  * 
@@ -130,6 +188,34 @@ void* getMaiorElemento(ArvoreBinaria arvore);
  */
 void* getDadoNo(NoArvore no);
 
+/**
+ * @brief Retorna o nó seguinte na ordem da árvore (sucessor).
+ * 
+ * @param no Ponteiro para o nó
+ * @return Nó seguinte ou NULL se `no` for o maior
+ */
+NoArvore getProximoNo(NoArvore no);
+
+/**
+ * @brief Retorna o nó anterior na ordem da árvore (predecessor).
+ * 
+ * @param no Ponteiro para o nó
+ * @return Nó anterior ou NULL se `no` for o menor
+ */
+NoArvore getAnteriorNo(NoArvore no);
+
+/**
+ * @brief Troca os dados de dois nós, sem mexer na estrutura da árvore.
+ * 
+ * Usado quando a ordem relativa de dois elementos vizinhos se inverte
+ * (por exemplo, dois segmentos que se cruzam numa varredura). O chamador
+ * garante que a árvore continua ordenada depois da troca.
+ * 
+ * @param a Primeiro nó
+ * @param b Segundo nó
+ */
+void trocaDadosNos(NoArvore a, NoArvore b);
+
 
 
 /**
@@ -148,6 +234,15 @@ bool arvoreVazia(ArvoreBinaria arvore);
  */
 int tamanhoArvore(ArvoreBinaria arvore);
 
+/**
+ * @brief Retorna a altura da árvore (número de nós no caminho mais longo
+ *        da raiz até uma folha).
+ * 
+ * @param arvore Ponteiro para a árvore
+ * @return Altura da árvore (0 se vazia)
+ */
+int alturaArvore(ArvoreBinaria arvore);
+
 
 
 
@@ -157,7 +252,8 @@ int tamanhoArvore(ArvoreBinaria arvore);
 /**
  * @brief Converte a árvore em um array ordenado.
  * 
- * O array retornado deve ser liberado pelo chamador.
+ * O array retornado deve ser liberado pelo chamador. Para só percorrer os
+ * elementos em ordem, prefira getMenorNo() e getProximoNo(), que não alocam.
  * 
  * @param arvore Ponteiro para a árvore
  * @param tamanho Ponteiro para armazenar o tamanho do array
@@ -0,0 +1,184 @@
+#include "bvh_segmentos.h"
+#include "sort.h"
+#include "sort_tipado.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+// Segmentos por folha
+#define BVH_FOLHA_MAX 4
+
+// Profundidade máxima da pilha da consulta (a árvore é balanceada pela mediana)
+#define BVH_PILHA_MAX 64
+
+typedef struct {
+    float min_x, min_y, max_x, max_y;
+    int direita;  // Filho direito (o esquerdo é o nó seguinte); -1 em folha
+    int ini, n;   // Folha: faixa em 'ordem'
+} NoBVH;
+
+typedef struct {
+    NoBVH* nos;
+    int n_nos;
+    int* ordem;  // Índices dos segmentos, agrupados por folha
+} stBVHSegmentos;
+
+typedef struct {
+    float cx, cy;
+    int indice;
+} CentroSegmento;
+
+#define CENTRO_MENOR_X(a, b) ((a)->cx < (b)->cx)
+#define CENTRO_MENOR_Y(a, b) ((a)->cy < (b)->cy)
+SORT_TIPADO(centros_x, CentroSegmento, CENTRO_MENOR_X)
+SORT_TIPADO(centros_y, CentroSegmento, CENTRO_MENOR_Y)
+
+// Constrói o nó da faixa [ini, fim) de 'centros' na próxima posição de b->nos
+static int constroiNo(stBVHSegmentos* b, const SegmentoPlano* segs,
+                      CentroSegmento* centros, int ini, int fim) {
+    int id = b->n_nos++;
+    NoBVH* no = &b->nos[id];
+
+    no->min_x = no->min_y = INFINITY;
+    no->max_x = no->max_y = -INFINITY;
+    float cmin_x = INFINITY, cmin_y = INFINITY, cmax_x = -INFINITY, cmax_y = -INFINITY;
+    for (int i = ini; i < fim; i++) {
+        const SegmentoPlano* s = &segs[centros[i].indice];
+        no->min_x = fmin(no->min_x, fmin(s->x1, s->x2));
+        no->min_y = fmin(no->min_y, fmin(s->y1, s->y2));
+        no->max_x = fmax(no->max_x, fmax(s->x1, s->x2));
+        no->max_y = fmax(no->max_y, fmax(s->y1, s->y2));
+        cmin_x = fmin(cmin_x, centros[i].cx);
+        cmin_y = fmin(cmin_y, centros[i].cy);
+        cmax_x = fmax(cmax_x, centros[i].cx);
+        cmax_y = fmax(cmax_y, centros[i].cy);
+    }
+
+    if (fim - ini <= BVH_FOLHA_MAX) {
+        no->direita = -1;
+        no->ini = ini;
+        no->n = fim - ini;
+        for (int i = ini; i < fim; i++) b->ordem[i] = centros[i].indice;
+        return id;
+    }
+
+    if (cmax_x - cmin_x >= cmax_y - cmin_y) {
+        centros_x_quick_sort(centros + ini, fim - ini, SORT_LIMIAR_PADRAO);
+    } else {
+        centros_y_quick_sort(centros + ini, fim - ini, SORT_LIMIAR_PADRAO);
+    }
+
+    int meio = ini + (fim - ini) / 2;
+    no->ini = ini;
+    no->n = 0;
+    constroiNo(b, segs, centros, ini, meio);
+    no->direita = constroiNo(b, segs, centros, meio, fim);
+    return id;
+}
+
+BVHSegmentos criaBVHSegmentos(const SegmentoPlano* segs, int n) {
+    if (segs == NULL || n <= 0) return NULL;
+
+    stBVHSegmentos* b = malloc(sizeof(stBVHSegmentos));
+    CentroSegmento* centros = malloc(n * sizeof(CentroSegmento));
+    if (!b || !centros) {
+        free(b);
+        free(centros);
+        return NULL;
+    }
+
+    // Uma árvore binária com folhas de até BVH_FOLHA_MAX tem menos de 2n nós
+    b->nos = malloc(2 * n * sizeof(NoBVH));
+    b->ordem = malloc(n * sizeof(int));
+    b->n_nos = 0;
+    if (!b->nos || !b->ordem) {
+        free(centros);
+        liberaBVHSegmentos(b);
+        return NULL;
+    }
+
+    for (int i = 0; i < n; i++) {
+        centros[i].cx = 0.5f * (segs[i].x1 + segs[i].x2);
+        centros[i].cy = 0.5f * (segs[i].y1 + segs[i].y2);
+        centros[i].indice = i;
+    }
+    constroiNo(b, segs, centros, 0, n);
+
+    free(centros);
+    return b;
+}
+
+void liberaBVHSegmentos(BVHSegmentos B) {
+    if (!B) return;
+
+    stBVHSegmentos* b = (stBVHSegmentos*)B;
+    free(b->nos);
+    free(b->ordem);
+    free(b);
+}
+
+// O segmento A + t*(B - A), t em [0, 1], corta o bounding box do nó?
+static bool segmentoCortaCaixa(const NoBVH* no, float ax, float ay, float dx, float dy) {
+    double t0 = 0.0, t1 = 1.0;
+    double o[2] = {ax, ay}, d[2] = {dx, dy};
+    double lo[2] = {no->min_x, no->min_y}, hi[2] = {no->max_x, no->max_y};
+
+    for (int e = 0; e < 2; e++) {
+        if (d[e] == 0.0) {
+            if (o[e] < lo[e] || o[e] > hi[e]) return false;
+            continue;
+        }
+        double ta = (lo[e] - o[e]) / d[e];
+        double tb = (hi[e] - o[e]) / d[e];
+        if (ta > tb) { double tmp = ta; ta = tb; tb = tmp; }
+        if (ta > t0) t0 = ta;
+        if (tb < t1) t1 = tb;
+        if (t0 > t1) return false;
+    }
+    return true;
+}
+
+static double orientacao(double ax, double ay, double bx, double by, double cx, double cy) {
+    return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+// Cruzamento próprio: cada segmento tem as extremidades do outro em lados opostos
+static bool cruzamProprio(const SegmentoPlano* s, float ax, float ay, float bx, float by) {
+    double d1 = orientacao(ax, ay, bx, by, s->x1, s->y1);
+    double d2 = orientacao(ax, ay, bx, by, s->x2, s->y2);
+    if (!((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0))) return false;
+
+    double d3 = orientacao(s->x1, s->y1, s->x2, s->y2, ax, ay);
+    double d4 = orientacao(s->x1, s->y1, s->x2, s->y2, bx, by);
+    return (d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0);
+}
+
+bool segmentoBloqueadoBVH(BVHSegmentos B, const SegmentoPlano* segs,
+                          float ax, float ay, float bx, float by) {
+    if (!B || !segs) return false;
+    stBVHSegmentos* b = (stBVHSegmentos*)B;
+
+    float dx = bx - ax, dy = by - ay;
+    int pilha[BVH_PILHA_MAX];
+    int topo = 0;
+    pilha[topo++] = 0;
+
+    while (topo > 0) {
+        const NoBVH* no = &b->nos[pilha[--topo]];
+        if (!segmentoCortaCaixa(no, ax, ay, dx, dy)) continue;
+
+        if (no->direita < 0) {
+            for (int i = no->ini; i < no->ini + no->n; i++) {
+                if (cruzamProprio(&segs[b->ordem[i]], ax, ay, bx, by)) return true;
+            }
+            continue;
+        }
+
+        // Filho esquerdo é o nó seguinte no array
+        int esq = (int)(no - b->nos) + 1;
+        pilha[topo++] = no->direita;
+        pilha[topo++] = esq;
+    }
+    return false;
+}
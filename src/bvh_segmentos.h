@@ -0,0 +1,57 @@
+#ifndef BVH_SEGMENTOS_H
+#define BVH_SEGMENTOS_H
+
+#include <stdbool.h>
+#include "intersecao_segmentos.h"
+
+/**
+ * @file bvh_segmentos.h
+ * @brief Hierarquia de caixas envolventes (BVH) sobre um conjunto de segmentos.
+ *
+ * Cada nó guarda o bounding box dos segmentos abaixo dele; as folhas guardam
+ * poucos segmentos. Uma consulta por segmento desce só pelos nós cujo
+ * bounding box ele corta, então testar uma linha de visão curta custa por
+ * volta de O(log n) em vez de O(n).
+ */
+
+/**
+ * @brief Tipo opaco para representar a hierarquia.
+ */
+typedef void* BVHSegmentos;
+
+/**
+ * @brief Cria a hierarquia, dividindo cada nó na mediana dos centros dos
+ *        segmentos ao longo do eixo em que eles mais se espalham.
+ *
+ * @param segs Segmentos (o array não é copiado nem guardado).
+ * @param n Número de segmentos.
+ * @return Hierarquia criada, ou NULL se n == 0 ou faltar memória.
+ */
+BVHSegmentos criaBVHSegmentos(const SegmentoPlano* segs, int n);
+
+/**
+ * @brief Libera a hierarquia.
+ *
+ * @param b Hierarquia a ser liberada.
+ */
+void liberaBVHSegmentos(BVHSegmentos b);
+
+/**
+ * @brief Verifica se algum segmento cruza o segmento AB.
+ *
+ * Só contam cruzamentos próprios (interior com interior): encostar uma
+ * extremidade ou correr colinear não bloqueia. Para no primeiro cruzamento
+ * encontrado.
+ *
+ * @param b Hierarquia (NULL: nenhum segmento).
+ * @param segs Os mesmos segmentos passados a criaBVHSegmentos().
+ * @param ax Coordenada X de A.
+ * @param ay Coordenada Y de A.
+ * @param bx Coordenada X de B.
+ * @param by Coordenada Y de B.
+ * @return true se algum segmento cruza AB.
+ */
+bool segmentoBloqueadoBVH(BVHSegmentos b, const SegmentoPlano* segs,
+                          float ax, float ay, float bx, float by);
+
+#endif
@@ -0,0 +1,134 @@
+#include "cache_visibilidade.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct {
+    float x, y;
+    unsigned int versao;
+    unsigned long ultimo_uso;  // Relógio lógico da última consulta
+    ContextoVisibilidade ctx;  // NULL = entrada livre
+} EntradaCache;
+
+typedef struct {
+    EntradaCache* entradas;
+    int capacidade;
+    unsigned long relogio;
+    char tipo_sort;
+    int threshold;
+    int n_raios;  // > 0: contextos aproximados por raios
+    int acertos;
+    int atualizacoes;
+    int falhas;
+} Cache_t;
+
+CacheVisibilidade criaCacheVisibilidade(int capacidade, char tipo_sort, int threshold, int n_raios) {
+    Cache_t* cache = malloc(sizeof(Cache_t));
+    if (cache == NULL) {
+        printf("Erro de alocação para CacheVisibilidade\n");
+        exit(1);
+    }
+
+    if (capacidade <= 0) capacidade = CACHE_VIS_CAPACIDADE_PADRAO;
+
+    cache->entradas = calloc(capacidade, sizeof(EntradaCache));
+    if (cache->entradas == NULL) {
+        printf("Erro de alocação para entradas do cache\n");
+        exit(1);
+    }
+    cache->capacidade = capacidade;
+    cache->relogio = 0;
+    cache->tipo_sort = tipo_sort;
+    cache->threshold = threshold;
+    cache->n_raios = n_raios;
+    cache->acertos = 0;
+    cache->atualizacoes = 0;
+    cache->falhas = 0;
+    return cache;
+}
+
+static void liberaEntrada(EntradaCache* e) {
+    if (e->ctx) {
+        liberaContextoVisibilidade(e->ctx);
+        e->ctx = NULL;
+    }
+}
+
+ContextoVisibilidade obtemContextoCache(CacheVisibilidade c, float x, float y,
+                                        unsigned int versao, Vetor formas) {
+    if (!c) return NULL;
+    Cache_t* cache = (Cache_t*)c;
+
+    cache->relogio++;
+
+    // Procura a posição e, no mesmo passo, acha a vítima LRU
+    EntradaCache* vitima = NULL;
+    for (int i = 0; i < cache->capacidade; i++) {
+        EntradaCache* e = &cache->entradas[i];
+
+        if (e->ctx && e->x == x && e->y == y) {
+            if (e->versao == versao) {
+                cache->acertos++;
+            } else if (atualizaContextoVisibilidade(e->ctx, formas)) {
+                // Só os anteparos mudaram: re-varre apenas os setores alterados
+                e->versao = versao;
+                cache->atualizacoes++;
+            } else {
+                liberaEntrada(e);
+                vitima = e;
+                break;
+            }
+            e->ultimo_uso = cache->relogio;
+            return e->ctx;
+        }
+
+        if (!e->ctx) {
+            if (!vitima || vitima->ctx) vitima = e;
+        } else if (!vitima || (vitima->ctx && e->ultimo_uso < vitima->ultimo_uso)) {
+            vitima = e;
+        }
+    }
+
+    cache->falhas++;
+
+    ContextoVisibilidade ctx;
+    if (cache->n_raios > 0) {
+        ctx = criaContextoVisibilidadeAprox(x, y, formas, cache->n_raios);
+    } else {
+        ctx = criaContextoVisibilidade(x, y, formas, cache->tipo_sort, cache->threshold);
+    }
+    if (!ctx) return NULL;
+
+    liberaEntrada(vitima);
+    vitima->x = x;
+    vitima->y = y;
+    vitima->versao = versao;
+    vitima->ultimo_uso = cache->relogio;
+    vitima->ctx = ctx;
+    return ctx;
+}
+
+int getAcertosCache(CacheVisibilidade c) {
+    if (!c) return 0;
+    return ((Cache_t*)c)->acertos;
+}
+
+int getAtualizacoesCache(CacheVisibilidade c) {
+    if (!c) return 0;
+    return ((Cache_t*)c)->atualizacoes;
+}
+
+int getFalhasCache(CacheVisibilidade c) {
+    if (!c) return 0;
+    return ((Cache_t*)c)->falhas;
+}
+
+void liberaCacheVisibilidade(CacheVisibilidade c) {
+    if (!c) return;
+    Cache_t* cache = (Cache_t*)c;
+
+    for (int i = 0; i < cache->capacidade; i++) {
+        liberaEntrada(&cache->entradas[i]);
+    }
+    free(cache->entradas);
+    free(cache);
+}
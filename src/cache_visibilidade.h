@@ -0,0 +1,91 @@
+#ifndef CACHE_VISIBILIDADE_H
+#define CACHE_VISIBILIDADE_H
+
+/**
+ * @file cache_visibilidade.h
+ * @brief Cache LRU de contextos de visibilidade.
+ *
+ * Bombas disparadas várias vezes do mesmo ponto, sem que o conjunto de formas
+ * da cidade mude entre elas, produzem a mesma região de visibilidade. O cache
+ * guarda os contextos já calculados indexados por (x, y, versão da cidade) e
+ * os devolve sem refazer a varredura angular.
+ *
+ * Uma entrada de versão anterior na mesma posição é atualizada com
+ * atualizaContextoVisibilidade(), que re-varre só os setores dos anteparos
+ * inseridos ou removidos. Se a atualização não for possível, o contexto é
+ * recriado.
+ */
+
+#include "vetor.h"
+#include "visibilidade.h"
+
+/**
+ * @brief Número de contextos mantidos quando nenhuma capacidade é informada.
+ */
+#define CACHE_VIS_CAPACIDADE_PADRAO 8
+
+/**
+ * @typedef CacheVisibilidade
+ * @brief Tipo opaco que representa o cache.
+ */
+typedef void* CacheVisibilidade;
+
+/**
+ * @brief Cria um cache vazio.
+ *
+ * @param capacidade Número máximo de contextos guardados, ou <= 0 para
+ *                   CACHE_VIS_CAPACIDADE_PADRAO.
+ * @param tipo_sort Tipo de ordenação repassado a criaContextoVisibilidade().
+ * @param threshold Limiar repassado a criaContextoVisibilidade().
+ * @param n_raios Se > 0, os contextos são aproximados com esse número de
+ *                raios (criaContextoVisibilidadeAprox()).
+ * @return Cache criado.
+ */
+CacheVisibilidade criaCacheVisibilidade(int capacidade, char tipo_sort, int threshold, int n_raios);
+
+/**
+ * @brief Obtém o contexto de visibilidade do ponto (x, y) para a versão dada.
+ *
+ * Se houver uma entrada com a mesma chave, ela é devolvida (acerto) e passa a
+ * ser a mais recente. Se houver uma entrada na mesma posição com outra versão,
+ * ela é atualizada a partir de `formas` (atualização). Caso contrário o
+ * contexto é criado a partir de `formas` (falha) e inserido, removendo o
+ * menos recentemente usado se o cache estiver cheio.
+ *
+ * @param cache Cache.
+ * @param x Coordenada X do observador.
+ * @param y Coordenada Y do observador.
+ * @param versao Versão atual do conjunto de formas (get_versao_cidade()).
+ * @param formas Vetor de formas usado em caso de falha.
+ * @return Contexto de visibilidade, ou NULL em caso de erro.
+ *
+ * @note O contexto pertence ao cache: não deve ser liberado pelo chamador.
+ *       Ele e seu polígono valem até a próxima chamada.
+ */
+ContextoVisibilidade obtemContextoCache(CacheVisibilidade cache, float x, float y,
+                                        unsigned int versao, Vetor formas);
+
+/**
+ * @brief Retorna o número de consultas atendidas pelo cache.
+ */
+int getAcertosCache(CacheVisibilidade cache);
+
+/**
+ * @brief Retorna o número de consultas atendidas atualizando um contexto de
+ *        versão anterior.
+ */
+int getAtualizacoesCache(CacheVisibilidade cache);
+
+/**
+ * @brief Retorna o número de consultas que precisaram calcular o contexto.
+ */
+int getFalhasCache(CacheVisibilidade cache);
+
+/**
+ * @brief Libera o cache e todos os contextos guardados.
+ *
+ * @param cache Cache a ser liberado.
+ */
+void liberaCacheVisibilidade(CacheVisibilidade cache);
+
+#endif
@@ -175,19 +175,48 @@ float calculoAreaCirculo(CIRCULO c){
 
 void desalocaCirculo(CIRCULO c){
 
+    desalocaCamposCirculo(c);
+    free(c);
+
+}
+
+void desalocaCamposCirculo(CIRCULO c){
+
     circulo *cTemp = ((circulo*)c);
     free(cTemp->corB);
     free(cTemp->corP);
-    free(cTemp);
 
 }
 
+size_t getTamanhoCirculo(void){
+
+    return sizeof(circulo);
+}
+
 CIRCULO clonaCirculo(CIRCULO c, int novo_id, float dx, float dy){
+    circulo *clone = (circulo*) malloc(sizeof(circulo));
+    if(clone == NULL){
+        printf("Erro na alocação de memória\n");
+        exit(1);
+    }
+    clonaCirculoEm(clone, c, novo_id, dx, dy);
+    return clone;
+}
+
+void clonaCirculoEm(void *destino, CIRCULO c, int novo_id, float dx, float dy){
     circulo *cTemp = ((circulo*)c);
-    return criaCirculo(novo_id, 
-                      cTemp->x + dx, 
-                      cTemp->y + dy, 
-                      cTemp->raio, 
-                      cTemp->corP, 
-                      cTemp->corB);
+    circulo *clone = ((circulo*)destino);
+
+    clone->id = novo_id;
+    clone->x = cTemp->x + dx;
+    clone->y = cTemp->y + dy;
+    clone->raio = cTemp->raio;
+    clone->corB = (char*) malloc(sizeof(char)*strlen(cTemp->corB) + 1);
+    clone->corP = (char*) malloc(sizeof(char)*strlen(cTemp->corP) + 1);
+    if(clone->corB == NULL || clone->corP == NULL){
+        printf("Erro de alocação de memória");
+        exit(1);
+    }
+    strcpy(clone->corB, cTemp->corB);
+    strcpy(clone->corP, cTemp->corP);
 }
\ No newline at end of file
@@ -176,6 +176,22 @@ float calculoAreaCirculo(CIRCULO c);
  */
 void desalocaCirculo(CIRCULO c);
 
+/**
+ * @brief Libera as cores do círculo, mas não a estrutura em si.
+ * 
+ * Usada quando a estrutura está embutida em outro bloco (ver criaForma()).
+ * 
+ * @param c Ponteiro para o círculo.
+ */
+void desalocaCamposCirculo(CIRCULO c);
+
+/**
+ * @brief Retorna o tamanho, em bytes, da estrutura de um círculo.
+ * 
+ * @return size_t Tamanho da estrutura.
+ */
+size_t getTamanhoCirculo(void);
+
 /**
  * @brief Cria um clone do círculo com novo ID e deslocamento.
  * 
@@ -187,6 +203,21 @@ void desalocaCirculo(CIRCULO c);
  */
 CIRCULO clonaCirculo(CIRCULO c, int novo_id, float dx, float dy);
 
+/**
+ * @brief Escreve um clone do círculo, com novo ID e deslocamento, na memória indicada.
+ * 
+ * Como clonaCirculo(), mas sem alocar a estrutura: destino deve ter
+ * getTamanhoCirculo() bytes, alinhados para qualquer tipo. As cores do
+ * clone são cópias próprias.
+ * 
+ * @param destino Memória que recebe o clone.
+ * @param c Ponteiro para o círculo original.
+ * @param novo_id Novo ID para o clone.
+ * @param dx Deslocamento em X.
+ * @param dy Deslocamento em Y.
+ */
+void clonaCirculoEm(void *destino, CIRCULO c, int novo_id, float dx, float dy);
+
 
 
 #endif
\ No newline at end of file
@@ -0,0 +1,262 @@
+#include "colunas_formas.h"
+#include "forma.h"
+#include "circulo.h"
+#include "retangulo.h"
+#include "linha.h"
+#include "texto.h"
+#include "anteparo.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct {
+    int n;
+    int* pos;  // Posição de cada círculo no vetor de origem
+    float* x;
+    float* y;
+    float* r;
+} ColunaCirculos;
+
+typedef struct {
+    int n;
+    int* pos;
+    float* x;
+    float* y;
+    float* w;
+    float* h;
+} ColunaRetangulos;
+
+// Linhas e anteparos
+typedef struct {
+    int n;
+    int* pos;
+    float* x1;
+    float* y1;
+    float* x2;
+    float* y2;
+} ColunaSegmentos;
+
+// Textos ocupam a caixa fixa de 10 x 10 a partir da âncora, como em getBBForma
+typedef struct {
+    int n;
+    int* pos;
+    float* x;
+    float* y;
+} ColunaTextos;
+
+typedef struct {
+    ColunaCirculos circulos;
+    ColunaRetangulos retangulos;
+    ColunaSegmentos linhas;
+    ColunaSegmentos anteparos;
+    ColunaTextos textos;
+    int n;
+} stColunasFormas;
+
+static void* alocaColuna(int n, size_t tamanho) {
+    // Coluna vazia ainda recebe um bloco, para free e laços não tratarem NULL
+    void* p = malloc((n > 0 ? n : 1) * tamanho);
+    if (p == NULL) {
+        printf("Erro de alocação para colunas de formas\n");
+        exit(1);
+    }
+    return p;
+}
+
+static void alocaSegmentos(ColunaSegmentos* s, int n) {
+    s->n = 0;
+    s->pos = alocaColuna(n, sizeof(int));
+    s->x1 = alocaColuna(n, sizeof(float));
+    s->y1 = alocaColuna(n, sizeof(float));
+    s->x2 = alocaColuna(n, sizeof(float));
+    s->y2 = alocaColuna(n, sizeof(float));
+}
+
+static void liberaSegmentos(ColunaSegmentos* s) {
+    free(s->pos);
+    free(s->x1);
+    free(s->y1);
+    free(s->x2);
+    free(s->y2);
+}
+
+ColunasFormas criaColunasFormas(Vetor formas) {
+    stColunasFormas* c = malloc(sizeof(stColunasFormas));
+    if (c == NULL) {
+        printf("Erro de alocação para colunas de formas\n");
+        exit(1);
+    }
+
+    int n_formas = getTamanhoVetor(formas);
+    int n_circ = 0, n_ret = 0, n_lin = 0, n_ant = 0, n_txt = 0;
+    for (int i = 0; i < n_formas; i++) {
+        switch (getTipoForma(getElementoVetor(formas, i))) {
+            case CIRCLE: n_circ++; break;
+            case RECTANGLE: n_ret++; break;
+            case LINE: n_lin++; break;
+            case ANTEPARO: n_ant++; break;
+            case TEXT: n_txt++; break;
+            default: break;
+        }
+    }
+
+    c->circulos.n = 0;
+    c->circulos.pos = alocaColuna(n_circ, sizeof(int));
+    c->circulos.x = alocaColuna(n_circ, sizeof(float));
+    c->circulos.y = alocaColuna(n_circ, sizeof(float));
+    c->circulos.r = alocaColuna(n_circ, sizeof(float));
+
+    c->retangulos.n = 0;
+    c->retangulos.pos = alocaColuna(n_ret, sizeof(int));
+    c->retangulos.x = alocaColuna(n_ret, sizeof(float));
+    c->retangulos.y = alocaColuna(n_ret, sizeof(float));
+    c->retangulos.w = alocaColuna(n_ret, sizeof(float));
+    c->retangulos.h = alocaColuna(n_ret, sizeof(float));
+
+    alocaSegmentos(&c->linhas, n_lin);
+    alocaSegmentos(&c->anteparos, n_ant);
+
+    c->textos.n = 0;
+    c->textos.pos = alocaColuna(n_txt, sizeof(int));
+    c->textos.x = alocaColuna(n_txt, sizeof(float));
+    c->textos.y = alocaColuna(n_txt, sizeof(float));
+
+    for (int i = 0; i < n_formas; i++) {
+        Forma f = getElementoVetor(formas, i);
+        void* data = getDataForma(f);
+
+        switch (getTipoForma(f)) {
+            case CIRCLE: {
+                ColunaCirculos* col = &c->circulos;
+                int k = col->n++;
+                col->pos[k] = i;
+                col->x[k] = getXCirculo(data);
+                col->y[k] = getYCirculo(data);
+                col->r[k] = getRaioCirculo(data);
+                break;
+            }
+            case RECTANGLE: {
+                ColunaRetangulos* col = &c->retangulos;
+                int k = col->n++;
+                col->pos[k] = i;
+                col->x[k] = getXRetangulo(data);
+                col->y[k] = getYRetangulo(data);
+                col->w[k] = getLarguraRetangulo(data);
+                col->h[k] = getAlturaRetangulo(data);
+                break;
+            }
+            case LINE: {
+                ColunaSegmentos* col = &c->linhas;
+                int k = col->n++;
+                col->pos[k] = i;
+                col->x1[k] = getX1Linha(data);
+                col->y1[k] = getY1Linha(data);
+                col->x2[k] = getX2Linha(data);
+                col->y2[k] = getY2Linha(data);
+                break;
+            }
+            case ANTEPARO: {
+                ColunaSegmentos* col = &c->anteparos;
+                int k = col->n++;
+                col->pos[k] = i;
+                col->x1[k] = getX1Anteparo(data);
+                col->y1[k] = getY1Anteparo(data);
+                col->x2[k] = getX2Anteparo(data);
+                col->y2[k] = getY2Anteparo(data);
+                break;
+            }
+            case TEXT: {
+                ColunaTextos* col = &c->textos;
+                int k = col->n++;
+                col->pos[k] = i;
+                col->x[k] = getXTexto(data);
+                col->y[k] = getYTexto(data);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    c->n = n_circ + n_ret + n_lin + n_ant + n_txt;
+    return c;
+}
+
+void liberaColunasFormas(ColunasFormas C) {
+    if (!C) return;
+    stColunasFormas* c = (stColunasFormas*)C;
+
+    free(c->circulos.pos);
+    free(c->circulos.x);
+    free(c->circulos.y);
+    free(c->circulos.r);
+
+    free(c->retangulos.pos);
+    free(c->retangulos.x);
+    free(c->retangulos.y);
+    free(c->retangulos.w);
+    free(c->retangulos.h);
+
+    liberaSegmentos(&c->linhas);
+    liberaSegmentos(&c->anteparos);
+
+    free(c->textos.pos);
+    free(c->textos.x);
+    free(c->textos.y);
+
+    free(c);
+}
+
+int getNumFormasColunas(ColunasFormas C) {
+    if (!C) return 0;
+    return ((stColunasFormas*)C)->n;
+}
+
+// A caixa [cx0, cx1] x [cy0, cy1] toca a de consulta? Mesmo teste de haInterseccaoBB
+#define TOCA(cx0, cy0, cx1, cy1, min_x, min_y, max_x, max_y) \
+    (!((max_x) < (cx0) || (min_x) > (cx1) || (max_y) < (cy0) || (min_y) > (cy1)))
+
+static int candidatasSegmentos(const ColunaSegmentos* col, float min_x, float min_y,
+                               float max_x, float max_y, int* saida) {
+    int m = 0;
+    for (int k = 0; k < col->n; k++) {
+        float x0 = col->x1[k] < col->x2[k] ? col->x1[k] : col->x2[k];
+        float x1 = col->x1[k] < col->x2[k] ? col->x2[k] : col->x1[k];
+        float y0 = col->y1[k] < col->y2[k] ? col->y1[k] : col->y2[k];
+        float y1 = col->y1[k] < col->y2[k] ? col->y2[k] : col->y1[k];
+        if (TOCA(x0, y0, x1, y1, min_x, min_y, max_x, max_y)) saida[m++] = col->pos[k];
+    }
+    return m;
+}
+
+int candidatasColunasFormas(ColunasFormas C, float min_x, float min_y,
+                            float max_x, float max_y, int* saida) {
+    if (!C || !saida) return 0;
+    stColunasFormas* c = (stColunasFormas*)C;
+
+    int m = 0;
+
+    const ColunaCirculos* cc = &c->circulos;
+    for (int k = 0; k < cc->n; k++) {
+        float x = cc->x[k], y = cc->y[k], r = cc->r[k];
+        if (TOCA(x - r, y - r, x + r, y + r, min_x, min_y, max_x, max_y)) saida[m++] = cc->pos[k];
+    }
+
+    const ColunaRetangulos* cr = &c->retangulos;
+    for (int k = 0; k < cr->n; k++) {
+        float x = cr->x[k], y = cr->y[k];
+        if (TOCA(x, y, x + cr->w[k], y + cr->h[k], min_x, min_y, max_x, max_y)) saida[m++] = cr->pos[k];
+    }
+
+    m += candidatasSegmentos(&c->linhas, min_x, min_y, max_x, max_y, saida + m);
+
+    m += candidatasSegmentos(&c->anteparos, min_x, min_y, max_x, max_y, saida + m);
+
+    const ColunaTextos* ct = &c->textos;
+    for (int k = 0; k < ct->n; k++) {
+        float x = ct->x[k], y = ct->y[k];
+        if (TOCA(x, y, x + 10, y + 10, min_x, min_y, max_x, max_y)) saida[m++] = ct->pos[k];
+    }
+
+    return m;
+}
@@ -0,0 +1,72 @@
+#ifndef COLUNAS_FORMAS_H
+#define COLUNAS_FORMAS_H
+
+#include "vetor.h"
+
+/**
+ * @file colunas_formas.h
+ * @brief Geometria das formas da cidade guardada em colunas, uma por tipo.
+ *
+ * As formas ficam espalhadas pelo heap, cada uma atrás de um Forma com tipo
+ * e ponteiro para os dados, e lê-las exige um switch no tipo e uma chamada
+ * de getter por coordenada. Aqui a geometria é copiada para arrays por tipo
+ * (círculos em x[]/y[]/r[], retângulos em x[]/y[]/w[]/h[], linhas e
+ * anteparos em x1[]/y1[]/x2[]/y2[], textos em x[]/y[]), e cada entrada
+ * guarda a posição da forma no vetor de origem. Uma consulta por retângulo
+ * percorre cada coluna num laço apertado, sem desvios por tipo.
+ *
+ * As colunas são uma cópia: valem enquanto o vetor de origem não muda de
+ * geometria nem de ordem. Cores e demais atributos continuam só nas formas.
+ */
+
+/**
+ * @brief Tipo opaco para representar as colunas.
+ */
+typedef void* ColunasFormas;
+
+/**
+ * @brief Copia a geometria das formas para as colunas.
+ *
+ * Formas sem geometria (estilos de texto) ficam de fora.
+ *
+ * @param formas Vetor de Forma (não é guardado).
+ * @return Colunas criadas.
+ */
+ColunasFormas criaColunasFormas(Vetor formas);
+
+/**
+ * @brief Libera as colunas.
+ *
+ * @param c Colunas a serem liberadas.
+ */
+void liberaColunasFormas(ColunasFormas c);
+
+/**
+ * @brief Retorna o número de formas guardadas nas colunas.
+ *
+ * @param c Colunas.
+ * @return Número de formas (0 se c for NULL).
+ */
+int getNumFormasColunas(ColunasFormas c);
+
+/**
+ * @brief Encontra as formas cujo retângulo envolvente toca [min_x, max_x] x [min_y, max_y].
+ *
+ * O retângulo envolvente de cada tipo é o mesmo de getBBForma(), e tocar
+ * conta como intersecção, como em haInterseccaoBB().
+ *
+ * @param c Colunas.
+ * @param min_x Menor X do retângulo de consulta.
+ * @param min_y Menor Y do retângulo de consulta.
+ * @param max_x Maior X do retângulo de consulta.
+ * @param max_y Maior Y do retângulo de consulta.
+ * @param saida Recebe as posições das formas no vetor de origem, agrupadas
+ *              por tipo e crescentes dentro de cada tipo (quem precisa de
+ *              outra ordem reordena só as formas que aproveita); deve ter
+ *              espaço para getNumFormasColunas(c) posições.
+ * @return Número de posições escritas.
+ */
+int candidatasColunasFormas(ColunasFormas c, float min_x, float min_y,
+                            float max_x, float max_y, int* saida);
+
+#endif
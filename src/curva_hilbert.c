@@ -0,0 +1,25 @@
+#include "curva_hilbert.h"
+
+uint64_t indiceHilbert(uint32_t x, uint32_t y, int ordem) {
+    uint64_t d = 0;
+
+    // Do quadrante maior para o menor: cada nível soma a posição do quadrante
+    // e leva o ponto para a orientação do sub-quadrado seguinte
+    for (int nivel = ordem - 1; nivel >= 0; nivel--) {
+        uint32_t s = (uint32_t)1 << nivel;
+        uint32_t rx = (x & s) ? 1 : 0;
+        uint32_t ry = (y & s) ? 1 : 0;
+        d += ((uint64_t)s * s) * ((3 * rx) ^ ry);
+
+        if (ry == 0) {
+            if (rx == 1) {
+                x = s - 1 - (x & (s - 1));
+                y = s - 1 - (y & (s - 1));
+            }
+            uint32_t t = x;
+            x = y;
+            y = t;
+        }
+    }
+    return d;
+}
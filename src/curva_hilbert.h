@@ -0,0 +1,33 @@
+#ifndef CURVA_HILBERT_H
+#define CURVA_HILBERT_H
+
+#include <stdint.h>
+
+/**
+ * @file curva_hilbert.h
+ * @brief Posição de uma célula de grade ao longo da curva de Hilbert.
+ *
+ * A curva de Hilbert percorre uma grade de 2^ordem x 2^ordem células
+ * passando de cada célula para uma vizinha. Ordenar pontos pela posição
+ * na curva deixa próximos, na sequência, os pontos próximos no plano.
+ */
+
+/**
+ * @brief Maior ordem aceita por indiceHilbert().
+ */
+#define HILBERT_ORDEM_MAX 32
+
+/**
+ * @brief Retorna a posição da célula (x, y) na curva de Hilbert.
+ *
+ * Células consecutivas na curva são vizinhas na grade (diferem de 1 em
+ * x ou em y).
+ *
+ * @param x Coluna da célula, em [0, 2^ordem).
+ * @param y Linha da célula, em [0, 2^ordem).
+ * @param ordem Número de bits por coordenada, de 1 a HILBERT_ORDEM_MAX.
+ * @return Posição em [0, 4^ordem).
+ */
+uint64_t indiceHilbert(uint32_t x, uint32_t y, int ordem);
+
+#endif
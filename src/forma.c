@@ -7,6 +7,7 @@
 #include "anteparo.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 
 #ifndef M_PI
@@ -14,24 +15,62 @@
 #endif
 
 
+// Garante que os dados embutidos fiquem alinhados para qualquer campo
+typedef union {
+    double d;
+    void* p;
+    long long l;
+} AlinhamentoForma;
+
+// Bloco com várias formas clonadas de uma vez; liberado quando a última sai
+typedef struct {
+    int vivas;
+    AlinhamentoForma mem[];
+} BlocoFormas;
+
+// Tipo e dados num único bloco: os dados da forma específica ficam logo
+// depois do tipo, sem um ponteiro para seguir
 typedef struct {
     tipo_forma tipo;  
-    void* data;       
+    unsigned int seq;  // Ocupa o espaço que o alinhamento dos dados deixaria vazio
+    BlocoFormas* bloco;  // Bloco de clones que contém a forma (NULL se tem o próprio)
+    AlinhamentoForma dados[];
 } Forma_t;
 
+// Bytes de uma forma do tipo, arredondados para manter a seguinte alinhada
+static size_t tamanhoFormaAlinhado(tipo_forma tipo);
+
+static size_t tamanhoDadosForma(tipo_forma tipo) {
+    switch (tipo) {
+        case CIRCLE: return getTamanhoCirculo();
+        case RECTANGLE: return getTamanhoRetangulo();
+        case LINE: return getTamanhoLinha();
+        case TEXT: return getTamanhoTexto();
+        case TEXT_STYLE: return getTamanhoTextStyle();
+        case ANTEPARO: return getTamanhoAnteparo();
+        default: return 0;
+    }
+}
+
 Forma criaForma(tipo_forma tipo, void* data) {
     if (data == NULL) {
         return NULL;
     }
 
-    Forma_t* forma = (Forma_t*)malloc(sizeof(Forma_t));
+    size_t tamanho = tamanhoDadosForma(tipo);
+    Forma_t* forma = (Forma_t*)malloc(sizeof(Forma_t) + tamanho);
     if (forma == NULL) {
         printf("Erro de alocação em criaForma\n");
         return NULL;
     }
 
     forma->tipo = tipo;
-    forma->data = data;
+    forma->seq = 0;
+    forma->bloco = NULL;
+    // Os campos (e as strings para as quais apontam) passam para o bloco da
+    // forma; só a estrutura original é liberada
+    memcpy(forma->dados, data, tamanho);
+    free(data);
 
     return (Forma)forma;
 }
@@ -51,7 +90,7 @@ void* getDataForma(Forma f) {
     }
 
     Forma_t* forma = (Forma_t*)f;
-    return forma->data;
+    return forma->dados;
 }
 
 void escreveFormaSVG(Forma f, FILE* arquivo) {
@@ -63,7 +102,7 @@ void escreveFormaSVG(Forma f, FILE* arquivo) {
 
     switch (forma->tipo) {
         case CIRCLE: {
-            CIRCULO c = (CIRCULO)forma->data;
+            CIRCULO c = (CIRCULO)forma->dados;
             fprintf(arquivo,
                     "<circle cx='%.2f' cy='%.2f' r='%.2f' fill='%s' stroke='%s'/>\n",
                     getXCirculo(c), getYCirculo(c),
@@ -73,7 +112,7 @@ void escreveFormaSVG(Forma f, FILE* arquivo) {
         }
 
         case RECTANGLE: {
-            RETANGULO r = (RETANGULO)forma->data;
+            RETANGULO r = (RETANGULO)forma->dados;
             fprintf(arquivo,
                     "<rect x='%.2f' y='%.2f' width='%.2f' height='%.2f' fill='%s' "
                     "stroke='%s'/>\n",
@@ -85,7 +124,7 @@ void escreveFormaSVG(Forma f, FILE* arquivo) {
         }
 
         case LINE: {
-            LINHA l = (LINHA)forma->data;
+            LINHA l = (LINHA)forma->dados;
             fprintf(arquivo,
                     "<line x1='%.2f' y1='%.2f' x2='%.2f' y2='%.2f' stroke='%s'/>\n",
                     getX1Linha(l), getY1Linha(l), getX2Linha(l),
@@ -94,7 +133,7 @@ void escreveFormaSVG(Forma f, FILE* arquivo) {
         }
 
         case TEXT: {
-            TEXTO t = (TEXTO)forma->data;
+            TEXTO t = (TEXTO)forma->dados;
             char ancora = getAncoraTexto(t);
             char* texto_ancora = "start";
 
@@ -119,7 +158,7 @@ void escreveFormaSVG(Forma f, FILE* arquivo) {
             break;
 
         case ANTEPARO: {
-            Anteparo a = (Anteparo)forma->data;
+            Anteparo a = (Anteparo)forma->dados;
             fprintf(arquivo,
                     "<line x1='%.2f' y1='%.2f' x2='%.2f' y2='%.2f' stroke='%s'/>\n",
                     getX1Anteparo(a), getY1Anteparo(a), getX2Anteparo(a),
@@ -139,38 +178,43 @@ void desalocaForma(Forma f) {
 
     Forma_t* forma = (Forma_t*)f;
 
-    // Desaloca os dados específicos da forma
+    // Desaloca o que os dados específicos da forma alocaram; os dados em si
+    // estão no bloco da forma
     switch (forma->tipo) {
         case CIRCLE:
-            desalocaCirculo(forma->data);
+            desalocaCamposCirculo(forma->dados);
             break;
 
         case RECTANGLE:
-            desalocarRetangulo(forma->data);
+            desalocarCamposRetangulo(forma->dados);
             break;
 
         case LINE:
-            desalocaLinha(forma->data);
+            desalocaCamposLinha(forma->dados);
             break;
 
         case TEXT:
-            desalocaTexto(forma->data);
+            desalocaCamposTexto(forma->dados);
             break;
 
         case TEXT_STYLE:
-            desalocaTextStyle(forma->data);
+            desalocaCamposTextStyle(forma->dados);
             break;
 
         case ANTEPARO:
-            desalocaAnteparo(forma->data);
+            desalocaCamposAnteparo(forma->dados);
             break;
 
         default:
             break;
     }
 
-    // Desaloca a estrutura da forma
-    free(forma);
+    // Desaloca a forma, junto com os dados; num bloco de clones, só a última libera
+    if (forma->bloco == NULL) {
+        free(forma);
+    } else if (--forma->bloco->vivas == 0) {
+        free(forma->bloco);
+    }
 }
 
 BoundingBox getBBForma(Forma f) {
@@ -370,36 +414,97 @@ bool formaEstaDentro(Poligono p, Forma f) {
     return false;
 }
 
-Forma clonaForma(Forma f, int novo_id, float dx, float dy) {
-    if (!f) return NULL;
-    
-    tipo_forma tipo = getTipoForma(f);
-    void* data = getDataForma(f);
-    void* clone_data = NULL;
-    
+// Escreve em destino o clone dos dados; false se o tipo não é clonável
+static bool clonaDadosEm(tipo_forma tipo, void* destino, void* data, int novo_id, float dx, float dy) {
     switch(tipo) {
         case CIRCLE:
-            clone_data = clonaCirculo(data, novo_id, dx, dy);
-            break;
+            clonaCirculoEm(destino, data, novo_id, dx, dy);
+            return true;
         case RECTANGLE:
-            clone_data = clonaRetangulo(data, novo_id, dx, dy);
-            break;
+            clonaRetanguloEm(destino, data, novo_id, dx, dy);
+            return true;
         case LINE:
-            clone_data = clonaLinha(data, novo_id, dx, dy);
-            break;
+            clonaLinhaEm(destino, data, novo_id, dx, dy);
+            return true;
         case TEXT:
-            clone_data = clonaTexto(data, novo_id, dx, dy);
-            break;
+            clonaTextoEm(destino, data, novo_id, dx, dy);
+            return true;
         case ANTEPARO:
-            clone_data = clonaAnteparo(data, novo_id, dx, dy);
-            break;
+            clonaAnteparoEm(destino, data, novo_id, dx, dy);
+            return true;
         default:
-            return NULL;
+            return false;
     }
+}
+
+Forma clonaForma(Forma f, int novo_id, float dx, float dy) {
+    if (!f) return NULL;
     
-    if (clone_data == NULL) return NULL;
+    tipo_forma tipo = getTipoForma(f);
+    if (tipo == TEXT_STYLE) return NULL;
     
-    return criaForma(tipo, clone_data);
+    // O clone é escrito direto no bloco da forma nova
+    Forma_t* clone = (Forma_t*)malloc(sizeof(Forma_t) + tamanhoDadosForma(tipo));
+    if (clone == NULL) {
+        printf("Erro de alocação em clonaForma\n");
+        return NULL;
+    }
+    clone->tipo = tipo;
+    clone->seq = 0;
+    clone->bloco = NULL;
+    if (!clonaDadosEm(tipo, clone->dados, getDataForma(f), novo_id, dx, dy)) {
+        free(clone);
+        return NULL;
+    }
+    return (Forma)clone;
+}
+
+static size_t tamanhoFormaAlinhado(tipo_forma tipo) {
+    size_t t = sizeof(Forma_t) + tamanhoDadosForma(tipo);
+    size_t a = sizeof(AlinhamentoForma);
+    return (t + a - 1) / a * a;
+}
+
+int clonaFormasEmLote(Vetor originais, int primeiro_id, float dx, float dy, Vetor saida) {
+    int n = getTamanhoVetor(originais);
+
+    // Primeira passada: tamanho do bloco de todos os clones
+    size_t total = 0;
+    int clonaveis = 0;
+    for (int i = 0; i < n; i++) {
+        tipo_forma tipo = getTipoForma(getElementoVetor(originais, i));
+        if (tipo == TEXT_STYLE) continue;
+        total += tamanhoFormaAlinhado(tipo);
+        clonaveis++;
+    }
+    if (clonaveis == 0) return 0;
+
+    BlocoFormas* bloco = malloc(sizeof(BlocoFormas) + total);
+    if (bloco == NULL) {
+        printf("Erro de alocação para o bloco de clones\n");
+        exit(1);
+    }
+    bloco->vivas = 0;
+    reservaVetor(saida, getTamanhoVetor(saida) + clonaveis);
+
+    // Segunda passada: cada clone logo depois do anterior
+    char* livre = (char*)bloco->mem;
+    for (int i = 0; i < n; i++) {
+        Forma f = getElementoVetor(originais, i);
+        tipo_forma tipo = getTipoForma(f);
+        if (tipo == TEXT_STYLE) continue;
+
+        Forma_t* clone = (Forma_t*)livre;
+        clone->tipo = tipo;
+        clone->seq = 0;
+        clone->bloco = bloco;
+        clonaDadosEm(tipo, clone->dados, getDataForma(f), primeiro_id + i, dx, dy);
+        livre += tamanhoFormaAlinhado(tipo);
+
+        bloco->vivas++;
+        insereFinalVetor(saida, clone);
+    }
+    return clonaveis;
 }
 
 void setCorPForma(Forma f, const char* cor) {
@@ -450,3 +555,27 @@ void setCorBForma(Forma f, const char* cor) {
     }
 }
 
+int getIDForma(Forma f) {
+    if (!f) return -1;
+    
+    void* data = getDataForma(f);
+    
+    switch(getTipoForma(f)) {
+        case CIRCLE: return getIDCirculo(data);
+        case RECTANGLE: return getIDRetangulo(data);
+        case LINE: return getIDLinha(data);
+        case TEXT: return getIDTexto(data);
+        case ANTEPARO: return getIDAnteparo(data);
+        default: return -1;
+    }
+}
+
+void setSeqForma(Forma f, unsigned int seq) {
+    if (!f) return;
+    ((Forma_t*)f)->seq = seq;
+}
+
+unsigned int getSeqForma(Forma f) {
+    if (!f) return 0;
+    return ((Forma_t*)f)->seq;
+}
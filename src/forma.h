@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include "poligono.h"
+#include "vetor.h"
 /**
  * @file forma.h
  * @brief Módulo genérico para gerenciamento de formas geométricas.
@@ -49,8 +50,10 @@ typedef void* Forma;
  * 
  * @note O ponteiro 'data' deve ser um ponteiro válido para uma forma já criada
  *       usando as funções específicas (criaCirculo, criaRetangulo, etc.).
- * @note A propriedade dos dados é transferida para a Forma. Quando a Forma
- *       for desalocada, os dados também serão liberados.
+ * @note Os dados são copiados para dentro do bloco da Forma, que ocupa uma só
+ *       alocação, e a estrutura original é liberada: depois da chamada,
+ *       'data' não deve mais ser usado. Use getDataForma() para chegar aos
+ *       dados. Quando a Forma for desalocada, os dados também serão liberados.
  */
 Forma criaForma(tipo_forma tipo, void* data);
 
@@ -138,6 +141,24 @@ bool formaEstaDentro(Poligono p, Forma f);
  */
 Forma clonaForma(Forma f, int novo_id, float dx, float dy);
 
+/**
+ * @brief Clona várias formas de uma vez, com IDs consecutivos e o mesmo deslocamento.
+ * 
+ * Os clones são escritos, numa só passada, num único bloco dimensionado
+ * para todos eles; cada um continua sendo uma Forma comum, liberada com
+ * desalocaForma(). O bloco só é devolvido quando o último clone dele é
+ * desalocado. Estilos de texto não são clonados.
+ * 
+ * @param originais Vetor de formas a clonar.
+ * @param primeiro_id ID do clone da primeira forma; o da forma i é primeiro_id + i
+ *                    (o ID de um estilo de texto fica sem uso).
+ * @param dx Deslocamento em x.
+ * @param dy Deslocamento em y.
+ * @param saida Vetor que recebe os clones, na ordem de originais.
+ * @return Número de clones inseridos em saida.
+ */
+int clonaFormasEmLote(Vetor originais, int primeiro_id, float dx, float dy, Vetor saida);
+
 /**
  * @brief Define a cor de preenchimento de uma forma.
  * 
@@ -154,4 +175,32 @@ void setCorPForma(Forma f, const char* cor);
  */
 void setCorBForma(Forma f, const char* cor);
 
+/**
+ * @brief Retorna o ID de uma forma.
+ * 
+ * @param f Ponteiro para a forma.
+ * @return O ID da forma, ou -1 se o tipo não tiver ID (estilo de texto).
+ */
+int getIDForma(Forma f);
+
+/**
+ * @brief Define o número de sequência de uma forma.
+ *
+ * A cidade numera as formas na ordem em que entram, para recuperar essa
+ * ordem a partir de coleções guardadas em outra ordem (como as colunas na
+ * ordem espacial). Formas recém criadas (inclusive clones) têm sequência 0.
+ *
+ * @param f Ponteiro para a forma.
+ * @param seq Número de sequência.
+ */
+void setSeqForma(Forma f, unsigned int seq);
+
+/**
+ * @brief Retorna o número de sequência de uma forma.
+ *
+ * @param f Ponteiro para a forma.
+ * @return O número definido por setSeqForma(), ou 0.
+ */
+unsigned int getSeqForma(Forma f);
+
 #endif
@@ -0,0 +1,295 @@
+#include "grade_segmentos.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+typedef struct {
+    float min_x, min_y, max_x, max_y;
+    float cel_w, cel_h;
+    int nx, ny;
+    int n_segs;
+    int* inicio;    // nx*ny + 1 posições em 'segs'
+    int* segs;      // Índices dos segmentos de cada célula (formato CSR)
+    int* marca;     // Por segmento: último carimbo em que foi devolvido
+    int carimbo;
+} stGradeSegmentos;
+
+static int colunaGrade(stGradeSegmentos* g, float x) {
+    int c = (int)((x - g->min_x) / g->cel_w);
+    if (c < 0) return 0;
+    if (c >= g->nx) return g->nx - 1;
+    return c;
+}
+
+static int linhaGrade(stGradeSegmentos* g, float y) {
+    int r = (int)((y - g->min_y) / g->cel_h);
+    if (r < 0) return 0;
+    if (r >= g->ny) return g->ny - 1;
+    return r;
+}
+
+// Percorre as células tocadas pelo segmento, linha a linha, recortando-o na faixa
+// de cada linha. Com 'destino' nulo só conta; senão preenche o CSR.
+static void distribuiSegmento(stGradeSegmentos* g, const SegmentoPlano* s, int k,
+                              int* contagem, int* destino) {
+    float ylo = fmin(s->y1, s->y2), yhi = fmax(s->y1, s->y2);
+    int r0 = linhaGrade(g, ylo), r1 = linhaGrade(g, yhi);
+
+    for (int r = r0; r <= r1; r++) {
+        float xmin, xmax;
+        if (s->y1 == s->y2) {
+            xmin = fmin(s->x1, s->x2);
+            xmax = fmax(s->x1, s->x2);
+        } else {
+            float y0 = fmax(ylo, g->min_y + r * g->cel_h);
+            float y1 = fmin(yhi, g->min_y + (r + 1) * g->cel_h);
+            float xa = s->x1 + (y0 - s->y1) * (s->x2 - s->x1) / (s->y2 - s->y1);
+            float xb = s->x1 + (y1 - s->y1) * (s->x2 - s->x1) / (s->y2 - s->y1);
+            xmin = fmin(xa, xb);
+            xmax = fmax(xa, xb);
+        }
+
+        int c0 = colunaGrade(g, xmin), c1 = colunaGrade(g, xmax);
+        for (int c = c0; c <= c1; c++) {
+            int cel = r * g->nx + c;
+            if (destino) destino[contagem[cel]++] = k;
+            else contagem[cel]++;
+        }
+    }
+}
+
+GradeSegmentos criaGradeSegmentos(const SegmentoPlano* segs, int n) {
+    if (segs == NULL || n <= 0) return NULL;
+
+    stGradeSegmentos* g = calloc(1, sizeof(stGradeSegmentos));
+    if (!g) return NULL;
+
+    g->n_segs = n;
+    g->min_x = fmin(segs[0].x1, segs[0].x2);
+    g->max_x = fmax(segs[0].x1, segs[0].x2);
+    g->min_y = fmin(segs[0].y1, segs[0].y2);
+    g->max_y = fmax(segs[0].y1, segs[0].y2);
+    for (int i = 1; i < n; i++) {
+        g->min_x = fmin(g->min_x, fmin(segs[i].x1, segs[i].x2));
+        g->max_x = fmax(g->max_x, fmax(segs[i].x1, segs[i].x2));
+        g->min_y = fmin(g->min_y, fmin(segs[i].y1, segs[i].y2));
+        g->max_y = fmax(g->max_y, fmax(segs[i].y1, segs[i].y2));
+    }
+
+    // Por volta de uma célula por segmento, respeitando a proporção do bounding box
+    float w = fmax(g->max_x - g->min_x, 1e-3f);
+    float h = fmax(g->max_y - g->min_y, 1e-3f);
+    g->nx = (int)ceil(sqrt(n * w / h));
+    g->ny = (int)ceil(sqrt(n * h / w));
+    if (g->nx < 1) g->nx = 1;
+    if (g->ny < 1) g->ny = 1;
+    if (g->nx > 1024) g->nx = 1024;
+    if (g->ny > 1024) g->ny = 1024;
+    g->cel_w = w / g->nx;
+    g->cel_h = h / g->ny;
+
+    int n_cel = g->nx * g->ny;
+    g->inicio = calloc(n_cel + 1, sizeof(int));
+    g->marca = calloc(n, sizeof(int));
+    int* pos = calloc(n_cel, sizeof(int));
+    if (!g->inicio || !g->marca || !pos) {
+        free(pos);
+        liberaGradeSegmentos(g);
+        return NULL;
+    }
+
+    // Contagem por célula, prefixo e preenchimento
+    for (int k = 0; k < n; k++) distribuiSegmento(g, &segs[k], k, pos, NULL);
+    for (int c = 0; c < n_cel; c++) {
+        g->inicio[c + 1] = g->inicio[c] + pos[c];
+        pos[c] = g->inicio[c];
+    }
+    g->segs = malloc((g->inicio[n_cel] > 0 ? g->inicio[n_cel] : 1) * sizeof(int));
+    if (!g->segs) {
+        free(pos);
+        liberaGradeSegmentos(g);
+        return NULL;
+    }
+    for (int k = 0; k < n; k++) distribuiSegmento(g, &segs[k], k, pos, g->segs);
+    free(pos);
+
+    return g;
+}
+
+void liberaGradeSegmentos(GradeSegmentos G) {
+    if (!G) return;
+
+    stGradeSegmentos* g = (stGradeSegmentos*)G;
+    free(g->inicio);
+    free(g->segs);
+    free(g->marca);
+    free(g);
+}
+
+// Célula do ponto sem limitar à grade (pode ser negativa ou passar de nx/ny)
+static void celulaDoPonto(stGradeSegmentos* g, float x, float y, int* c, int* r) {
+    *c = (int)floor((x - g->min_x) / g->cel_w);
+    *r = (int)floor((y - g->min_y) / g->cel_h);
+}
+
+int getNumAneisGrade(GradeSegmentos G, float x, float y) {
+    if (!G) return 0;
+    stGradeSegmentos* g = (stGradeSegmentos*)G;
+
+    int c, r;
+    celulaDoPonto(g, x, y, &c, &r);
+    int dc = abs(c) > abs(g->nx - 1 - c) ? abs(c) : abs(g->nx - 1 - c);
+    int dr = abs(r) > abs(g->ny - 1 - r) ? abs(r) : abs(g->ny - 1 - r);
+    return (dc > dr ? dc : dr) + 1;
+}
+
+float getLadoCelulaGrade(GradeSegmentos G) {
+    if (!G) return 0.0f;
+    stGradeSegmentos* g = (stGradeSegmentos*)G;
+    return fmin(g->cel_w, g->cel_h);
+}
+
+void iniciaConsultaGrade(GradeSegmentos G) {
+    if (!G) return;
+    ((stGradeSegmentos*)G)->carimbo++;
+}
+
+// Copia para 'saida' os segmentos da célula ainda não devolvidos
+static int coletaCelula(stGradeSegmentos* g, int c, int r, int* saida) {
+    if (c < 0 || c >= g->nx || r < 0 || r >= g->ny) return 0;
+
+    int n = 0;
+    int cel = r * g->nx + c;
+    for (int i = g->inicio[cel]; i < g->inicio[cel + 1]; i++) {
+        int k = g->segs[i];
+        if (g->marca[k] == g->carimbo) continue;
+        g->marca[k] = g->carimbo;
+        saida[n++] = k;
+    }
+    return n;
+}
+
+int segmentosDoAnel(GradeSegmentos G, float x, float y, int anel, int* saida) {
+    if (!G || anel < 0) return 0;
+    stGradeSegmentos* g = (stGradeSegmentos*)G;
+
+    int c0, r0;
+    celulaDoPonto(g, x, y, &c0, &r0);
+    if (anel == 0) return coletaCelula(g, c0, r0, saida);
+
+    // Linhas de cima e de baixo inteiras; colunas das laterais sem os cantos.
+    // Os laços já começam e terminam dentro da grade
+    int c_ini = c0 - anel < 0 ? 0 : c0 - anel;
+    int c_fim = c0 + anel >= g->nx ? g->nx - 1 : c0 + anel;
+    int r_ini = r0 - anel + 1 < 0 ? 0 : r0 - anel + 1;
+    int r_fim = r0 + anel - 1 >= g->ny ? g->ny - 1 : r0 + anel - 1;
+
+    int n = 0;
+    for (int c = c_ini; c <= c_fim; c++) {
+        n += coletaCelula(g, c, r0 - anel, saida + n);
+        n += coletaCelula(g, c, r0 + anel, saida + n);
+    }
+    for (int r = r_ini; r <= r_fim; r++) {
+        n += coletaCelula(g, c0 - anel, r, saida + n);
+        n += coletaCelula(g, c0 + anel, r, saida + n);
+    }
+    return n;
+}
+
+// Raio o + t*d contra o segmento a + u*(b - a), com t >= 0 e u em [0, 1]
+static bool raioAtingeSegmento(double ox, double oy, double dx, double dy,
+                               const SegmentoPlano* s, double* t) {
+    double ex = (double)s->x2 - s->x1;
+    double ey = (double)s->y2 - s->y1;
+    double den = dx * ey - dy * ex;
+    if (den == 0.0) return false;
+
+    double wx = s->x1 - ox;
+    double wy = s->y1 - oy;
+    double tt = (wx * ey - wy * ex) / den;
+    double u = (wx * dy - wy * dx) / den;
+    if (tt < 0.0 || u < 0.0 || u > 1.0) return false;
+
+    *t = tt;
+    return true;
+}
+
+// Trecho [*t0, *t1] do raio dentro do bounding box da grade; false se não o corta
+static bool recortaRaio(stGradeSegmentos* g, double ox, double oy, double dx, double dy,
+                        double* t0, double* t1) {
+    double lo[2] = {g->min_x, g->min_y};
+    double hi[2] = {g->min_x + g->nx * g->cel_w, g->min_y + g->ny * g->cel_h};
+    double o[2] = {ox, oy}, d[2] = {dx, dy};
+
+    *t0 = 0.0;
+    *t1 = INFINITY;
+    for (int e = 0; e < 2; e++) {
+        if (d[e] == 0.0) {
+            if (o[e] < lo[e] || o[e] > hi[e]) return false;
+            continue;
+        }
+        double ta = (lo[e] - o[e]) / d[e];
+        double tb = (hi[e] - o[e]) / d[e];
+        if (ta > tb) { double tmp = ta; ta = tb; tb = tmp; }
+        if (ta > *t0) *t0 = ta;
+        if (tb < *t1) *t1 = tb;
+    }
+    return *t0 <= *t1;
+}
+
+int lancaRaioGrade(GradeSegmentos G, const SegmentoPlano* segs,
+                   float ox, float oy, float dx, float dy, float* t) {
+    if (!G || !segs || (dx == 0.0f && dy == 0.0f)) return -1;
+    stGradeSegmentos* g = (stGradeSegmentos*)G;
+
+    double t0, t1;
+    if (!recortaRaio(g, ox, oy, dx, dy, &t0, &t1)) return -1;
+
+    // Célula de entrada e, por eixo, o t da próxima fronteira e o t entre fronteiras
+    int c = colunaGrade(g, ox + t0 * dx);
+    int r = linhaGrade(g, oy + t0 * dy);
+    int passo_c = dx > 0 ? 1 : -1;
+    int passo_r = dy > 0 ? 1 : -1;
+    double prox_c = INFINITY, prox_r = INFINITY, delta_c = INFINITY, delta_r = INFINITY;
+    if (dx != 0.0f) {
+        double borda = g->min_x + (c + (dx > 0 ? 1 : 0)) * (double)g->cel_w;
+        prox_c = (borda - ox) / dx;
+        delta_c = g->cel_w / fabs(dx);
+    }
+    if (dy != 0.0f) {
+        double borda = g->min_y + (r + (dy > 0 ? 1 : 0)) * (double)g->cel_h;
+        prox_r = (borda - oy) / dy;
+        delta_r = g->cel_h / fabs(dy);
+    }
+
+    int melhor = -1;
+    double t_melhor = INFINITY;
+    while (c >= 0 && c < g->nx && r >= 0 && r < g->ny) {
+        int cel = r * g->nx + c;
+        for (int i = g->inicio[cel]; i < g->inicio[cel + 1]; i++) {
+            double tt;
+            int k = g->segs[i];
+            if (raioAtingeSegmento(ox, oy, dx, dy, &segs[k], &tt) && tt < t_melhor) {
+                t_melhor = tt;
+                melhor = k;
+            }
+        }
+
+        // Acerto antes da saída da célula: nenhuma célula adiante tem um mais próximo
+        double saida = prox_c < prox_r ? prox_c : prox_r;
+        if (melhor >= 0 && t_melhor <= saida) break;
+        if (saida > t1) break;
+
+        if (prox_c < prox_r) {
+            c += passo_c;
+            prox_c += delta_c;
+        } else {
+            r += passo_r;
+            prox_r += delta_r;
+        }
+    }
+
+    if (melhor >= 0) *t = (float)t_melhor;
+    return melhor;
+}
@@ -0,0 +1,103 @@
+#ifndef GRADE_SEGMENTOS_H
+#define GRADE_SEGMENTOS_H
+
+#include "intersecao_segmentos.h"
+
+/**
+ * @file grade_segmentos.h
+ * @brief Grade uniforme sobre um conjunto de segmentos.
+ *
+ * Cada célula guarda os índices dos segmentos que passam por ela. A grade
+ * permite visitar os segmentos em anéis de células cada vez mais distantes de
+ * um ponto, ou ao longo de um raio, sem percorrer o conjunto inteiro.
+ */
+
+/**
+ * @brief Tipo opaco para representar a grade.
+ */
+typedef void* GradeSegmentos;
+
+/**
+ * @brief Cria a grade sobre o bounding box dos segmentos, com por volta de
+ *        uma célula por segmento.
+ *
+ * @param segs Segmentos (o array não é copiado nem guardado).
+ * @param n Número de segmentos.
+ * @return Grade criada, ou NULL se n == 0 ou faltar memória.
+ */
+GradeSegmentos criaGradeSegmentos(const SegmentoPlano* segs, int n);
+
+/**
+ * @brief Libera a grade.
+ *
+ * @param g Grade a ser liberada.
+ */
+void liberaGradeSegmentos(GradeSegmentos g);
+
+/**
+ * @brief Número de anéis necessários para alcançar todas as células a
+ *        partir de um ponto.
+ *
+ * O anel 0 é a célula do ponto; o anel r são as células a distância r dela
+ * (na maior das duas direções). O ponto pode estar fora da grade.
+ *
+ * @param g Grade.
+ * @param x Coordenada X do ponto.
+ * @param y Coordenada Y do ponto.
+ * @return Número de anéis (os anéis vão de 0 a este valor - 1).
+ */
+int getNumAneisGrade(GradeSegmentos g, float x, float y);
+
+/**
+ * @brief Menor lado de uma célula.
+ *
+ * Um segmento a menos de r * lado do ponto está em algum dos anéis 0 a r.
+ *
+ * @param g Grade.
+ * @return Menor lado de uma célula.
+ */
+float getLadoCelulaGrade(GradeSegmentos g);
+
+/**
+ * @brief Começa uma nova sequência de consultas por anel.
+ *
+ * Dentro de uma sequência cada segmento é devolvido uma única vez, no
+ * primeiro anel em que aparece.
+ *
+ * @param g Grade.
+ */
+void iniciaConsultaGrade(GradeSegmentos g);
+
+/**
+ * @brief Segmentos das células de um anel em torno de um ponto.
+ *
+ * @param g Grade.
+ * @param x Coordenada X do ponto.
+ * @param y Coordenada Y do ponto.
+ * @param anel Índice do anel.
+ * @param saida Saída: índices dos segmentos ainda não devolvidos na sequência
+ *              atual (espaço para o número total de segmentos basta).
+ * @return Número de índices escritos em saida.
+ */
+int segmentosDoAnel(GradeSegmentos g, float x, float y, int anel, int* saida);
+
+/**
+ * @brief Primeiro segmento atingido por um raio.
+ *
+ * Percorre só as células cortadas pelo raio, em ordem (DDA), e para na
+ * primeira célula em que já há um acerto antes da saída dela. Segmentos
+ * paralelos ao raio não contam como acerto.
+ *
+ * @param g Grade.
+ * @param segs Os mesmos segmentos passados a criaGradeSegmentos().
+ * @param ox Coordenada X da origem do raio.
+ * @param oy Coordenada Y da origem do raio.
+ * @param dx Componente X da direção (não precisa ser unitária).
+ * @param dy Componente Y da direção.
+ * @param t Saída: parâmetro do acerto, isto é, o ponto é (ox + t*dx, oy + t*dy).
+ * @return Índice do segmento atingido, ou -1 se o raio não atinge nenhum.
+ */
+int lancaRaioGrade(GradeSegmentos g, const SegmentoPlano* segs,
+                   float ox, float oy, float dx, float dy, float* t);
+
+#endif
@@ -0,0 +1,334 @@
+#include "indice_ids.h"
+#include "sort.h"
+#include "sort_tipado.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+// Capacidade inicial (potência de dois)
+#define INDICE_CAPACIDADE_INICIAL 64
+
+// Entradas fora de ordem acumuladas antes de intercalar com a sequência ordenada
+#define INDICE_PENDENTES_MIN 64
+
+typedef struct {
+    void* item;       // NULL: posição livre
+    int id;
+    unsigned int seq; // Ordem de inserção
+    int pendente;     // Na tabela: posição em 'pendentes', ou -1 se está em 'ordem'
+} EntradaId;
+
+// Vetor de entradas que cresce dobrando
+typedef struct {
+    EntradaId* v;
+    int n;
+    int cap;
+} VetorEntradas;
+
+typedef struct {
+    EntradaId* tabela;
+    int capacidade;   // Potência de dois
+    int n;
+    unsigned int proxima_seq;
+
+    // Índice ordenado para as faixas: entradas em ordem de (id, seq), com
+    // item NULL marcando as removidas, mais as inseridas fora de ordem
+    VetorEntradas ordem;
+    int apagadas;
+    VetorEntradas pendentes;
+} stIndiceIds;
+
+#define ENTRADA_MENOR_SEQ(a, b) ((a)->seq < (b)->seq)
+SORT_TIPADO(entradas_seq, EntradaId, ENTRADA_MENOR_SEQ)
+
+#define ENTRADA_MENOR_ID(a, b) ((a)->id < (b)->id || ((a)->id == (b)->id && (a)->seq < (b)->seq))
+SORT_TIPADO(entradas_id, EntradaId, ENTRADA_MENOR_ID)
+
+// Hash multiplicativo (Fibonacci): IDs consecutivos caem espalhados
+static inline int posicaoInicial(const stIndiceIds* ind, int id) {
+    uint32_t h = (uint32_t)id * 2654435769u;
+    return (int)(h >> 7) & (ind->capacidade - 1);
+}
+
+static EntradaId* alocaTabela(int capacidade) {
+    EntradaId* t = calloc(capacidade, sizeof(EntradaId));
+    if (t == NULL) {
+        printf("Erro de alocação para índice de IDs\n");
+        exit(1);
+    }
+    return t;
+}
+
+// Coloca a entrada na primeira posição livre a partir da inicial
+static void colocaEntrada(stIndiceIds* ind, EntradaId e) {
+    int mascara = ind->capacidade - 1;
+    int p = posicaoInicial(ind, e.id);
+    while (ind->tabela[p].item != NULL) p = (p + 1) & mascara;
+    ind->tabela[p] = e;
+}
+
+static void empilhaEntrada(VetorEntradas* vet, EntradaId e) {
+    if (vet->n == vet->cap) {
+        int nova = vet->cap ? 2 * vet->cap : INDICE_CAPACIDADE_INICIAL;
+        EntradaId* v = realloc(vet->v, nova * sizeof(EntradaId));
+        if (v == NULL) {
+            printf("Erro de alocação para índice de IDs\n");
+            exit(1);
+        }
+        vet->v = v;
+        vet->cap = nova;
+    }
+    vet->v[vet->n++] = e;
+}
+
+// Primeira posição de 'ordem' com id >= alvo (as apagadas mantêm o id)
+static int limiteInferior(const stIndiceIds* ind, int alvo) {
+    int lo = 0, hi = ind->ordem.n;
+    while (lo < hi) {
+        int meio = lo + (hi - lo) / 2;
+        if (ind->ordem.v[meio].id < alvo) lo = meio + 1;
+        else hi = meio;
+    }
+    return lo;
+}
+
+// Primeira posição de 'ordem' com id > alvo
+static int limiteSuperior(const stIndiceIds* ind, int alvo) {
+    int lo = 0, hi = ind->ordem.n;
+    while (lo < hi) {
+        int meio = lo + (hi - lo) / 2;
+        if (ind->ordem.v[meio].id <= alvo) lo = meio + 1;
+        else hi = meio;
+    }
+    return lo;
+}
+
+// Entrada da tabela com o par (id, item), ou NULL
+static EntradaId* localizaTabela(stIndiceIds* ind, int id, void* item) {
+    int mascara = ind->capacidade - 1;
+    for (int p = posicaoInicial(ind, id); ind->tabela[p].item != NULL; p = (p + 1) & mascara) {
+        if (ind->tabela[p].id == id && ind->tabela[p].item == item) return &ind->tabela[p];
+    }
+    return NULL;
+}
+
+// Intercala as pendentes com a sequência ordenada, descartando as apagadas
+static void intercalaPendentes(stIndiceIds* ind) {
+    VetorEntradas* pend = &ind->pendentes;
+    for (int b = 0; b < pend->n; b++) {
+        // A entrada sendo inserida agora ainda não está na tabela
+        EntradaId* t = localizaTabela(ind, pend->v[b].id, pend->v[b].item);
+        if (t != NULL) t->pendente = -1;
+        pend->v[b].pendente = -1;
+    }
+    entradas_id_merge_sort(pend->v, pend->n, SORT_LIMIAR_PADRAO);
+
+    int total = ind->ordem.n - ind->apagadas + pend->n;
+    EntradaId* v = malloc((total + 1) * sizeof(EntradaId));
+    if (v == NULL) {
+        printf("Erro de alocação para índice de IDs\n");
+        exit(1);
+    }
+
+    int a = 0, b = 0, k = 0;
+    while (a < ind->ordem.n || b < pend->n) {
+        if (a < ind->ordem.n && ind->ordem.v[a].item == NULL) {
+            a++;
+        } else if (b >= pend->n ||
+                   (a < ind->ordem.n && !ENTRADA_MENOR_ID(&pend->v[b], &ind->ordem.v[a]))) {
+            v[k++] = ind->ordem.v[a++];
+        } else {
+            v[k++] = pend->v[b++];
+        }
+    }
+
+    free(ind->ordem.v);
+    ind->ordem.v = v;
+    ind->ordem.n = k;
+    ind->ordem.cap = total + 1;
+    ind->apagadas = 0;
+    pend->n = 0;
+}
+
+// Retorna a posição da entrada em 'pendentes', ou -1 se ela foi para 'ordem'
+static int insereOrdenado(stIndiceIds* ind, EntradaId e) {
+    // IDs novos costumam ser maiores que todos (clones, anteparos): vão para o fim
+    if (ind->pendentes.n == 0 &&
+        (ind->ordem.n == 0 || ind->ordem.v[ind->ordem.n - 1].id <= e.id)) {
+        empilhaEntrada(&ind->ordem, e);
+        return -1;
+    }
+    e.pendente = ind->pendentes.n;
+    empilhaEntrada(&ind->pendentes, e);
+    if (ind->pendentes.n > INDICE_PENDENTES_MIN + ind->ordem.n / 8) {
+        intercalaPendentes(ind);
+        return -1;
+    }
+    return e.pendente;
+}
+
+// 'e' é a cópia da entrada da tabela, que diz onde o par está
+static void removeOrdenado(stIndiceIds* ind, EntradaId e) {
+    VetorEntradas* pend = &ind->pendentes;
+    if (e.pendente >= 0) {
+        // Troca com a última pendente, que passa a ocupar a posição removida
+        EntradaId ultima = pend->v[--pend->n];
+        if (e.pendente < pend->n) {
+            ultima.pendente = e.pendente;
+            pend->v[e.pendente] = ultima;
+            localizaTabela(ind, ultima.id, ultima.item)->pendente = e.pendente;
+        }
+        return;
+    }
+
+    int id = e.id;
+    void* item = e.item;
+    for (int p = limiteInferior(ind, id); p < ind->ordem.n && ind->ordem.v[p].id == id; p++) {
+        if (ind->ordem.v[p].item == item) {
+            ind->ordem.v[p].item = NULL;
+            ind->apagadas++;
+            if (ind->apagadas > INDICE_PENDENTES_MIN && 2 * ind->apagadas > ind->ordem.n) {
+                intercalaPendentes(ind);
+            }
+            return;
+        }
+    }
+}
+
+static void dobraCapacidade(stIndiceIds* ind) {
+    EntradaId* antiga = ind->tabela;
+    int cap_antiga = ind->capacidade;
+
+    ind->capacidade *= 2;
+    ind->tabela = alocaTabela(ind->capacidade);
+    for (int p = 0; p < cap_antiga; p++) {
+        if (antiga[p].item != NULL) colocaEntrada(ind, antiga[p]);
+    }
+    free(antiga);
+}
+
+IndiceIds criaIndiceIds() {
+    stIndiceIds* ind = malloc(sizeof(stIndiceIds));
+    if (ind == NULL) {
+        printf("Erro de alocação para índice de IDs\n");
+        exit(1);
+    }
+    ind->capacidade = INDICE_CAPACIDADE_INICIAL;
+    ind->tabela = alocaTabela(ind->capacidade);
+    ind->n = 0;
+    ind->proxima_seq = 0;
+    ind->ordem = (VetorEntradas){NULL, 0, 0};
+    ind->apagadas = 0;
+    ind->pendentes = (VetorEntradas){NULL, 0, 0};
+    return ind;
+}
+
+void liberaIndiceIds(IndiceIds I) {
+    if (!I) return;
+
+    stIndiceIds* ind = (stIndiceIds*)I;
+    free(ind->tabela);
+    free(ind->ordem.v);
+    free(ind->pendentes.v);
+    free(ind);
+}
+
+void insereIndiceIds(IndiceIds I, int id, void* item) {
+    if (!I || !item) return;
+    stIndiceIds* ind = (stIndiceIds*)I;
+
+    // Ocupação máxima de 3/4
+    if (4 * (ind->n + 1) > 3 * ind->capacidade) dobraCapacidade(ind);
+
+    EntradaId e = {item, id, ind->proxima_seq++, -1};
+    e.pendente = insereOrdenado(ind, e);
+    colocaEntrada(ind, e);
+    ind->n++;
+}
+
+bool removeIndiceIds(IndiceIds I, int id, void* item) {
+    if (!I) return false;
+    stIndiceIds* ind = (stIndiceIds*)I;
+    int mascara = ind->capacidade - 1;
+
+    int p = posicaoInicial(ind, id);
+    while (ind->tabela[p].item != NULL &&
+           !(ind->tabela[p].id == id && ind->tabela[p].item == item)) {
+        p = (p + 1) & mascara;
+    }
+    if (ind->tabela[p].item == NULL) return false;
+    EntradaId removida = ind->tabela[p];
+
+    // Remoção com deslocamento para trás: nenhuma marca de apagado fica na tabela
+    ind->tabela[p].item = NULL;
+    for (int q = (p + 1) & mascara; ind->tabela[q].item != NULL; q = (q + 1) & mascara) {
+        int h = posicaoInicial(ind, ind->tabela[q].id);
+        if (((q - h) & mascara) >= ((q - p) & mascara)) {
+            ind->tabela[p] = ind->tabela[q];
+            ind->tabela[q].item = NULL;
+            p = q;
+        }
+    }
+    removeOrdenado(ind, removida);
+    ind->n--;
+    return true;
+}
+
+void* buscaIndiceIds(IndiceIds I, int id) {
+    if (!I) return NULL;
+    stIndiceIds* ind = (stIndiceIds*)I;
+    int mascara = ind->capacidade - 1;
+
+    void* achado = NULL;
+    unsigned int seq_achado = 0;
+    for (int p = posicaoInicial(ind, id); ind->tabela[p].item != NULL; p = (p + 1) & mascara) {
+        const EntradaId* e = &ind->tabela[p];
+        if (e->id == id && (achado == NULL || e->seq < seq_achado)) {
+            achado = e->item;
+            seq_achado = e->seq;
+        }
+    }
+    return achado;
+}
+
+int faixaIndiceIds(IndiceIds I, int i, int j, Vetor saida) {
+    if (!I || !saida || i > j) return 0;
+    stIndiceIds* ind = (stIndiceIds*)I;
+
+    // Buffer do tamanho da faixa na sequência ordenada mais o das pendentes nela
+    int ini = limiteInferior(ind, i);
+    int fim = limiteSuperior(ind, j);
+    int n_pend = 0;
+    for (int p = 0; p < ind->pendentes.n; p++) {
+        const EntradaId* e = &ind->pendentes.v[p];
+        if (e->id >= i && e->id <= j) n_pend++;
+    }
+
+    EntradaId* achadas = malloc((fim - ini + n_pend + 1) * sizeof(EntradaId));
+    if (achadas == NULL) {
+        printf("Erro de alocação para índice de IDs\n");
+        exit(1);
+    }
+    int k = 0;
+
+    for (int p = ini; p < fim; p++) {
+        if (ind->ordem.v[p].item != NULL) achadas[k++] = ind->ordem.v[p];
+    }
+    for (int p = 0; p < ind->pendentes.n; p++) {
+        const EntradaId* e = &ind->pendentes.v[p];
+        if (e->id >= i && e->id <= j) achadas[k++] = *e;
+    }
+
+    entradas_seq_quick_sort(achadas, k, SORT_LIMIAR_PADRAO);
+    reservaVetor(saida, getTamanhoVetor(saida) + k);
+    for (int a = 0; a < k; a++) insereFinalVetor(saida, achadas[a].item);
+
+    free(achadas);
+    return k;
+}
+
+int getTamanhoIndiceIds(IndiceIds I) {
+    if (!I) return 0;
+    return ((stIndiceIds*)I)->n;
+}
@@ -0,0 +1,100 @@
+#ifndef INDICE_IDS_H
+#define INDICE_IDS_H
+
+#include <stdbool.h>
+#include "vetor.h"
+
+/**
+ * @file indice_ids.h
+ * @brief Índice de itens por ID inteiro, com busca pontual e por faixa.
+ *
+ * A busca pontual usa uma tabela de sondagem linear com capacidade potência
+ * de dois. As faixas usam uma sequência ordenada por ID, em que as remoções
+ * só marcam a entrada como apagada, e um pequeno conjunto de entradas
+ * inseridas fora de ordem, intercalado com a sequência quando cresce. Como
+ * os IDs novos costumam ser maiores que os existentes, a maioria das
+ * inserções vai direto para o fim da sequência.
+ *
+ * IDs repetidos são permitidos: cada par é uma entrada. Cada entrada recebe
+ * um número de sequência na inserção, de modo que as consultas por faixa
+ * devolvem os itens na ordem em que foram inseridos, a mesma de um vetor
+ * mantido com insereFinalVetor().
+ */
+
+/**
+ * @brief Tipo opaco para representar o índice.
+ */
+typedef void* IndiceIds;
+
+/**
+ * @brief Cria um índice vazio.
+ *
+ * @return Índice criado.
+ */
+IndiceIds criaIndiceIds();
+
+/**
+ * @brief Libera o índice (os itens não são liberados).
+ *
+ * @param ind Índice a ser liberado.
+ */
+void liberaIndiceIds(IndiceIds ind);
+
+/**
+ * @brief Insere o par (id, item). O(1) amortizado.
+ *
+ * @param ind Índice.
+ * @param id ID do item.
+ * @param item Item a ser indexado.
+ */
+void insereIndiceIds(IndiceIds ind, int id, void* item);
+
+/**
+ * @brief Remove o par (id, item). O(log n) esperado.
+ *
+ * A entrada da tabela guarda onde o par está na parte ordenada: na
+ * sequência, ele é achado por busca binária; entre as inseridas fora de
+ * ordem, pela posição guardada, sem percorrê-las.
+ *
+ * @param ind Índice.
+ * @param id ID com que o item foi inserido.
+ * @param item Item a ser removido.
+ * @return true se o par estava no índice.
+ */
+bool removeIndiceIds(IndiceIds ind, int id, void* item);
+
+/**
+ * @brief Busca um item pelo ID. O(1) esperado.
+ *
+ * @param ind Índice.
+ * @param id ID procurado.
+ * @return O item inserido primeiro com esse ID, ou NULL se não houver.
+ */
+void* buscaIndiceIds(IndiceIds ind, int id);
+
+/**
+ * @brief Coleta os itens com ID em [i, j], na ordem de inserção.
+ *
+ * Busca binária do início da faixa na sequência ordenada, seguida das
+ * entradas até j e das inseridas fora de ordem ainda não intercaladas. Custa
+ * O(log n + p + k log k) para k itens encontrados e p inseridas fora de ordem
+ * (no máximo 64 + n/8), qualquer que seja a largura da faixa; a memória
+ * temporária é proporcional ao tamanho da faixa, não ao do índice.
+ *
+ * @param ind Índice.
+ * @param i Menor ID da faixa.
+ * @param j Maior ID da faixa.
+ * @param saida Vetor que recebe os itens no final.
+ * @return Número de itens encontrados.
+ */
+int faixaIndiceIds(IndiceIds ind, int i, int j, Vetor saida);
+
+/**
+ * @brief Número de pares no índice.
+ *
+ * @param ind Índice.
+ * @return Número de pares.
+ */
+int getTamanhoIndiceIds(IndiceIds ind);
+
+#endif
@@ -0,0 +1,423 @@
+#include "intersecao_segmentos.h"
+#include "arvore_binaria.h"
+#include "sort.h"
+#include "sort_tipado.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+// Cruzamentos a menos disso (em parâmetro) de uma extremidade contam como toque
+#define MARGEM_PARAMETRO 1e-6
+// Diferença de y abaixo da qual dois segmentos são considerados no mesmo ponto
+#define EPSILON_Y 1e-9
+
+/* ================= Cruzamento de dois segmentos ================= */
+
+// Ordem lexicográfica (x, depois y) de dois pontos
+static int cmpPontos(double ax, double ay, double bx, double by) {
+    if (ax < bx) return -1;
+    if (ax > bx) return 1;
+    if (ay < by) return -1;
+    if (ay > by) return 1;
+    return 0;
+}
+
+// Segmento com a extremidade lexicograficamente menor primeiro
+static SegmentoPlano normaliza(const SegmentoPlano* s) {
+    SegmentoPlano r = *s;
+    if (cmpPontos(r.x1, r.y1, r.x2, r.y2) > 0) {
+        r.x1 = s->x2;
+        r.y1 = s->y2;
+        r.x2 = s->x1;
+        r.y2 = s->y1;
+    }
+    return r;
+}
+
+static int cmpSegmentosPlano(const SegmentoPlano* a, const SegmentoPlano* b) {
+    int c = cmpPontos(a->x1, a->y1, b->x1, b->y1);
+    if (c != 0) return c;
+    return cmpPontos(a->x2, a->y2, b->x2, b->y2);
+}
+
+bool cruzamentoSegmentos(const SegmentoPlano* sa, const SegmentoPlano* sb, float* px, float* py) {
+    // Mesma ordem para qualquer ordem de argumentos: o ponto sai idêntico
+    SegmentoPlano a = normaliza(sa);
+    SegmentoPlano b = normaliza(sb);
+    if (cmpSegmentosPlano(&a, &b) > 0) {
+        SegmentoPlano t = a;
+        a = b;
+        b = t;
+    }
+
+    double adx = (double)a.x2 - a.x1, ady = (double)a.y2 - a.y1;
+    double bdx = (double)b.x2 - b.x1, bdy = (double)b.y2 - b.y1;
+    double det = adx * bdy - ady * bdx;
+
+    // Paralelos ou colineares (relativo ao comprimento dos dois)
+    double escala = sqrt(adx * adx + ady * ady) * sqrt(bdx * bdx + bdy * bdy);
+    if (escala == 0.0 || fabs(det) <= 1e-9 * escala) return false;
+
+    double ox = (double)b.x1 - a.x1, oy = (double)b.y1 - a.y1;
+    double t = (ox * bdy - oy * bdx) / det;
+    double u = (ox * ady - oy * adx) / det;
+
+    if (t <= MARGEM_PARAMETRO || t >= 1.0 - MARGEM_PARAMETRO) return false;
+    if (u <= MARGEM_PARAMETRO || u >= 1.0 - MARGEM_PARAMETRO) return false;
+
+    if (px) *px = (float)(a.x1 + t * adx);
+    if (py) *py = (float)(a.y1 + t * ady);
+    return true;
+}
+
+/* ================= Fila de eventos (heap mínimo) ================= */
+
+// Num mesmo ponto: fins, depois cruzamentos, depois inícios
+typedef enum { EV_FIM, EV_CRUZAMENTO, EV_INICIO } TipoEvento;
+
+typedef struct {
+    double x, y;
+    TipoEvento tipo;
+    int a, b;  // Segmento (a) ou par em cruzamento (a abaixo de b ao agendar)
+} Evento;
+
+typedef struct {
+    Evento* v;
+    int n;
+    int cap;
+} FilaEventos;
+
+static bool eventoMenor(const Evento* a, const Evento* b) {
+    int c = cmpPontos(a->x, a->y, b->x, b->y);
+    if (c != 0) return c < 0;
+    return a->tipo < b->tipo;
+}
+
+static void empilhaEvento(FilaEventos* f, Evento e) {
+    if (f->n == f->cap) {
+        f->cap = f->cap ? 2 * f->cap : 64;
+        f->v = realloc(f->v, f->cap * sizeof(Evento));
+        if (f->v == NULL) {
+            printf("Erro de alocação para fila de eventos\n");
+            exit(1);
+        }
+    }
+
+    int i = f->n++;
+    while (i > 0) {
+        int pai = (i - 1) / 2;
+        if (!eventoMenor(&e, &f->v[pai])) break;
+        f->v[i] = f->v[pai];
+        i = pai;
+    }
+    f->v[i] = e;
+}
+
+static Evento desempilhaEvento(FilaEventos* f) {
+    Evento topo = f->v[0];
+    Evento ultimo = f->v[--f->n];
+
+    int i = 0;
+    for (;;) {
+        int filho = 2 * i + 1;
+        if (filho >= f->n) break;
+        if (filho + 1 < f->n && eventoMenor(&f->v[filho + 1], &f->v[filho])) filho++;
+        if (!eventoMenor(&f->v[filho], &ultimo)) break;
+        f->v[i] = f->v[filho];
+        i = filho;
+    }
+    if (f->n > 0) f->v[i] = ultimo;
+    return topo;
+}
+
+/* ================= Varredura ================= */
+
+typedef struct {
+    const SegmentoPlano* entrada;
+    SegmentoPlano* segs;   // Normalizados: extremidade esquerda primeiro
+    NoArvore* no;          // Nó de cada segmento no status (NULL se inativo)
+    double x, y;           // Ponto do evento atual
+    FilaEventos fila;
+    ArvoreBinaria status;  // Segmentos ativos ordenados por y na reta x = evento atual
+    int* pares;
+    int n_pares;
+    int cap_pares;
+} EstadoVarredura;
+
+static double yNaVarredura(const EstadoVarredura* st, const SegmentoPlano* s) {
+    if (s->x1 == s->x2) {
+        // Vertical: vale o y do evento, limitado ao segmento
+        double y = st->y;
+        if (y < s->y1) y = s->y1;
+        if (y > s->y2) y = s->y2;
+        return y;
+    }
+    return s->y1 + (st->x - s->x1) * ((double)s->y2 - s->y1) / ((double)s->x2 - s->x1);
+}
+
+static double inclinacao(const SegmentoPlano* s) {
+    if (s->x1 == s->x2) return INFINITY;
+    return ((double)s->y2 - s->y1) / ((double)s->x2 - s->x1);
+}
+
+static int cmpStatus(const void* a, const void* b, void* contexto) {
+    if (a == b) return 0;
+    const EstadoVarredura* st = contexto;
+    const SegmentoPlano* sa = a;
+    const SegmentoPlano* sb = b;
+
+    double ya = yNaVarredura(st, sa);
+    double yb = yNaVarredura(st, sb);
+    if (ya < yb - EPSILON_Y) return -1;
+    if (ya > yb + EPSILON_Y) return 1;
+
+    // Passam pelo mesmo ponto: à direita dele fica abaixo o de menor inclinação
+    double ia = inclinacao(sa);
+    double ib = inclinacao(sb);
+    if (ia < ib) return -1;
+    if (ia > ib) return 1;
+
+    return (sa < sb) ? -1 : 1;
+}
+
+static int indiceNo(const EstadoVarredura* st, NoArvore no) {
+    return (int)((const SegmentoPlano*)getDadoNo(no) - st->segs);
+}
+
+// Vizinhos ainda não trocados: o de baixo sobe mais rápido que o de cima
+static bool convergem(const EstadoVarredura* st, int abaixo, int acima) {
+    return inclinacao(&st->segs[abaixo]) > inclinacao(&st->segs[acima]);
+}
+
+// Agenda o cruzamento de dois vizinhos que ainda não se cruzaram. Vários segmentos
+// pelo mesmo ponto se cruzam aos pares nele; um ponto que o arredondamento deixou
+// atrás da varredura é tratado no evento atual
+static void verificaVizinhos(EstadoVarredura* st, NoArvore abaixo, NoArvore acima) {
+    if (abaixo == NULL || acima == NULL) return;
+
+    int i = indiceNo(st, abaixo);
+    int j = indiceNo(st, acima);
+    if (!convergem(st, i, j)) return;
+
+    float px, py;
+    if (!cruzamentoSegmentos(&st->entrada[i], &st->entrada[j], &px, &py)) return;
+
+    Evento e = { px, py, EV_CRUZAMENTO, i, j };
+    if (cmpPontos(px, py, st->x, st->y) < 0) {
+        e.x = st->x;
+        e.y = st->y;
+    }
+    empilhaEvento(&st->fila, e);
+}
+
+static void registraPar(EstadoVarredura* st, int a, int b) {
+    if (st->n_pares == st->cap_pares) {
+        st->cap_pares = st->cap_pares ? 2 * st->cap_pares : 64;
+        st->pares = realloc(st->pares, 2 * st->cap_pares * sizeof(int));
+        if (st->pares == NULL) {
+            printf("Erro de alocação para pares de cruzamento\n");
+            exit(1);
+        }
+    }
+    st->pares[2 * st->n_pares] = a;
+    st->pares[2 * st->n_pares + 1] = b;
+    st->n_pares++;
+}
+
+int encontraCruzamentos(const SegmentoPlano* entrada, int n, int** pares) {
+    *pares = NULL;
+    if (n < 2) return 0;
+
+    EstadoVarredura st;
+    st.entrada = entrada;
+    st.segs = malloc(n * sizeof(SegmentoPlano));
+    st.no = calloc(n, sizeof(NoArvore));
+    st.fila.v = NULL;
+    st.fila.n = 0;
+    st.fila.cap = 0;
+    st.pares = NULL;
+    st.n_pares = 0;
+    st.cap_pares = 0;
+    st.x = -INFINITY;
+    st.y = -INFINITY;
+    if (st.segs == NULL || st.no == NULL) {
+        printf("Erro de alocação para varredura de cruzamentos\n");
+        exit(1);
+    }
+    st.status = criaArvoreBinariaComPool(cmpStatus, &st, 0);
+
+    for (int i = 0; i < n; i++) {
+        st.segs[i] = normaliza(&entrada[i]);
+        const SegmentoPlano* s = &st.segs[i];
+        if (s->x1 == s->x2 && s->y1 == s->y2) continue;  // Degenerado: não cruza nada
+
+        Evento ini = { s->x1, s->y1, EV_INICIO, i, -1 };
+        Evento fim = { s->x2, s->y2, EV_FIM, i, -1 };
+        empilhaEvento(&st.fila, ini);
+        empilhaEvento(&st.fila, fim);
+    }
+
+    while (st.fila.n > 0) {
+        Evento e = desempilhaEvento(&st.fila);
+        st.x = e.x;
+        st.y = e.y;
+
+        if (e.tipo == EV_INICIO) {
+            NoArvore no = insereArvoreBinaria(st.status, &st.segs[e.a]);
+            st.no[e.a] = no;
+            verificaVizinhos(&st, getAnteriorNo(no), no);
+            verificaVizinhos(&st, no, getProximoNo(no));
+
+        } else if (e.tipo == EV_FIM) {
+            NoArvore no = st.no[e.a];
+            if (no == NULL) continue;
+            NoArvore ant = getAnteriorNo(no);
+            NoArvore prox = getProximoNo(no);
+            removeNoArvore(st.status, no);
+            st.no[e.a] = NULL;
+            verificaVizinhos(&st, ant, prox);
+
+        } else {
+            // Só vale se os dois ainda são vizinhos na ordem em que foram agendados
+            NoArvore na = st.no[e.a];
+            NoArvore nb = st.no[e.b];
+            if (na == NULL || nb == NULL || getProximoNo(na) != nb) continue;
+            if (!convergem(&st, e.a, e.b)) continue;
+
+            registraPar(&st, e.a, e.b);
+
+            // Depois do cruzamento a ordem dos dois se inverte
+            trocaDadosNos(na, nb);
+            st.no[e.a] = nb;
+            st.no[e.b] = na;
+            verificaVizinhos(&st, getAnteriorNo(na), na);
+            verificaVizinhos(&st, nb, getProximoNo(nb));
+        }
+    }
+
+    liberaArvoreBinaria(st.status, NULL);
+    free(st.fila.v);
+    free(st.segs);
+    free(st.no);
+
+    *pares = st.pares;
+    return st.n_pares;
+}
+
+/* ================= Divisão ================= */
+
+typedef struct {
+    double t;  // Posição ao longo do segmento original
+    float x, y;
+} Corte;
+
+#define CORTE_MENOR(a, b) ((a)->t < (b)->t)
+SORT_TIPADO(cortes, Corte, CORTE_MENOR)
+
+static double parametroNoSegmento(const SegmentoPlano* s, float x, float y) {
+    double dx = (double)s->x2 - s->x1;
+    double dy = (double)s->y2 - s->y1;
+    double l2 = dx * dx + dy * dy;
+    if (l2 == 0.0) return 0.0;
+    return (((double)x - s->x1) * dx + ((double)y - s->y1) * dy) / l2;
+}
+
+// Escreve os pedaços de 's' entre os cortes (já ordenados) e retorna quantos
+static int escrevePedacos(const SegmentoPlano* s, Corte* cortes, int n_cortes,
+                          int origem, PedacoSegmento* saida) {
+    int n = 0;
+    float x = s->x1, y = s->y1;
+    for (int c = 0; c < n_cortes; c++) {
+        if (cortes[c].x == x && cortes[c].y == y) continue;  // Corte repetido
+        saida[n++] = (PedacoSegmento){ x, y, cortes[c].x, cortes[c].y, origem };
+        x = cortes[c].x;
+        y = cortes[c].y;
+    }
+    saida[n++] = (PedacoSegmento){ x, y, s->x2, s->y2, origem };
+    return n;
+}
+
+int divideSegmentosCruzados(const SegmentoPlano* segs, int n, PedacoSegmento** pedacos) {
+    int* pares = NULL;
+    int k = encontraCruzamentos(segs, n, &pares);
+
+    // Cortes de cada segmento em forma compacta: os do segmento i em [inicio[i], inicio[i+1])
+    int* inicio = calloc(n + 1, sizeof(int));
+    Corte* cortes = malloc((2 * k + 1) * sizeof(Corte));
+    *pedacos = malloc((n + 2 * k + 1) * sizeof(PedacoSegmento));
+    if (inicio == NULL || cortes == NULL || *pedacos == NULL) {
+        printf("Erro de alocação para divisão de segmentos\n");
+        exit(1);
+    }
+
+    for (int p = 0; p < 2 * k; p++) inicio[pares[p] + 1]++;
+    for (int i = 0; i < n; i++) inicio[i + 1] += inicio[i];
+
+    int* pos = malloc((n + 1) * sizeof(int));
+    if (pos == NULL) {
+        printf("Erro de alocação para divisão de segmentos\n");
+        exit(1);
+    }
+    for (int i = 0; i < n; i++) pos[i] = inicio[i];
+
+    for (int p = 0; p < k; p++) {
+        int a = pares[2 * p];
+        int b = pares[2 * p + 1];
+        float x, y;
+        cruzamentoSegmentos(&segs[a], &segs[b], &x, &y);
+
+        cortes[pos[a]++] = (Corte){ parametroNoSegmento(&segs[a], x, y), x, y };
+        cortes[pos[b]++] = (Corte){ parametroNoSegmento(&segs[b], x, y), x, y };
+    }
+
+    int total = 0;
+    for (int i = 0; i < n; i++) {
+        int n_cortes = inicio[i + 1] - inicio[i];
+        cortes_quick_sort(&cortes[inicio[i]], n_cortes, SORT_LIMIAR_PADRAO);
+        total += escrevePedacos(&segs[i], &cortes[inicio[i]], n_cortes, i, *pedacos + total);
+    }
+
+    free(pares);
+    free(inicio);
+    free(pos);
+    free(cortes);
+    return total;
+}
+
+int divideSegmentoContra(const SegmentoPlano* alvo, const SegmentoPlano* outros, int m,
+                         int origem, PedacoSegmento** pedacos) {
+    int cap = 8, n_cortes = 0;
+    Corte* cortes = malloc(cap * sizeof(Corte));
+    if (cortes == NULL) {
+        printf("Erro de alocação para divisão de segmentos\n");
+        exit(1);
+    }
+
+    for (int j = 0; j < m; j++) {
+        float x, y;
+        if (!cruzamentoSegmentos(alvo, &outros[j], &x, &y)) continue;
+
+        if (n_cortes == cap) {
+            cap *= 2;
+            cortes = realloc(cortes, cap * sizeof(Corte));
+            if (cortes == NULL) {
+                printf("Erro de alocação para divisão de segmentos\n");
+                exit(1);
+            }
+        }
+        cortes[n_cortes++] = (Corte){ parametroNoSegmento(alvo, x, y), x, y };
+    }
+
+    cortes_quick_sort(cortes, n_cortes, SORT_LIMIAR_PADRAO);
+
+    *pedacos = malloc((n_cortes + 1) * sizeof(PedacoSegmento));
+    if (*pedacos == NULL) {
+        printf("Erro de alocação para divisão de segmentos\n");
+        exit(1);
+    }
+    int total = escrevePedacos(alvo, cortes, n_cortes, origem, *pedacos);
+
+    free(cortes);
+    return total;
+}
@@ -0,0 +1,98 @@
+#ifndef INTERSECAO_SEGMENTOS_H
+#define INTERSECAO_SEGMENTOS_H
+
+#include <stdbool.h>
+
+/**
+ * @file intersecao_segmentos.h
+ * @brief Divisão de segmentos nos pontos em que se cruzam (Bentley–Ottmann).
+ *
+ * A varredura angular de visibilidade supõe que os anteparos não se cruzam:
+ * só assim a ordem dos segmentos ativos por distância ao observador é a mesma
+ * em todos os raios. Este módulo encontra todos os cruzamentos próprios
+ * (interior com interior) com uma varredura por x em O((n + k) log n), onde k
+ * é o número de cruzamentos, e divide cada segmento nos seus cruzamentos.
+ *
+ * Segmentos que apenas se tocam (extremidade sobre outro segmento) ou que são
+ * colineares não são divididos: nenhum dos dois casos inverte a ordem por
+ * distância.
+ */
+
+/**
+ * @brief Segmento de entrada.
+ */
+typedef struct {
+    float x1, y1, x2, y2;
+} SegmentoPlano;
+
+/**
+ * @brief Pedaço de um segmento de entrada entre dois cruzamentos consecutivos
+ *        (ou extremidades).
+ *
+ * Os pedaços mantêm o sentido do segmento original: (x1, y1) é o lado mais
+ * próximo de (x1, y1) do original.
+ */
+typedef struct {
+    float x1, y1, x2, y2;
+    int origem;  ///< Índice do segmento de entrada
+} PedacoSegmento;
+
+/**
+ * @brief Calcula o cruzamento próprio de dois segmentos.
+ *
+ * O ponto é calculado sempre com os dois segmentos na mesma ordem (pelas
+ * coordenadas), então o resultado é idêntico bit a bit qualquer que seja a
+ * ordem dos argumentos. Os dois pedaços que se encontram num cruzamento têm
+ * assim exatamente a mesma extremidade.
+ *
+ * @param a Primeiro segmento.
+ * @param b Segundo segmento.
+ * @param px Saída: coordenada X do cruzamento.
+ * @param py Saída: coordenada Y do cruzamento.
+ * @return true se os interiores dos segmentos se cruzam em um único ponto.
+ */
+bool cruzamentoSegmentos(const SegmentoPlano* a, const SegmentoPlano* b, float* px, float* py);
+
+/**
+ * @brief Lista os pares de segmentos que se cruzam (Bentley–Ottmann).
+ *
+ * @param segs Segmentos de entrada.
+ * @param n Número de segmentos.
+ * @param pares Saída: array com 2 índices por cruzamento (alocado; liberar
+ *              com free). NULL se não houver cruzamentos.
+ * @return Número de cruzamentos encontrados.
+ */
+int encontraCruzamentos(const SegmentoPlano* segs, int n, int** pares);
+
+/**
+ * @brief Divide os segmentos nos pontos em que se cruzam.
+ *
+ * Os pedaços saem agrupados por segmento de entrada, na ordem da entrada, e
+ * dentro de cada grupo do início para o fim do segmento.
+ *
+ * @param segs Segmentos de entrada.
+ * @param n Número de segmentos.
+ * @param pedacos Saída: array de pedaços (alocado; liberar com free).
+ * @return Número de pedaços (n se não houver cruzamentos).
+ */
+int divideSegmentosCruzados(const SegmentoPlano* segs, int n, PedacoSegmento** pedacos);
+
+/**
+ * @brief Divide um segmento nos cruzamentos com uma lista de outros.
+ *
+ * Mesmo resultado que divideSegmentosCruzados() daria para `alvo`, mas
+ * testando contra cada segmento de `outros` (O(m)). Útil quando poucos
+ * segmentos mudam e os demais já estão divididos.
+ *
+ * @param alvo Segmento a dividir.
+ * @param outros Segmentos contra os quais testar (pode incluir o próprio alvo,
+ *               que é ignorado por não se cruzar consigo mesmo).
+ * @param m Número de segmentos em `outros`.
+ * @param origem Valor gravado em PedacoSegmento.origem.
+ * @param pedacos Saída: array de pedaços (alocado; liberar com free).
+ * @return Número de pedaços.
+ */
+int divideSegmentoContra(const SegmentoPlano* alvo, const SegmentoPlano* outros, int m,
+                         int origem, PedacoSegmento** pedacos);
+
+#endif
@@ -162,18 +162,46 @@ float calculoAreaLinha(LINHA l){
 
 void desalocaLinha(LINHA l){
 
+    desalocaCamposLinha(l);
+    free(l);
+
+}
+
+void desalocaCamposLinha(LINHA l){
+
     linha *lTemp = ((linha*)l);
 
     free(lTemp->cor);
-    free(lTemp);
 
 }
+
+size_t getTamanhoLinha(void){
+
+    return sizeof(linha);
+}
 LINHA clonaLinha(LINHA l, int novo_id, float dx, float dy){
+    linha *clone = (linha*) malloc(sizeof(linha));
+    if(clone == NULL){
+        printf("Erro na alocação de memória\n");
+        exit(1);
+    }
+    clonaLinhaEm(clone, l, novo_id, dx, dy);
+    return clone;
+}
+
+void clonaLinhaEm(void *destino, LINHA l, int novo_id, float dx, float dy){
     linha *lTemp = ((linha*)l);
-    return criaLinha(novo_id,
-                    lTemp->x1 + dx,
-                    lTemp->y1 + dy,
-                    lTemp->x2 + dx,
-                    lTemp->y2 + dy,
-                    lTemp->cor);
+    linha *clone = ((linha*)destino);
+
+    clone->id = novo_id;
+    clone->x1 = lTemp->x1 + dx;
+    clone->y1 = lTemp->y1 + dy;
+    clone->x2 = lTemp->x2 + dx;
+    clone->y2 = lTemp->y2 + dy;
+    clone->cor = (char*)malloc(sizeof(char) * strlen(lTemp->cor) +1);
+    if(clone->cor == NULL){
+        printf("Erro na alocação de memória\n");
+        exit(1);
+    }
+    strcpy(clone->cor, lTemp->cor);
 }
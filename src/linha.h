@@ -1,6 +1,8 @@
 #ifndef LINHA_H
 #define LINHA_H
 
+#include <stddef.h>
+
 /**
  * @file linha.h
  * @brief Interface para a estrutura de uma linha geométrica.
@@ -144,10 +146,40 @@ float calculoAreaLinha(LINHA l);
  */
 void desalocaLinha(LINHA l);
 
+/**
+ * @brief Libera a cor da linha, mas não a estrutura em si.
+ * 
+ * Usada quando a estrutura está embutida em outro bloco (ver criaForma()).
+ * 
+ * @param l Ponteiro para a linha.
+ */
+void desalocaCamposLinha(LINHA l);
+
+/**
+ * @brief Retorna o tamanho, em bytes, da estrutura de uma linha.
+ * 
+ * @return Tamanho da estrutura.
+ */
+size_t getTamanhoLinha(void);
+
 /**
  * @brief Cria um clone da linha com novo ID e deslocamento.
  */
 LINHA clonaLinha(LINHA l, int novo_id, float dx, float dy);
 
+/**
+ * @brief Escreve um clone da linha, com novo ID e deslocamento, na memória indicada.
+ * 
+ * Como clonaLinha(), mas sem alocar a estrutura: destino deve ter
+ * getTamanhoLinha() bytes, alinhados para qualquer tipo.
+ * 
+ * @param destino Memória que recebe o clone.
+ * @param l Ponteiro para a linha original.
+ * @param novo_id Novo ID para o clone.
+ * @param dx Deslocamento em X.
+ * @param dy Deslocamento em Y.
+ */
+void clonaLinhaEm(void *destino, LINHA l, int novo_id, float dx, float dy);
+
 #endif
 
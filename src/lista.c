@@ -173,7 +173,6 @@ bool searchAndRemoveLista(Lista lista, void* chave) {
 }
 
 void removeCelula(Lista lista, Celula alvo, bool liberarConteudo) {
-    (void)liberarConteudo; 
     if (alvo == NULL) return;
 
     // Atualizar ponteiro anterior
@@ -192,6 +191,8 @@ void removeCelula(Lista lista, Celula alvo, bool liberarConteudo) {
         ((stLista*)lista)->fim = ((stCelula*)alvo)->ant;
     }
     
+    if (liberarConteudo) free(((stCelula*)alvo)->chave);
+    free(alvo);
     ((stLista*)lista)->tam--;
 }
 
@@ -17,7 +17,7 @@
 int main(int argc, char *argv[]) {
 
     // Verifica se há argumentos demais
-    if (argc > 14) { 
+    if (argc > 18) { 
         printf("Erro, muitos argumentos!\n");
         exit(1);
     }
@@ -87,12 +87,24 @@ int main(int argc, char *argv[]) {
    
     int maior_id_geo = get_maior_id_geo(cidade);
 
+    // -ord hilbert mantém as formas na ordem da curva de Hilbert, para as bombas
+    // acharem as formas vizinhas juntas na memória; sem a opção ficam na ordem de inserção
+    char *ord_str = obter_valor_opcao(argc, argv, "ord");
+    if (ord_str != NULL) {
+        if (strcmp(ord_str, "hilbert") != 0) {
+            printf("Erro: -ord aceita apenas hilbert\n");
+            exit(1);
+        }
+        define_ordem_espacial_cidade(cidade, true);
+    }
+
     
     char *tipo_sort_str = obter_valor_opcao(argc, argv, "to");
     char *threshold_str = obter_valor_opcao(argc, argv, "i");
     
     char tipo_sort = 'q'; 
-    if (tipo_sort_str != NULL && (strcmp(tipo_sort_str, "m") == 0 || strcmp(tipo_sort_str, "q") == 0)) {
+    if (tipo_sort_str != NULL && (strcmp(tipo_sort_str, "m") == 0 || strcmp(tipo_sort_str, "q") == 0 ||
+                                 strcmp(tipo_sort_str, "p") == 0 || strcmp(tipo_sort_str, "r") == 0)) {
         tipo_sort = tipo_sort_str[0];
     }
     
@@ -101,6 +113,24 @@ int main(int argc, char *argv[]) {
         threshold = atoi(threshold_str);
     }
 
+    // -vis approx:N aproxima a visibilidade com N raios; sem a opção (ou -vis exact) é exata
+    char *vis_str = obter_valor_opcao(argc, argv, "vis");
+    int n_raios_vis = 0;
+    if (vis_str != NULL && strcmp(vis_str, "exact") != 0) {
+        char *fim = NULL;
+        if (strncmp(vis_str, "approx:", 7) == 0) {
+            n_raios_vis = (int)strtol(vis_str + 7, &fim, 10);
+        }
+        if (fim == NULL || fim == vis_str + 7 || *fim != '\0') {
+            printf("Erro: -vis aceita apenas exact ou approx:N\n");
+            exit(1);
+        }
+        if (n_raios_vis < 3) {
+            printf("Erro: -vis approx:N precisa de N >= 3\n");
+            exit(1);
+        }
+    }
+
     
     if (caminho_qry != NULL) {
         DadosDoArquivo arqQry = criar_dados_arquivo(caminho_qry);
@@ -113,7 +143,8 @@ int main(int argc, char *argv[]) {
 
         printf("\n=== Processando arquivo QRY ===\n");
         
-        Qry qry = executa_comando_qry(arqQry, cidade, caminho_output, maior_id_geo, tipo_sort, threshold);
+        Qry qry = executa_comando_qry(arqQry, cidade, caminho_output, maior_id_geo, tipo_sort, threshold,
+                                      n_raios_vis);
         printf("=== Processamento QRY concluído ===\n\n");
 
         destruir_dados_arquivo(arqQry);
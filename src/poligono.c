@@ -12,6 +12,9 @@
 
 #define EPSILON 1e-9
 
+// Abaixo disso formaIntersectaPoligono percorre as arestas direto, sem grade
+#define GRADE_MIN_VERTICES 64
+
 
 
 typedef struct {
@@ -31,11 +34,30 @@ typedef struct {
     float max_y;
 } stBoundingBox;
 
+// Grade uniforme sobre o bounding box do polígono. Cada célula guarda as arestas
+// que passam por ela (formato CSR) e se o seu centro está dentro do polígono.
+typedef struct {
+    float min_x, min_y, max_x, max_y;
+    float cel_w, cel_h;
+    int nx, ny;
+    int* inicio;            // nx*ny + 1 posições em 'arestas'
+    int* arestas;           // Índices das arestas de cada célula
+    unsigned char* dentro;  // Centro da célula dentro do polígono?
+    int* marca;             // Por aresta: último carimbo em que foi coletada
+    int carimbo;
+    int* candidatas;        // Arestas coletadas na última consulta
+} stGrade;
+
 typedef struct {
-    Lista vertices;   // Lista de stPonto*
-    Lista segmentos;  // Lista de stSegmento*
+    stPonto* vertices;  // Buffer contíguo de vértices, na ordem de inserção
+    int n_vertices;
+    int capacidade;
+    Vetor segmentos;    // Vetor de stSegmento*
+    stGrade* grade;     // Construída no primeiro uso; descartada ao inserir vértices
 } stPoligono;
 
+static void liberaGrade(stPoligono* p);
+
 
 
 
@@ -118,8 +140,36 @@ Poligono criaPoligono() {
     stPoligono* p = malloc(sizeof(stPoligono));
     if (!p) return NULL;
     
-    p->vertices = criaLista();
-    p->segmentos = criaLista();
+    p->vertices = NULL;
+    p->n_vertices = 0;
+    p->capacidade = 0;
+    p->segmentos = criaVetor(0);
+    p->grade = NULL;
+    
+    return p;
+}
+
+Poligono criaPoligonoCapacidade(int capacidade) {
+    Poligono p = criaPoligono();
+    reservaVertices(p, capacidade);
+    return p;
+}
+
+Poligono copiaPoligono(Poligono pol) {
+    if (!pol) return NULL;
+    
+    stPoligono* orig = (stPoligono*)pol;
+    stPoligono* p = criaPoligonoCapacidade(orig->n_vertices);
+    if (!p) return NULL;
+    
+    if (orig->n_vertices > 0) {
+        memcpy(p->vertices, orig->vertices, orig->n_vertices * sizeof(stPonto));
+        p->n_vertices = orig->n_vertices;
+    }
+    
+    for (int i = 0; i < getTamanhoVetor(orig->segmentos); i++) {
+        insereSegmento(p, getElementoVetor(orig->segmentos, i));
+    }
     
     return p;
 }
@@ -129,39 +179,53 @@ void liberaPoligono(Poligono pol) {
     
     stPoligono* p = (stPoligono*)pol;
     
-    while (!listaVazia(p->vertices)) {
-        Ponto* ponto = removeInicioLista(p->vertices);
-        free(ponto);
-    }
-    liberaLista(p->vertices);
+    free(p->vertices);
+    liberaGrade(p);
     
-    
-    while (!listaVazia(p->segmentos)) {
-        Segmento* seg = removeInicioLista(p->segmentos);
-        free(seg);
+    while (!vetorVazio(p->segmentos)) {
+        free(removeFinalVetor(p->segmentos));
     }
-    liberaLista(p->segmentos);
+    liberaVetor(p->segmentos);
     
     free(p);
 }
 
 
 
-
-
-void insereVertice(Poligono pol, Ponto ponto) {
-    if (!pol || !ponto) return;
+void reservaVertices(Poligono pol, int capacidade) {
+    if (!pol) return;
     
     stPoligono* p = (stPoligono*)pol;
-    stPonto* pt = (stPonto*)ponto;
+    if (capacidade <= p->capacidade) return;
     
-    stPonto* novo = malloc(sizeof(stPonto));
+    stPonto* novo = realloc(p->vertices, capacidade * sizeof(stPonto));
     if (!novo) return;
     
-    novo->x = pt->x;
-    novo->y = pt->y;
+    p->vertices = novo;
+    p->capacidade = capacidade;
+}
+
+void insereVerticeXY(Poligono pol, float x, float y) {
+    if (!pol) return;
     
-    insereFinalLista(p->vertices, novo);
+    stPoligono* p = (stPoligono*)pol;
+    
+    if (p->n_vertices == p->capacidade) {
+        reservaVertices(p, p->capacidade > 0 ? 2 * p->capacidade : 16);
+        if (p->n_vertices == p->capacidade) return;
+    }
+    
+    p->vertices[p->n_vertices].x = x;
+    p->vertices[p->n_vertices].y = y;
+    p->n_vertices++;
+    liberaGrade(p);
+}
+
+void insereVertice(Poligono pol, Ponto ponto) {
+    if (!pol || !ponto) return;
+    
+    stPonto* pt = (stPonto*)ponto;
+    insereVerticeXY(pol, pt->x, pt->y);
 }
 
 void insereSegmento(Poligono pol, Segmento seg) {
@@ -176,7 +240,7 @@ void insereSegmento(Poligono pol, Segmento seg) {
     novo->p1 = s->p1;
     novo->p2 = s->p2;
     
-    insereFinalLista(p->segmentos, novo);
+    insereFinalVetor(p->segmentos, novo);
 }
 
 
@@ -187,15 +251,11 @@ BoundingBox getBoundingBox(Poligono pol) {
     
     stPoligono* p = (stPoligono*)pol;
     
-    if (listaVazia(p->vertices)) {
-        return criaBoundingBox(INFINITY, INFINITY, -INFINITY, -INFINITY);
-    }
-    
     float min_x = INFINITY, min_y = INFINITY;
     float max_x = -INFINITY, max_y = -INFINITY;
     
-    for (Celula c = getInicioLista(p->vertices); c; c = getProxCelula(c)) {
-        stPonto* ponto = (stPonto*)getConteudoCelula(c);
+    for (int i = 0; i < p->n_vertices; i++) {
+        stPonto* ponto = &p->vertices[i];
         
         if (ponto->x < min_x) min_x = ponto->x;
         if (ponto->x > max_x) max_x = ponto->x;
@@ -206,60 +266,55 @@ BoundingBox getBoundingBox(Poligono pol) {
     return criaBoundingBox(min_x, min_y, max_x, max_y);
 }
 
-bool isInside(Poligono pol, Ponto ponto) {
-    if (!pol || !ponto) return false;
+bool isInsideXY(Poligono pol, float x, float y) {
+    if (!pol) return false;
     
     stPoligono* p = (stPoligono*)pol;
-    stPonto* pt = (stPonto*)ponto;
-    
-    if (listaVazia(p->vertices)) return false;
-    
-    
-    int num_vertices = getTamanhoLista(p->vertices);
-    if (num_vertices < 3) return false;
+    int n = p->n_vertices;
+    if (n < 3) return false;
     
     int interseccoes = 0;
     
-    Celula c1 = getInicioLista(p->vertices);
-    Celula c2 = getProxCelula(c1);
-    
-    while (c2) {
-        stPonto* p1 = (stPonto*)getConteudoCelula(c1);
-        stPonto* p2 = (stPonto*)getConteudoCelula(c2);
+    // Aresta (j, i) percorre todas as arestas, inclusive a que fecha o polígono
+    for (int i = 0, j = n - 1; i < n; j = i++) {
+        stPonto* p1 = &p->vertices[j];
+        stPonto* p2 = &p->vertices[i];
         
         // Verifica se o raio horizontal cruza esta aresta
-        if (((p1->y > pt->y) != (p2->y > pt->y)) &&
-            (pt->x < (p2->x - p1->x) * (pt->y - p1->y) / (p2->y - p1->y) + p1->x)) {
+        if (((p1->y > y) != (p2->y > y)) &&
+            (x < (p2->x - p1->x) * (y - p1->y) / (p2->y - p1->y) + p1->x)) {
             interseccoes++;
         }
-        
-        c1 = c2;
-        c2 = getProxCelula(c2);
-    }
-    
-   
-    stPonto* p_ultimo = (stPonto*)getConteudoCelula(c1);
-    stPonto* p_primeiro = (stPonto*)getConteudoCelula(getInicioLista(p->vertices));
-    
-    if (((p_ultimo->y > pt->y) != (p_primeiro->y > pt->y)) &&
-        (pt->x < (p_primeiro->x - p_ultimo->x) * (pt->y - p_ultimo->y) / 
-                   (p_primeiro->y - p_ultimo->y) + p_ultimo->x)) {
-        interseccoes++;
     }
     
     // Se número de interseções é ímpar, o ponto está dentro
     return (interseccoes % 2) == 1;
 }
 
-Lista getVertices(Poligono pol) {
+bool isInside(Poligono pol, Ponto ponto) {
+    if (!pol || !ponto) return false;
+    
+    stPonto* pt = (stPonto*)ponto;
+    return isInsideXY(pol, pt->x, pt->y);
+}
 
-    if (!pol) return NULL;
+float getXVertice(Poligono pol, int i) {
+    if (!pol) return 0.0f;
     
     stPoligono* p = (stPoligono*)pol;
-    return p->vertices;
+    if (i < 0 || i >= p->n_vertices) return 0.0f;
+    return p->vertices[i].x;
 }
 
-Lista getSegmentos(Poligono pol) {
+float getYVertice(Poligono pol, int i) {
+    if (!pol) return 0.0f;
+    
+    stPoligono* p = (stPoligono*)pol;
+    if (i < 0 || i >= p->n_vertices) return 0.0f;
+    return p->vertices[i].y;
+}
+
+Vetor getSegmentos(Poligono pol) {
     if (!pol) return NULL;
     
     stPoligono* p = (stPoligono*)pol;
@@ -270,14 +325,279 @@ int getNumVertices(Poligono pol) {
     if (!pol) return 0;
     
     stPoligono* p = (stPoligono*)pol;
-    return getTamanhoLista(p->vertices);
+    return p->n_vertices;
 }
 
 int getNumSegmentos(Poligono pol) {
     if (!pol) return 0;
     
     stPoligono* p = (stPoligono*)pol;
-    return getTamanhoLista(p->segmentos);
+    return getTamanhoVetor(p->segmentos);
+}
+
+/* ================= Grade de arestas ================= */
+
+static void liberaGrade(stPoligono* p) {
+    if (!p->grade) return;
+    
+    stGrade* g = p->grade;
+    free(g->inicio);
+    free(g->arestas);
+    free(g->dentro);
+    free(g->marca);
+    free(g->candidatas);
+    free(g);
+    p->grade = NULL;
+}
+
+static int colunaGrade(stGrade* g, float x) {
+    int c = (int)((x - g->min_x) / g->cel_w);
+    if (c < 0) return 0;
+    if (c >= g->nx) return g->nx - 1;
+    return c;
+}
+
+static int linhaGrade(stGrade* g, float y) {
+    int r = (int)((y - g->min_y) / g->cel_h);
+    if (r < 0) return 0;
+    if (r >= g->ny) return g->ny - 1;
+    return r;
+}
+
+// Percorre as células tocadas pela aresta k, linha a linha, recortando a aresta
+// na faixa de cada linha. Com 'destino' nulo só conta; senão preenche o CSR.
+static void distribuiAresta(stPoligono* p, stGrade* g, int k, int* contagem, int* destino) {
+    stPonto a = p->vertices[k];
+    stPonto b = p->vertices[(k + 1) % p->n_vertices];
+    
+    float ylo = fmin(a.y, b.y), yhi = fmax(a.y, b.y);
+    int r0 = linhaGrade(g, ylo), r1 = linhaGrade(g, yhi);
+    
+    for (int r = r0; r <= r1; r++) {
+        float xmin, xmax;
+        if (a.y == b.y) {
+            xmin = fmin(a.x, b.x);
+            xmax = fmax(a.x, b.x);
+        } else {
+            float y0 = fmax(ylo, g->min_y + r * g->cel_h);
+            float y1 = fmin(yhi, g->min_y + (r + 1) * g->cel_h);
+            float xa = a.x + (y0 - a.y) * (b.x - a.x) / (b.y - a.y);
+            float xb = a.x + (y1 - a.y) * (b.x - a.x) / (b.y - a.y);
+            xmin = fmin(xa, xb);
+            xmax = fmax(xa, xb);
+        }
+        
+        int c0 = colunaGrade(g, xmin), c1 = colunaGrade(g, xmax);
+        for (int c = c0; c <= c1; c++) {
+            int cel = r * g->nx + c;
+            if (destino) destino[contagem[cel]++] = k;
+            else contagem[cel]++;
+        }
+    }
+}
+
+static int cmpFloat(const void* a, const void* b) {
+    float fa = *(const float*)a, fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+// Marca o centro de cada célula como dentro/fora: por linha, um raio horizontal
+// na altura dos centros, com a mesma regra de cruzamento de isInsideXY
+static bool marcaCelulasDentro(stPoligono* p, stGrade* g) {
+    int n = p->n_vertices;
+    float* xs = malloc(n * sizeof(float));
+    if (!xs) return false;
+    
+    for (int r = 0; r < g->ny; r++) {
+        float yc = g->min_y + (r + 0.5f) * g->cel_h;
+        int m = 0;
+        
+        for (int i = 0, j = n - 1; i < n; j = i++) {
+            stPonto* p1 = &p->vertices[j];
+            stPonto* p2 = &p->vertices[i];
+            if ((p1->y > yc) != (p2->y > yc)) {
+                xs[m++] = (p2->x - p1->x) * (yc - p1->y) / (p2->y - p1->y) + p1->x;
+            }
+        }
+        qsort(xs, m, sizeof(float), cmpFloat);
+        
+        // Cruzamentos à direita do centro: ímpar = dentro
+        int k = 0;
+        for (int c = 0; c < g->nx; c++) {
+            float xc = g->min_x + (c + 0.5f) * g->cel_w;
+            while (k < m && xs[k] <= xc) k++;
+            g->dentro[r * g->nx + c] = ((m - k) % 2) == 1;
+        }
+    }
+    
+    free(xs);
+    return true;
+}
+
+static stGrade* garanteGrade(stPoligono* p) {
+    if (p->grade) return p->grade;
+    
+    int n = p->n_vertices;
+    stGrade* g = calloc(1, sizeof(stGrade));
+    if (!g) return NULL;
+    
+    g->min_x = g->max_x = p->vertices[0].x;
+    g->min_y = g->max_y = p->vertices[0].y;
+    for (int i = 1; i < n; i++) {
+        g->min_x = fmin(g->min_x, p->vertices[i].x);
+        g->max_x = fmax(g->max_x, p->vertices[i].x);
+        g->min_y = fmin(g->min_y, p->vertices[i].y);
+        g->max_y = fmax(g->max_y, p->vertices[i].y);
+    }
+    
+    // Por volta de uma célula por aresta, respeitando a proporção do bounding box
+    float w = fmax(g->max_x - g->min_x, 1e-3f);
+    float h = fmax(g->max_y - g->min_y, 1e-3f);
+    g->nx = (int)ceil(sqrt(n * w / h));
+    g->ny = (int)ceil(sqrt(n * h / w));
+    if (g->nx < 1) g->nx = 1;
+    if (g->ny < 1) g->ny = 1;
+    if (g->nx > 1024) g->nx = 1024;
+    if (g->ny > 1024) g->ny = 1024;
+    g->cel_w = w / g->nx;
+    g->cel_h = h / g->ny;
+    
+    int n_cel = g->nx * g->ny;
+    g->inicio = calloc(n_cel + 1, sizeof(int));
+    g->dentro = malloc(n_cel);
+    g->marca = calloc(n, sizeof(int));
+    g->candidatas = malloc(n * sizeof(int));
+    p->grade = g;
+    if (!g->inicio || !g->dentro || !g->marca || !g->candidatas) {
+        liberaGrade(p);
+        return NULL;
+    }
+    
+    // Contagem por célula, prefixo e preenchimento
+    int* pos = calloc(n_cel, sizeof(int));
+    if (!pos) {
+        liberaGrade(p);
+        return NULL;
+    }
+    for (int k = 0; k < n; k++) distribuiAresta(p, g, k, pos, NULL);
+    for (int c = 0; c < n_cel; c++) {
+        g->inicio[c + 1] = g->inicio[c] + pos[c];
+        pos[c] = g->inicio[c];
+    }
+    g->arestas = malloc((g->inicio[n_cel] > 0 ? g->inicio[n_cel] : 1) * sizeof(int));
+    if (!g->arestas) {
+        free(pos);
+        liberaGrade(p);
+        return NULL;
+    }
+    for (int k = 0; k < n; k++) distribuiAresta(p, g, k, pos, g->arestas);
+    free(pos);
+    
+    if (!marcaCelulasDentro(p, g)) {
+        liberaGrade(p);
+        return NULL;
+    }
+    return g;
+}
+
+static bool segmentosIntersectam(float x1, float y1, float x2, float y2,
+                                  float x3, float y3, float x4, float y4);
+
+// Ponto dentro do polígono: parte do estado conhecido do centro da célula e
+// inverte a cada aresta da célula cruzada no caminho até o ponto
+static bool dentroGrade(stPoligono* p, stGrade* g, float x, float y) {
+    if (x < g->min_x || x > g->max_x || y < g->min_y || y > g->max_y) return false;
+    
+    int r = linhaGrade(g, y), c = colunaGrade(g, x);
+    int cel = r * g->nx + c;
+    float xc = g->min_x + (c + 0.5f) * g->cel_w;
+    float yc = g->min_y + (r + 0.5f) * g->cel_h;
+    
+    bool dentro = g->dentro[cel];
+    for (int t = g->inicio[cel]; t < g->inicio[cel + 1]; t++) {
+        int k = g->arestas[t];
+        stPonto a = p->vertices[k];
+        stPonto b = p->vertices[(k + 1) % p->n_vertices];
+        if (segmentosIntersectam(xc, yc, x, y, a.x, a.y, b.x, b.y)) dentro = !dentro;
+    }
+    return dentro;
+}
+
+// Coleta, sem repetição, as arestas das células que o retângulo dado cobre
+static int coletaArestas(stGrade* g, float x0, float y0, float x1, float y1) {
+    if (x1 < g->min_x || x0 > g->max_x || y1 < g->min_y || y0 > g->max_y) return 0;
+    
+    g->carimbo++;
+    int total = 0;
+    int c0 = colunaGrade(g, x0), c1 = colunaGrade(g, x1);
+    int r0 = linhaGrade(g, y0), r1 = linhaGrade(g, y1);
+    
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            int cel = r * g->nx + c;
+            for (int t = g->inicio[cel]; t < g->inicio[cel + 1]; t++) {
+                int k = g->arestas[t];
+                if (g->marca[k] == g->carimbo) continue;
+                g->marca[k] = g->carimbo;
+                g->candidatas[total++] = k;
+            }
+        }
+    }
+    return total;
+}
+
+// Coleta, sem repetição, as arestas das células por onde o segmento passa ou
+// que ficam a até TOLERANCIA_CONTATO dele. Mesmo recorte por linha de
+// distribuiAresta, com a faixa de cada linha alargada pela tolerância e por
+// uma fração de célula para o arredondamento não perder vizinhas
+static int coletaArestasSegmento(stGrade* g, float x1, float y1, float x2, float y2) {
+    float tol = TOLERANCIA_CONTATO;
+    if (fmax(x1, x2) + tol < g->min_x || fmin(x1, x2) - tol > g->max_x ||
+        fmax(y1, y2) + tol < g->min_y || fmin(y1, y2) - tol > g->max_y) return 0;
+    
+    g->carimbo++;
+    int total = 0;
+    float folga = fmax(1e-3f * g->cel_w, tol);
+    float ylo = fmin(y1, y2), yhi = fmax(y1, y2);
+    int r0 = linhaGrade(g, ylo - tol), r1 = linhaGrade(g, yhi + tol);
+    
+    for (int r = r0; r <= r1; r++) {
+        float xmin, xmax;
+        if (y1 == y2) {
+            xmin = fmin(x1, x2);
+            xmax = fmax(x1, x2);
+        } else {
+            float ya = fmax(ylo, g->min_y + r * g->cel_h - tol);
+            float yb = fmin(yhi, g->min_y + (r + 1) * g->cel_h + tol);
+            float xa = x1 + (ya - y1) * (x2 - x1) / (y2 - y1);
+            float xb = x1 + (yb - y1) * (x2 - x1) / (y2 - y1);
+            xmin = fmin(xa, xb);
+            xmax = fmax(xa, xb);
+        }
+        
+        int c0 = colunaGrade(g, xmin - folga), c1 = colunaGrade(g, xmax + folga);
+        for (int c = c0; c <= c1; c++) {
+            int cel = r * g->nx + c;
+            for (int t = g->inicio[cel]; t < g->inicio[cel + 1]; t++) {
+                int k = g->arestas[t];
+                if (g->marca[k] == g->carimbo) continue;
+                g->marca[k] = g->carimbo;
+                g->candidatas[total++] = k;
+            }
+        }
+    }
+    return total;
+}
+
+static bool segmentoCruzaGrade(stPoligono* p, stGrade* g, float x1, float y1, float x2, float y2) {
+    int m = coletaArestasSegmento(g, x1, y1, x2, y2);
+    for (int i = 0; i < m; i++) {
+        int k = g->candidatas[i];
+        stPonto a = p->vertices[k];
+        stPonto b = p->vertices[(k + 1) % p->n_vertices];
+        if (segmentosSeTocam(x1, y1, x2, y2, a.x, a.y, b.x, b.y)) return true;
+    }
+    return false;
 }
 
 bool haInterseccaoBB(BoundingBox a, BoundingBox b) {
@@ -330,27 +650,171 @@ static float distanciaPontoSegmento(float px, float py, float x1, float y1, floa
     return sqrt(dx*dx + dy*dy);
 }
 
-bool formaIntersectaPoligono(Poligono p, Forma f) {
-    if (!p || !f) return false;
+bool segmentosSeTocam(float x1, float y1, float x2, float y2,
+                      float x3, float y3, float x4, float y4) {
+    float tol = TOLERANCIA_CONTATO;
+    
+    // Caixas afastadas por mais que a tolerância: nem cruzam nem encostam
+    if (fmax(x1, x2) + tol < fmin(x3, x4) || fmin(x1, x2) - tol > fmax(x3, x4) ||
+        fmax(y1, y2) + tol < fmin(y3, y4) || fmin(y1, y2) - tol > fmax(y3, y4)) {
+        return false;
+    }
+    
+    if (segmentosIntersectam(x1, y1, x2, y2, x3, y3, x4, y4)) return true;
+    
+    // Sem cruzamento próprio, a menor distância entre os dois sai de algum extremo
+    return distanciaPontoSegmento(x1, y1, x3, y3, x4, y4) <= tol ||
+           distanciaPontoSegmento(x2, y2, x3, y3, x4, y4) <= tol ||
+           distanciaPontoSegmento(x3, y3, x1, y1, x2, y2) <= tol ||
+           distanciaPontoSegmento(x4, y4, x1, y1, x2, y2) <= tol;
+}
+
+// Algum lado do polígono cruza ou encosta no segmento (x1,y1)-(x2,y2)?
+static bool arestaCruzaSegmento(stPoligono* p, float x1, float y1, float x2, float y2) {
+    int n = p->n_vertices;
+    for (int i = 0, j = n - 1; i < n; j = i++) {
+        if (segmentosSeTocam(x1, y1, x2, y2,
+                             p->vertices[j].x, p->vertices[j].y,
+                             p->vertices[i].x, p->vertices[i].y)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Texto é tratado como um segmento horizontal de 10 unidades por caractere
+static void segmentoTexto(TEXTO t, float* x1, float* y1, float* x2, float* y2) {
+    float tx = getXTexto(t);
+    float ty = getYTexto(t);
+    char anc = getAncoraTexto(t);
+    float L = 10.0f * strlen(getTxtTexto(t));
+    
+    if (anc == 'i' || anc == 'I') {
+        *x1 = tx;
+        *x2 = tx + L;
+    } else if (anc == 'f' || anc == 'F') {
+        *x1 = tx - L;
+        *x2 = tx;
+    } else {
+        *x1 = tx - L/2;
+        *x2 = tx + L/2;
+    }
+    *y1 = ty;
+    *y2 = ty;
+}
+
+// Mesmos testes de formaIntersectaPoligono, olhando só as arestas das células
+// que o bounding box da forma cobre
+static bool formaIntersectaGrade(stPoligono* p, stGrade* g, Forma f) {
+    void* data = getDataForma(f);
+    float x1, y1, x2, y2;
+    
+    switch (getTipoForma(f)) {
+        case LINE:
+            x1 = getX1Linha(data); y1 = getY1Linha(data);
+            x2 = getX2Linha(data); y2 = getY2Linha(data);
+            break;
+            
+        case ANTEPARO:
+            x1 = getX1Anteparo(data); y1 = getY1Anteparo(data);
+            x2 = getX2Anteparo(data); y2 = getY2Anteparo(data);
+            break;
+            
+        case TEXT:
+            segmentoTexto((TEXTO)data, &x1, &y1, &x2, &y2);
+            break;
+            
+        case RECTANGLE: {
+            float rx = getXRetangulo(data);
+            float ry = getYRetangulo(data);
+            float w = getLarguraRetangulo(data);
+            float h = getAlturaRetangulo(data);
+            float vx[4] = {rx, rx+w, rx+w, rx};
+            float vy[4] = {ry, ry, ry+h, ry+h};
+            
+            for (int i = 0; i < 4; i++) {
+                if (dentroGrade(p, g, vx[i], vy[i])) return true;
+            }
+            
+            // Vértice do polígono dentro do retângulo ou aresta cruzando um lado
+            float tol = TOLERANCIA_CONTATO;
+            int m = coletaArestas(g, rx - tol, ry - tol, rx + w + tol, ry + h + tol);
+            for (int i = 0; i < m; i++) {
+                int k = g->candidatas[i];
+                stPonto a = p->vertices[k];
+                stPonto b = p->vertices[(k + 1) % p->n_vertices];
+                
+                if (a.x >= rx && a.x <= rx+w && a.y >= ry && a.y <= ry+h) return true;
+                for (int j = 0; j < 4; j++) {
+                    int l = (j + 1) % 4;
+                    if (segmentosSeTocam(a.x, a.y, b.x, b.y, vx[j], vy[j], vx[l], vy[l])) return true;
+                }
+            }
+            return false;
+        }
+        
+        case CIRCLE: {
+            float cx = getXCirculo(data);
+            float cy = getYCirculo(data);
+            float r = getRaioCirculo(data);
+            
+            if (dentroGrade(p, g, cx, cy)) return true;
+            
+            int m = coletaArestas(g, cx - r, cy - r, cx + r, cy + r);
+            for (int i = 0; i < m; i++) {
+                int k = g->candidatas[i];
+                stPonto a = p->vertices[k];
+                stPonto b = p->vertices[(k + 1) % p->n_vertices];
+                if (distanciaPontoSegmento(cx, cy, a.x, a.y, b.x, b.y) <= r) return true;
+            }
+            return false;
+        }
+        
+        default:
+            return false;
+    }
+    
+    // Formas de segmento: extremidade dentro ou cruzamento com alguma aresta
+    if (dentroGrade(p, g, x1, y1) || dentroGrade(p, g, x2, y2)) return true;
+    return segmentoCruzaGrade(p, g, x1, y1, x2, y2);
+}
+
+bool formaIntersectaPoligono(Poligono pol, Forma f) {
+    if (!pol || !f) return false;
     
+    stPoligono* p = (stPoligono*)pol;
     tipo_forma tipo = getTipoForma(f);
     void* data = getDataForma(f);
     
+    // Polígonos grandes: grade de arestas construída no primeiro uso
+    if (p->n_vertices >= GRADE_MIN_VERTICES) {
+        stGrade* g = garanteGrade(p);
+        if (g) {
+            BoundingBox bb_forma = getBBForma(f);
+            float tol = TOLERANCIA_CONTATO;
+            bool perto = bb_forma && !(getBBMaxX(bb_forma) + tol < g->min_x || getBBMinX(bb_forma) - tol > g->max_x ||
+                                       getBBMaxY(bb_forma) + tol < g->min_y || getBBMinY(bb_forma) - tol > g->max_y);
+            liberaBoundingBox(bb_forma);
+            return perto && formaIntersectaGrade(p, g, f);
+        }
+    }
+    
    
     BoundingBox bb_forma = getBBForma(f);
     BoundingBox bb_poly = getBoundingBox(p);
     
-    if (!haInterseccaoBB(bb_forma, bb_poly)) {
-        liberaBoundingBox(bb_forma);
-        liberaBoundingBox(bb_poly);
-        return false;
-    }
+    // Bounding boxes com a folga do contato: formas rentes à fronteira passam
+    float tol = TOLERANCIA_CONTATO;
+    bool perto = bb_forma && bb_poly &&
+                 !(getBBMaxX(bb_forma) + tol < getBBMinX(bb_poly) || getBBMinX(bb_forma) - tol > getBBMaxX(bb_poly) ||
+                   getBBMaxY(bb_forma) + tol < getBBMinY(bb_poly) || getBBMinY(bb_forma) - tol > getBBMaxY(bb_poly));
     
     liberaBoundingBox(bb_forma);
     liberaBoundingBox(bb_poly);
+    if (!perto) return false;
     
-    // Obtém vértices do polígono
-    Lista vertices_poly = getVertices(p);
+    int n = p->n_vertices;
+    if (n == 0) return false;
     
     switch(tipo) {
         case LINE: {
@@ -361,43 +825,12 @@ bool formaIntersectaPoligono(Poligono p, Forma f) {
             float y2 = getY2Linha(l);
             
             // Verifica se extremidades estão dentro do polígono
-            Ponto p1 = criaPonto(x1, y1);
-            Ponto p2 = criaPonto(x2, y2);
-            
-            if (isInside(p, p1) || isInside(p, p2)) {
-                liberaPonto(p1);
-                liberaPonto(p2);
+            if (isInsideXY(p, x1, y1) || isInsideXY(p, x2, y2)) {
                 return true;
             }
-            liberaPonto(p1);
-            liberaPonto(p2);
             
             // Verifica interseção com arestas do polígono
-            Celula c = getInicioLista(vertices_poly);
-            if (!c) return false;
-            
-            Ponto v_first = (Ponto)getConteudoCelula(c);
-            Ponto v_prev = v_first;
-            
-            for (c = getProxCelula(c); c; c = getProxCelula(c)) {
-                Ponto v_curr = (Ponto)getConteudoCelula(c);
-                
-                if (segmentosIntersectam(x1, y1, x2, y2,
-                                        getPontoX(v_prev), getPontoY(v_prev),
-                                        getPontoX(v_curr), getPontoY(v_curr))) {
-                    return true;
-                }
-                v_prev = v_curr;
-            }
-            
-            
-            if (segmentosIntersectam(x1, y1, x2, y2,
-                                    getPontoX(v_prev), getPontoY(v_prev),
-                                    getPontoX(v_first), getPontoY(v_first))) {
-                return true;
-            }
-            
-            return false;
+            return arestaCruzaSegmento(p, x1, y1, x2, y2);
         }
         
         case RECTANGLE: {
@@ -413,58 +846,25 @@ bool formaIntersectaPoligono(Poligono p, Forma f) {
             
             // Verifica se algum vértice do retângulo está dentro do polígono
             for (int i = 0; i < 4; i++) {
-                Ponto pt = criaPonto(vx[i], vy[i]);
-                if (isInside(p, pt)) {
-                    liberaPonto(pt);
+                if (isInsideXY(p, vx[i], vy[i])) {
                     return true;
                 }
-                liberaPonto(pt);
             }
             
             // Verifica se algum vértice do polígono está dentro do retângulo
-            for (Celula c = getInicioLista(vertices_poly); c; c = getProxCelula(c)) {
-                Ponto v = (Ponto)getConteudoCelula(c);
-                float vx_p = getPontoX(v);
-                float vy_p = getPontoY(v);
+            for (int i = 0; i < n; i++) {
+                float vx_p = p->vertices[i].x;
+                float vy_p = p->vertices[i].y;
                 
                 if (vx_p >= rx && vx_p <= rx+w && vy_p >= ry && vy_p <= ry+h) {
                     return true;
                 }
             }
             
-            // Verifica interseção de arestas
-            Celula c = getInicioLista(vertices_poly);
-            if (!c) return false;
-            
-            Ponto v_first = (Ponto)getConteudoCelula(c);
-            Ponto v_prev = v_first;
-            
-            for (c = getProxCelula(c); c; c = getProxCelula(c)) {
-                Ponto v_curr = (Ponto)getConteudoCelula(c);
-                float px1 = getPontoX(v_prev);
-                float py1 = getPontoY(v_prev);
-                float px2 = getPontoX(v_curr);
-                float py2 = getPontoY(v_curr);
-                
-                // Testa interseção com cada aresta do retângulo
-                for (int i = 0; i < 4; i++) {
-                    int j = (i + 1) % 4;
-                    if (segmentosIntersectam(px1, py1, px2, py2, vx[i], vy[i], vx[j], vy[j])) {
-                        return true;
-                    }
-                }
-                v_prev = v_curr;
-            }
-            
-            // Fecha o polígono
-            float px1 = getPontoX(v_prev);
-            float py1 = getPontoY(v_prev);
-            float px2 = getPontoX(v_first);
-            float py2 = getPontoY(v_first);
-            
+            // Verifica interseção de arestas com cada aresta do retângulo
             for (int i = 0; i < 4; i++) {
                 int j = (i + 1) % 4;
-                if (segmentosIntersectam(px1, py1, px2, py2, vx[i], vy[i], vx[j], vy[j])) {
+                if (arestaCruzaSegmento(p, vx[i], vy[i], vx[j], vy[j])) {
                     return true;
                 }
             }
@@ -479,18 +879,14 @@ bool formaIntersectaPoligono(Poligono p, Forma f) {
             float r = getRaioCirculo(circ);
             
             // Verifica se o centro está dentro do polígono
-            Ponto centro = criaPonto(cx, cy);
-            if (isInside(p, centro)) {
-                liberaPonto(centro);
+            if (isInsideXY(p, cx, cy)) {
                 return true;
             }
-            liberaPonto(centro);
             
             // Verifica se algum vértice do polígono está dentro do círculo
-            for (Celula c = getInicioLista(vertices_poly); c; c = getProxCelula(c)) {
-                Ponto v = (Ponto)getConteudoCelula(c);
-                float dx = getPontoX(v) - cx;
-                float dy = getPontoY(v) - cy;
+            for (int i = 0; i < n; i++) {
+                float dx = p->vertices[i].x - cx;
+                float dy = p->vertices[i].y - cy;
                 
                 if (sqrt(dx*dx + dy*dy) <= r) {
                     return true;
@@ -498,101 +894,29 @@ bool formaIntersectaPoligono(Poligono p, Forma f) {
             }
             
             // Verifica distância de arestas do polígono ao centro do círculo
-            Celula c = getInicioLista(vertices_poly);
-            if (!c) return false;
-            
-            Ponto v_first = (Ponto)getConteudoCelula(c);
-            Ponto v_prev = v_first;
-            
-            for (c = getProxCelula(c); c; c = getProxCelula(c)) {
-                Ponto v_curr = (Ponto)getConteudoCelula(c);
-                
+            for (int i = 0, j = n - 1; i < n; j = i++) {
                 float dist = distanciaPontoSegmento(cx, cy,
-                                                   getPontoX(v_prev), getPontoY(v_prev),
-                                                   getPontoX(v_curr), getPontoY(v_curr));
+                                                   p->vertices[j].x, p->vertices[j].y,
+                                                   p->vertices[i].x, p->vertices[i].y);
                 if (dist <= r) {
                     return true;
                 }
-                v_prev = v_curr;
-            }
-            
-           
-            float dist = distanciaPontoSegmento(cx, cy,
-                                               getPontoX(v_prev), getPontoY(v_prev),
-                                               getPontoX(v_first), getPontoY(v_first));
-            if (dist <= r) {
-                return true;
             }
             
             return false;
         }
         
         case TEXT: {
-            TEXTO t = (TEXTO)data;
-            float tx = getXTexto(t);
-            float ty = getYTexto(t);
-            char anc = getAncoraTexto(t);
-            char* texto = getTxtTexto(t);
-            int len = strlen(texto);
-            float L = 10.0f * len;
-            
-            // Calcula extremidades do segmento de texto
             float x1, y1, x2, y2;
-            if (anc == 'i' || anc == 'I') {
-                x1 = tx;
-                y1 = ty;
-                x2 = tx + L;
-                y2 = ty;
-            } else if (anc == 'f' || anc == 'F') {
-                x1 = tx - L;
-                y1 = ty;
-                x2 = tx;
-                y2 = ty;
-            } else {
-                x1 = tx - L/2;
-                y1 = ty;
-                x2 = tx + L/2;
-                y2 = ty;
-            }
+            segmentoTexto((TEXTO)data, &x1, &y1, &x2, &y2);
             
             // Verifica se extremidades estão dentro do polígono
-            Ponto p1 = criaPonto(x1, y1);
-            Ponto p2 = criaPonto(x2, y2);
-            
-            if (isInside(p, p1) || isInside(p, p2)) {
-                liberaPonto(p1);
-                liberaPonto(p2);
+            if (isInsideXY(p, x1, y1) || isInsideXY(p, x2, y2)) {
                 return true;
             }
-            liberaPonto(p1);
-            liberaPonto(p2);
             
             // Verifica interseção com arestas do polígono
-            Celula c = getInicioLista(vertices_poly);
-            if (!c) return false;
-            
-            Ponto v_first = (Ponto)getConteudoCelula(c);
-            Ponto v_prev = v_first;
-            
-            for (c = getProxCelula(c); c; c = getProxCelula(c)) {
-                Ponto v_curr = (Ponto)getConteudoCelula(c);
-                
-                if (segmentosIntersectam(x1, y1, x2, y2,
-                                        getPontoX(v_prev), getPontoY(v_prev),
-                                        getPontoX(v_curr), getPontoY(v_curr))) {
-                    return true;
-                }
-                v_prev = v_curr;
-            }
-            
-            
-            if (segmentosIntersectam(x1, y1, x2, y2,
-                                    getPontoX(v_prev), getPontoY(v_prev),
-                                    getPontoX(v_first), getPontoY(v_first))) {
-                return true;
-            }
-            
-            return false;
+            return arestaCruzaSegmento(p, x1, y1, x2, y2);
         }
         
         case ANTEPARO: {
@@ -603,43 +927,12 @@ bool formaIntersectaPoligono(Poligono p, Forma f) {
             float y2 = getY2Anteparo(a);
             
             // Verifica se extremidades estão dentro do polígono
-            Ponto p1 = criaPonto(x1, y1);
-            Ponto p2 = criaPonto(x2, y2);
-            
-            if (isInside(p, p1) || isInside(p, p2)) {
-                liberaPonto(p1);
-                liberaPonto(p2);
+            if (isInsideXY(p, x1, y1) || isInsideXY(p, x2, y2)) {
                 return true;
             }
-            liberaPonto(p1);
-            liberaPonto(p2);
             
             // Verifica interseção com arestas do polígono
-            Celula c = getInicioLista(vertices_poly);
-            if (!c) return false;
-            
-            Ponto v_first = (Ponto)getConteudoCelula(c);
-            Ponto v_prev = v_first;
-            
-            for (c = getProxCelula(c); c; c = getProxCelula(c)) {
-                Ponto v_curr = (Ponto)getConteudoCelula(c);
-                
-                if (segmentosIntersectam(x1, y1, x2, y2,
-                                        getPontoX(v_prev), getPontoY(v_prev),
-                                        getPontoX(v_curr), getPontoY(v_curr))) {
-                    return true;
-                }
-                v_prev = v_curr;
-            }
-            
-            
-            if (segmentosIntersectam(x1, y1, x2, y2,
-                                    getPontoX(v_prev), getPontoY(v_prev),
-                                    getPontoX(v_first), getPontoY(v_first))) {
-                return true;
-            }
-            
-            return false;
+            return arestaCruzaSegmento(p, x1, y1, x2, y2);
         }
             
         default:
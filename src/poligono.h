@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include "lista.h"
+#include "vetor.h"
 #include "ponto.h"
 
 /**
@@ -25,7 +26,14 @@ typedef void* BoundingBox;
  */
 typedef void* Forma;
 
-
+/**
+ * @brief Distância abaixo da qual dois segmentos contam como encostados.
+ *
+ * Os vértices de uma região de visibilidade saem de interseções calculadas em
+ * float e ficam sobre os anteparos só a menos de arredondamento; a tolerância
+ * cobre esse erro para coordenadas da ordem de milhares.
+ */
+#define TOLERANCIA_CONTATO 1e-3f
 
 /**
  * @brief Cria um novo segmento.
@@ -119,6 +127,25 @@ float getBBMaxY(BoundingBox bb);
  */
 Poligono criaPoligono();
 
+/**
+ * @brief Cria um polígono vazio com espaço reservado para vértices.
+ * 
+ * Os vértices ficam num buffer contíguo; reservar a quantidade esperada
+ * evita realocações durante a inserção.
+ * 
+ * @param capacidade Número de vértices a reservar.
+ * @return Ponteiro para o polígono criado.
+ */
+Poligono criaPoligonoCapacidade(int capacidade);
+
+/**
+ * @brief Cria uma cópia independente do polígono.
+ * 
+ * @param p Ponteiro para o polígono original.
+ * @return Nova cópia, a ser liberada com liberaPoligono().
+ */
+Poligono copiaPoligono(Poligono p);
+
 /**
  * @brief Libera a memória alocada para o polígono.
  * 
@@ -136,6 +163,25 @@ void liberaPoligono(Poligono p);
  */
 void insereVertice(Poligono p, Ponto ponto);
 
+/**
+ * @brief Insere um vértice no polígono a partir das coordenadas.
+ * 
+ * Não aloca nada enquanto houver capacidade reservada.
+ * 
+ * @param p Ponteiro para o polígono.
+ * @param x Coordenada x do vértice.
+ * @param y Coordenada y do vértice.
+ */
+void insereVerticeXY(Poligono p, float x, float y);
+
+/**
+ * @brief Garante espaço para ao menos `capacidade` vértices.
+ * 
+ * @param p Ponteiro para o polígono.
+ * @param capacidade Número total de vértices a comportar.
+ */
+void reservaVertices(Poligono p, int capacidade);
+
 /**
  * @brief Insere um segmento no polígono.
  * 
@@ -167,26 +213,45 @@ BoundingBox getBoundingBox(Poligono p);
 bool isInside(Poligono p, Ponto ponto);
 
 /**
- * @brief Retorna a lista de vértices do polígono.
+ * @brief Verifica se o ponto (x, y) está dentro do polígono.
  * 
- * A lista retornada contém ponteiros para Ponto.
- * O chamador não deve liberar os pontos, apenas a lista.
+ * Mesmo teste de isInside(), sem precisar criar um Ponto.
  * 
  * @param p Ponteiro para o polígono.
- * @return Lista de vértices (Ponto*).
+ * @param x Coordenada x do ponto.
+ * @param y Coordenada y do ponto.
+ * @return true se o ponto está dentro, false caso contrário.
  */
-Lista getVertices(Poligono p);
+bool isInsideXY(Poligono p, float x, float y);
 
 /**
- * @brief Retorna a lista de segmentos do polígono.
+ * @brief Retorna a coordenada x do i-ésimo vértice.
  * 
- * A lista retornada contém ponteiros para Segmento.
- * O chamador não deve liberar os segmentos, apenas a lista.
+ * @param p Ponteiro para o polígono.
+ * @param i Índice do vértice, de 0 a getNumVertices(p) - 1.
+ * @return Coordenada x, ou 0 se o índice for inválido.
+ */
+float getXVertice(Poligono p, int i);
+
+/**
+ * @brief Retorna a coordenada y do i-ésimo vértice.
  * 
  * @param p Ponteiro para o polígono.
- * @return Lista de segmentos (Segmento*).
+ * @param i Índice do vértice, de 0 a getNumVertices(p) - 1.
+ * @return Coordenada y, ou 0 se o índice for inválido.
  */
-Lista getSegmentos(Poligono p);
+float getYVertice(Poligono p, int i);
+
+/**
+ * @brief Retorna o vetor de segmentos do polígono.
+ * 
+ * O vetor retornado contém ponteiros para Segmento e pertence ao polígono.
+ * O chamador não deve liberar nem o vetor nem os segmentos.
+ * 
+ * @param p Ponteiro para o polígono.
+ * @return Vetor de segmentos (Segmento*).
+ */
+Vetor getSegmentos(Poligono p);
 
 /**
  * @brief Retorna o número de vértices do polígono.
@@ -213,6 +278,26 @@ int getNumSegmentos(Poligono p);
  */
 bool haInterseccaoBB(BoundingBox a, BoundingBox b);
 
+/**
+ * @brief Verifica se dois segmentos se cruzam ou se encostam.
+ *
+ * Além do cruzamento próprio, conta como contato qualquer par de segmentos a
+ * até TOLERANCIA_CONTATO um do outro, inclusive colineares sobrepostos e um
+ * extremo sobre o outro segmento.
+ *
+ * @param x1 Coordenada x do início do primeiro segmento.
+ * @param y1 Coordenada y do início do primeiro segmento.
+ * @param x2 Coordenada x do fim do primeiro segmento.
+ * @param y2 Coordenada y do fim do primeiro segmento.
+ * @param x3 Coordenada x do início do segundo segmento.
+ * @param y3 Coordenada y do início do segundo segmento.
+ * @param x4 Coordenada x do fim do segundo segmento.
+ * @param y4 Coordenada y do fim do segundo segmento.
+ * @return true se os segmentos se cruzam ou se encostam.
+ */
+bool segmentosSeTocam(float x1, float y1, float x2, float y2,
+                      float x3, float y3, float x4, float y4);
+
 /**
  * @brief Verifica se uma forma intersecta ou está dentro de um polígono.
  * 
@@ -223,6 +308,11 @@ bool haInterseccaoBB(BoundingBox a, BoundingBox b);
  * - Vértices do polígono dentro da forma
  * - Interseção de arestas
  * 
+ * Formas de segmento (linhas, anteparos, textos) e lados de retângulo que só
+ * encostam numa aresta do polígono, a até TOLERANCIA_CONTATO, também contam
+ * como interseção (ver segmentosSeTocam()). Um anteparo que delimita a região
+ * fica exatamente sobre a fronteira e deve ser atingido.
+ * 
  * @param p Ponteiro para o polígono.
  * @param f Ponteiro para a forma.
  * @return true se há interseção ou contenção, false caso contrário.
@@ -190,20 +190,49 @@ float calculoAreaRetangulo(RETANGULO r){
 
 void desalocarRetangulo(RETANGULO r){
 
+    desalocarCamposRetangulo(r);
+    free(r);
+
+}
+
+void desalocarCamposRetangulo(RETANGULO r){
+
     retangulo *rTemp = ((retangulo*)r);
 
     free(rTemp->corB);
     free(rTemp->corP);
-    free(rTemp);
 
 }
+
+size_t getTamanhoRetangulo(void){
+
+    return sizeof(retangulo);
+}
 RETANGULO clonaRetangulo(RETANGULO r, int novo_id, float dx, float dy){
+    retangulo *clone = (retangulo*) malloc(sizeof(retangulo));
+    if(clone == NULL){
+        printf("Erro na alocação de memória\n");
+        exit(1);
+    }
+    clonaRetanguloEm(clone, r, novo_id, dx, dy);
+    return clone;
+}
+
+void clonaRetanguloEm(void *destino, RETANGULO r, int novo_id, float dx, float dy){
     retangulo *rTemp = ((retangulo*)r);
-    return criaRetangulo(novo_id,
-                        rTemp->x + dx,
-                        rTemp->y + dy,
-                        rTemp->altura,
-                        rTemp->largura,
-                        rTemp->corB,
-                        rTemp->corP);
+    retangulo *clone = ((retangulo*)destino);
+
+    clone->id = novo_id;
+    clone->x = rTemp->x + dx;
+    clone->y = rTemp->y + dy;
+    clone->altura = rTemp->altura;
+    clone->largura = rTemp->largura;
+    clone->corB = (char*)malloc(sizeof(char) * strlen(rTemp->corB) +1);
+    clone->corP = (char*)malloc(sizeof(char) * strlen(rTemp->corP) +1);
+    if(clone->corB == NULL || clone->corP == NULL){
+        printf("Erro de alocação");
+        exit(1);
+    }
+    strcpy(clone->corB, rTemp->corB);
+    strcpy(clone->corP, rTemp->corP);
 }
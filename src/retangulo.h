@@ -1,6 +1,8 @@
 #ifndef RETANGULO_H
 #define RETANGULO_H
 
+#include <stddef.h>
+
 /**
  * @file retangulo.h
  * @brief Interface para o módulo de Retângulo.
@@ -139,11 +141,41 @@ float calculoAreaRetangulo(RETANGULO r);
  */
 void desalocarRetangulo(RETANGULO r);
 
+/**
+ * @brief Libera as cores do retângulo, mas não a estrutura em si.
+ *
+ * Usada quando a estrutura está embutida em outro bloco (ver criaForma()).
+ *
+ * @param r Retângulo.
+ */
+void desalocarCamposRetangulo(RETANGULO r);
+
+/**
+ * @brief Retorna o tamanho, em bytes, da estrutura de um retângulo.
+ *
+ * @return Tamanho da estrutura.
+ */
+size_t getTamanhoRetangulo(void);
+
 
 /**
  * @brief Cria um clone do retângulo com novo ID e deslocamento.
  */
 RETANGULO clonaRetangulo(RETANGULO r, int novo_id, float dx, float dy);
 
+/**
+ * @brief Escreve um clone do retângulo, com novo ID e deslocamento, na memória indicada.
+ * 
+ * Como clonaRetangulo(), mas sem alocar a estrutura: destino deve ter
+ * getTamanhoRetangulo() bytes, alinhados para qualquer tipo.
+ * 
+ * @param destino Memória que recebe o clone.
+ * @param r Ponteiro para o retângulo original.
+ * @param novo_id Novo ID para o clone.
+ * @param dx Deslocamento em X.
+ * @param dy Deslocamento em Y.
+ */
+void clonaRetanguloEm(void *destino, RETANGULO r, int novo_id, float dx, float dy);
+
 #endif 
 
@@ -1,83 +1,509 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "sort.h"
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
+#include <unistd.h>
 
-static void merge(char *base, size_t l, size_t m, size_t r, size_t size, int (*compar)(const void *, const void *)) {
-    size_t n1 = m - l + 1;
-    size_t n2 = r - m;
+typedef int (*FuncaoComparacaoSort)(const void *, const void *);
 
-    char *L = malloc(n1 * size);
-    char *R = malloc(n2 * size);
+static void troca(char *a, char *b, size_t size) {
+    char buffer[64];
+    while (size > 0) {
+        size_t bloco = size < sizeof(buffer) ? size : sizeof(buffer);
+        memcpy(buffer, a, bloco);
+        memcpy(a, b, bloco);
+        memcpy(b, buffer, bloco);
+        a += bloco;
+        b += bloco;
+        size -= bloco;
+    }
+}
 
-    if (!L || !R) {
-        if (L) free(L);
-        if (R) free(R);
-        return;
+// Insertion sort no intervalo [lo, hi), usando 'chave' (size bytes) como área temporária
+static void insertion_intervalo(char *base, size_t lo, size_t hi, size_t size,
+                                FuncaoComparacaoSort compar, char *chave) {
+    for (size_t i = lo + 1; i < hi; i++) {
+        if (compar(base + (i - 1) * size, base + i * size) <= 0) continue;
+
+        memcpy(chave, base + i * size, size);
+        size_t j = i;
+        while (j > lo && compar(base + (j - 1) * size, chave) > 0) {
+            memcpy(base + j * size, base + (j - 1) * size, size);
+            j--;
+        }
+        memcpy(base + j * size, chave, size);
     }
+}
 
-    memcpy(L, base + l * size, n1 * size);
-    memcpy(R, base + (m + 1) * size, n2 * size);
+// Subarrays com menos de 3 elementos são sempre resolvidos por inserção
+static size_t normaliza_limiar(size_t limiar) {
+    return limiar < 2 ? 2 : limiar;
+}
 
-    size_t i = 0, j = 0, k = l;
-    while (i < n1 && j < n2) {
-        if (compar(L + i * size, R + j * size) <= 0) {
-            memcpy(base + k * size, L + i * size, size);
+/* ================= Merge Sort ================= */
+
+// Intercala [lo, meio) e [meio, hi); a metade esquerda é copiada para 'aux'
+static void merge(char *base, size_t lo, size_t meio, size_t hi, size_t size,
+                  FuncaoComparacaoSort compar, char *aux) {
+    size_t n1 = meio - lo;
+    memcpy(aux, base + lo * size, n1 * size);
+
+    size_t i = 0, j = meio, k = lo;
+    while (i < n1 && j < hi) {
+        if (compar(aux + i * size, base + j * size) <= 0) {
+            memcpy(base + k * size, aux + i * size, size);
             i++;
         } else {
-            memcpy(base + k * size, R + j * size, size);
+            memcpy(base + k * size, base + j * size, size);
             j++;
         }
         k++;
     }
 
-    while (i < n1) {
-        memcpy(base + k * size, L + i * size, size);
-        i++;
-        k++;
+    // O que sobrar da direita já está na posição final
+    if (i < n1) {
+        memcpy(base + k * size, aux + i * size, (n1 - i) * size);
     }
+}
 
-    while (j < n2) {
-        memcpy(base + k * size, R + j * size, size);
-        j++;
-        k++;
+static void merge_sort_recursive(char *base, size_t lo, size_t hi, size_t size,
+                                 FuncaoComparacaoSort compar, size_t limiar, char *aux) {
+    if (hi - lo <= limiar) {
+        insertion_intervalo(base, lo, hi, size, compar, aux);
+        return;
     }
 
-    free(L);
-    free(R);
+    size_t meio = lo + (hi - lo) / 2;
+    merge_sort_recursive(base, lo, meio, size, compar, limiar, aux);
+    merge_sort_recursive(base, meio, hi, size, compar, limiar, aux);
+
+    // Metades já em ordem: nada a intercalar
+    if (compar(base + (meio - 1) * size, base + meio * size) <= 0) return;
+
+    merge(base, lo, meio, hi, size, compar, aux);
 }
 
-static void merge_sort_recursive(char *base, size_t l, size_t r, size_t size, int (*compar)(const void *, const void *)) {
-    if (l < r) {
-        size_t m = l + (r - l) / 2;
-        merge_sort_recursive(base, l, m, size, compar);
-        merge_sort_recursive(base, m + 1, r, size, compar);
-        merge(base, l, m, r, size, compar);
+void merge_sort_limiar(void *base, size_t nmemb, size_t size,
+                       int (*compar)(const void *, const void *), size_t limiar) {
+    if (nmemb < 2) return;
+    limiar = normaliza_limiar(limiar);
+
+    // Um único buffer: metade esquerda no merge, ou chave do insertion sort nas folhas
+    size_t n_aux = nmemb / 2 + 1;
+    char *aux = malloc(n_aux * size);
+
+    if (!aux) {
+        // Sem memória auxiliar: insertion sort estável por trocas adjacentes
+        char *arr = (char *)base;
+        for (size_t i = 1; i < nmemb; i++) {
+            for (size_t j = i; j > 0 && compar(arr + (j - 1) * size, arr + j * size) > 0; j--) {
+                troca(arr + (j - 1) * size, arr + j * size, size);
+            }
+        }
+        return;
     }
+
+    merge_sort_recursive((char *)base, 0, nmemb, size, compar, limiar, aux);
+    free(aux);
 }
 
 void merge_sort(void *base, size_t nmemb, size_t size, int (*compar)(const void *, const void *)) {
-    if (nmemb < 2) return;
-    merge_sort_recursive((char *)base, 0, nmemb - 1, size, compar);
+    merge_sort_limiar(base, nmemb, size, compar, SORT_LIMIAR_PADRAO);
 }
 
+/* ================= Merge Sort Paralelo ================= */
+
+#define SORT_MAX_THREADS 64
+#define SORT_MIN_POR_THREAD 4096
+
+typedef struct {
+    const char *a;      // Primeira sequência ordenada
+    size_t n_a;
+    const char *b;      // Segunda sequência ordenada
+    size_t n_b;
+    char *destino;      // Recebe n_a + n_b elementos
+    size_t diag_ini;    // Faixa [diag_ini, diag_fim) da saída que cabe a esta tarefa
+    size_t diag_fim;
+} TarefaMerge;
+
+typedef struct {
+    char *base;
+    char *aux;
+    size_t size;
+    FuncaoComparacaoSort compar;
+    size_t limiar;
+
+    // Fase 1: blocos ordenados independentemente
+    size_t *inicio_bloco;   // n_blocos + 1 fronteiras
+
+    // Fase 2: tarefas de intercalação da rodada atual
+    TarefaMerge *tarefas;
+    int n_tarefas;
+} TrabalhoParalelo;
+
+typedef struct {
+    TrabalhoParalelo *trabalho;
+    int id;
+    int n_threads;
+    int fase;
+} ArgThread;
+
+// Merge path: quantos elementos de 'a' entram nos primeiros 'diag' da intercalação estável
+static size_t merge_path(const char *a, size_t n_a, const char *b, size_t n_b,
+                         size_t diag, size_t size, FuncaoComparacaoSort compar) {
+    size_t lo = diag > n_b ? diag - n_b : 0;
+    size_t hi = diag < n_a ? diag : n_a;
+
+    while (lo < hi) {
+        size_t meio = lo + (hi - lo) / 2;
+        // Na intercalação estável, a[meio] sai antes de b[diag-meio-1] se não for maior
+        if (compar(a + meio * size, b + (diag - meio - 1) * size) <= 0) {
+            lo = meio + 1;
+        } else {
+            hi = meio;
+        }
+    }
+    return lo;
+}
+
+static void executa_tarefa_merge(const TarefaMerge *t, size_t size, FuncaoComparacaoSort compar) {
+    size_t i = merge_path(t->a, t->n_a, t->b, t->n_b, t->diag_ini, size, compar);
+    size_t j = t->diag_ini - i;
+    size_t i_fim = merge_path(t->a, t->n_a, t->b, t->n_b, t->diag_fim, size, compar);
+    size_t j_fim = t->diag_fim - i_fim;
+    char *saida = t->destino + t->diag_ini * size;
+
+    while (i < i_fim && j < j_fim) {
+        if (compar(t->a + i * size, t->b + j * size) <= 0) {
+            memcpy(saida, t->a + i * size, size);
+            i++;
+        } else {
+            memcpy(saida, t->b + j * size, size);
+            j++;
+        }
+        saida += size;
+    }
+    if (i < i_fim) {
+        memcpy(saida, t->a + i * size, (i_fim - i) * size);
+    } else if (j < j_fim) {
+        memcpy(saida, t->b + j * size, (j_fim - j) * size);
+    }
+}
+
+static void *thread_merge_sort(void *arg) {
+    ArgThread *at = (ArgThread *)arg;
+    TrabalhoParalelo *tr = at->trabalho;
+
+    if (at->fase == 1) {
+        size_t ini = tr->inicio_bloco[at->id];
+        size_t fim = tr->inicio_bloco[at->id + 1];
+        // Cada bloco usa a fatia correspondente do buffer auxiliar
+        merge_sort_recursive(tr->base + ini * tr->size, 0, fim - ini, tr->size,
+                             tr->compar, tr->limiar, tr->aux + ini * tr->size);
+    } else {
+        for (int t = at->id; t < tr->n_tarefas; t += at->n_threads) {
+            executa_tarefa_merge(&tr->tarefas[t], tr->size, tr->compar);
+        }
+    }
+    return NULL;
+}
+
+static void executa_em_paralelo(TrabalhoParalelo *tr, int n_threads, int fase) {
+    pthread_t threads[SORT_MAX_THREADS];
+    ArgThread args[SORT_MAX_THREADS];
+    int criada[SORT_MAX_THREADS];
+
+    for (int t = 0; t < n_threads; t++) {
+        args[t].trabalho = tr;
+        args[t].id = t;
+        args[t].n_threads = n_threads;
+        args[t].fase = fase;
+        // A thread 0 roda na chamadora; se a criação falhar, a parte roda aqui mesmo
+        criada[t] = t > 0 && pthread_create(&threads[t], NULL, thread_merge_sort, &args[t]) == 0;
+    }
+    for (int t = 0; t < n_threads; t++) {
+        if (!criada[t]) thread_merge_sort(&args[t]);
+    }
+    for (int t = 1; t < n_threads; t++) {
+        if (criada[t]) pthread_join(threads[t], NULL);
+    }
+}
+
+static int numero_threads(int pedido, size_t nmemb) {
+    long n = pedido;
+    if (n <= 0) {
+        n = sysconf(_SC_NPROCESSORS_ONLN);
+        if (n <= 0) n = 1;
+    }
+    if (n > SORT_MAX_THREADS) n = SORT_MAX_THREADS;
+
+    long max_util = (long)(nmemb / SORT_MIN_POR_THREAD);
+    if (n > max_util) n = max_util;
+    return n < 1 ? 1 : (int)n;
+}
+
+void merge_sort_paralelo(void *base, size_t nmemb, size_t size,
+                         int (*compar)(const void *, const void *), size_t limiar, int n_threads) {
+    n_threads = numero_threads(n_threads, nmemb);
+    if (nmemb < SORT_CORTE_PARALELO || n_threads < 2) {
+        merge_sort_limiar(base, nmemb, size, compar, limiar);
+        return;
+    }
+    limiar = normaliza_limiar(limiar);
+
+    char *aux = malloc(nmemb * size);
+    size_t *fronteiras = malloc((n_threads + 1) * sizeof(size_t));
+    TarefaMerge *tarefas = malloc(2 * n_threads * sizeof(TarefaMerge));
+    if (!aux || !fronteiras || !tarefas) {
+        free(aux);
+        free(fronteiras);
+        free(tarefas);
+        merge_sort_limiar(base, nmemb, size, compar, limiar);
+        return;
+    }
+
+    TrabalhoParalelo tr;
+    tr.base = (char *)base;
+    tr.aux = aux;
+    tr.size = size;
+    tr.compar = compar;
+    tr.limiar = limiar;
+    tr.inicio_bloco = fronteiras;
+    tr.tarefas = tarefas;
+
+    // Fase 1: um bloco por thread, cada um ordenado sequencialmente
+    for (int t = 0; t <= n_threads; t++) {
+        fronteiras[t] = nmemb * (size_t)t / (size_t)n_threads;
+    }
+    executa_em_paralelo(&tr, n_threads, 1);
+
+    // Fase 2: rodadas de intercalação em pares, alternando entre base e aux.
+    // Cada par é dividido em fatias de saída de tamanho parecido via merge path,
+    // de modo que todas as threads trabalham até a última rodada.
+    int n_blocos = n_threads;
+    char *origem = tr.base;
+    char *destino = aux;
+
+    while (n_blocos > 1) {
+        size_t fatia = (nmemb + n_threads - 1) / n_threads;
+        int n_tarefas = 0;
+        int novos_blocos = 0;
+
+        for (int b = 0; b < n_blocos; b += 2) {
+            size_t ini = fronteiras[b];
+            size_t meio = fronteiras[b + 1];
+            size_t fim = (b + 2 <= n_blocos) ? fronteiras[b + 2] : meio;
+
+            // Bloco ímpar sem par: intercalado com uma sequência vazia (cópia)
+            size_t total = fim - ini;
+            for (size_t d = 0; d < total; d += fatia) {
+                TarefaMerge *t = &tarefas[n_tarefas++];
+                t->a = origem + ini * size;
+                t->n_a = meio - ini;
+                t->b = origem + meio * size;
+                t->n_b = fim - meio;
+                t->destino = destino + ini * size;
+                t->diag_ini = d;
+                t->diag_fim = (d + fatia < total) ? d + fatia : total;
+            }
+            fronteiras[novos_blocos++] = ini;
+        }
+        fronteiras[novos_blocos] = nmemb;
+
+        tr.n_tarefas = n_tarefas;
+        executa_em_paralelo(&tr, n_threads, 2);
+
+        n_blocos = novos_blocos;
+        char *tmp = origem;
+        origem = destino;
+        destino = tmp;
+    }
+
+    if (origem != tr.base) {
+        memcpy(tr.base, origem, nmemb * size);
+    }
+
+    free(aux);
+    free(fronteiras);
+    free(tarefas);
+}
+
+/* ================= Insertion Sort ================= */
+
 void insertion_sort(void *base, size_t nmemb, size_t size, int (*compar)(const void *, const void *)) {
-    char *arr = (char *)base;
+    if (nmemb < 2) return;
+
     char *key = malloc(size);
     if (!key) return;
 
-    for (size_t i = 1; i < nmemb; i++) {
-        memcpy(key, arr + i * size, size);
-        size_t j = i;
-        
-        while (j > 0 && compar(arr + (j - 1) * size, key) > 0) {
-            memcpy(arr + j * size, arr + (j - 1) * size, size);
-            j--;
+    insertion_intervalo((char *)base, 0, nmemb, size, compar, key);
+    free(key);
+}
+
+/* ================= Introsort ================= */
+
+static void heap_desce(char *base, size_t raiz, size_t n, size_t size, FuncaoComparacaoSort compar) {
+    for (;;) {
+        size_t filho = 2 * raiz + 1;
+        if (filho >= n) return;
+
+        if (filho + 1 < n && compar(base + filho * size, base + (filho + 1) * size) < 0) {
+            filho++;
         }
-        memcpy(arr + j * size, key, size);
+        if (compar(base + raiz * size, base + filho * size) >= 0) return;
+
+        troca(base + raiz * size, base + filho * size, size);
+        raiz = filho;
     }
-    free(key);
+}
+
+// Heapsort em [lo, hi): fallback do introsort quando a recursão degenera
+static void heap_sort_intervalo(char *base, size_t lo, size_t hi, size_t size, FuncaoComparacaoSort compar) {
+    char *arr = base + lo * size;
+    size_t n = hi - lo;
+
+    for (size_t i = n / 2; i > 0; i--) {
+        heap_desce(arr, i - 1, n, size, compar);
+    }
+    for (size_t fim = n - 1; fim > 0; fim--) {
+        troca(arr, arr + fim * size, size);
+        heap_desce(arr, 0, fim, size, compar);
+    }
+}
+
+// Ordena a, b, c in-place e deixa a mediana em b
+static void mediana_de_tres(char *a, char *b, char *c, size_t size, FuncaoComparacaoSort compar) {
+    if (compar(b, a) < 0) troca(a, b, size);
+    if (compar(c, b) < 0) {
+        troca(b, c, size);
+        if (compar(b, a) < 0) troca(a, b, size);
+    }
+}
+
+// Partição de Hoare em [lo, hi) com o pivô copiado para 'pivo'; retorna o ponto de corte
+static size_t particiona(char *base, size_t lo, size_t hi, size_t size,
+                         FuncaoComparacaoSort compar, char *pivo) {
+    size_t meio = lo + (hi - lo) / 2;
+    mediana_de_tres(base + lo * size, base + meio * size, base + (hi - 1) * size, size, compar);
+    memcpy(pivo, base + meio * size, size);
+
+    size_t i = lo;
+    size_t j = hi - 1;
+    for (;;) {
+        while (compar(base + i * size, pivo) < 0) i++;
+        while (compar(base + j * size, pivo) > 0) j--;
+        if (i >= j) return j + 1;
+
+        troca(base + i * size, base + j * size, size);
+        i++;
+        j--;
+    }
+}
+
+static void introsort_recursive(char *base, size_t lo, size_t hi, size_t size,
+                                FuncaoComparacaoSort compar, size_t limiar,
+                                int profundidade, char *pivo) {
+    while (hi - lo > limiar) {
+        if (profundidade == 0) {
+            heap_sort_intervalo(base, lo, hi, size, compar);
+            return;
+        }
+        profundidade--;
+
+        size_t corte = particiona(base, lo, hi, size, compar, pivo);
+
+        // Recursão na parte menor, laço na maior: pilha limitada a O(log n)
+        if (corte - lo < hi - corte) {
+            introsort_recursive(base, lo, corte, size, compar, limiar, profundidade, pivo);
+            lo = corte;
+        } else {
+            introsort_recursive(base, corte, hi, size, compar, limiar, profundidade, pivo);
+            hi = corte;
+        }
+    }
+
+    insertion_intervalo(base, lo, hi, size, compar, pivo);
+}
+
+void quick_sort_limiar(void *base, size_t nmemb, size_t size,
+                       int (*compar)(const void *, const void *), size_t limiar) {
+    if (nmemb < 2) return;
+    limiar = normaliza_limiar(limiar);
+
+    char *pivo = malloc(size);
+    if (!pivo) {
+        heap_sort_intervalo((char *)base, 0, nmemb, size, compar);
+        return;
+    }
+
+    int profundidade = 0;
+    for (size_t n = nmemb; n > 1; n >>= 1) profundidade += 2;
+
+    introsort_recursive((char *)base, 0, nmemb, size, compar, limiar, profundidade, pivo);
+    free(pivo);
 }
 
 void quick_sort(void *base, size_t nmemb, size_t size, int (*compar)(const void *, const void *)) {
-    qsort(base, nmemb, size, compar);
+    quick_sort_limiar(base, nmemb, size, compar, SORT_LIMIAR_PADRAO);
+}
+
+/* ================= Radix Sort ================= */
+
+static int compara_chave_radix(const void *a, const void *b) {
+    uint64_t ka = ((const ChaveRadix *)a)->chave;
+    uint64_t kb = ((const ChaveRadix *)b)->chave;
+    return (ka > kb) - (ka < kb);
+}
+
+void radix_sort_chaves(ChaveRadix *v, size_t nmemb) {
+    if (nmemb < 2) return;
+
+    ChaveRadix *aux = malloc(nmemb * sizeof(ChaveRadix));
+    if (!aux) {
+        // Sem memória para o buffer: ordenação estável in-place
+        insertion_sort(v, nmemb, sizeof(ChaveRadix), compara_chave_radix);
+        return;
+    }
+
+    // Histograma dos 8 bytes numa única leitura das chaves
+    size_t contagem[8][256];
+    memset(contagem, 0, sizeof(contagem));
+    for (size_t i = 0; i < nmemb; i++) {
+        uint64_t k = v[i].chave;
+        for (int b = 0; b < 8; b++) {
+            contagem[b][(k >> (8 * b)) & 0xFF]++;
+        }
+    }
+
+    ChaveRadix *origem = v;
+    ChaveRadix *destino = aux;
+
+    for (int b = 0; b < 8; b++) {
+        size_t *c = contagem[b];
+        int desloc = 8 * b;
+
+        // Todas as chaves com o mesmo byte: a passada não muda nada
+        if (c[(origem[0].chave >> desloc) & 0xFF] == nmemb) continue;
+
+        size_t soma = 0;
+        for (int d = 0; d < 256; d++) {
+            size_t qtd = c[d];
+            c[d] = soma;
+            soma += qtd;
+        }
+        for (size_t i = 0; i < nmemb; i++) {
+            destino[c[(origem[i].chave >> desloc) & 0xFF]++] = origem[i];
+        }
+
+        ChaveRadix *tmp = origem;
+        origem = destino;
+        destino = tmp;
+    }
+
+    if (origem != v) {
+        memcpy(v, origem, nmemb * sizeof(ChaveRadix));
+    }
+    free(aux);
 }
@@ -2,10 +2,19 @@
 #define SORT_H
 
 #include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Limiar padrão de subarray abaixo do qual os algoritmos híbridos
+ *        passam a usar Insertion Sort.
+ */
+#define SORT_LIMIAR_PADRAO 10
 
 /**
  * @brief Ordena um array usando o algoritmo Merge Sort.
- * 
+ *
+ * Equivale a merge_sort_limiar() com SORT_LIMIAR_PADRAO.
+ *
  * @param base Ponteiro para o início do array.
  * @param nmemb Número de elementos no array.
  * @param size Tamanho de cada elemento em bytes.
@@ -13,9 +22,54 @@
  */
 void merge_sort(void *base, size_t nmemb, size_t size, int (*compar)(const void *, const void *));
 
+/**
+ * @brief Merge Sort estável com Insertion Sort nos subarrays pequenos.
+ *
+ * Aloca um único buffer auxiliar (metade do array) no início e o reutiliza
+ * em todas as intercalações. Subarrays com até `limiar` elementos são
+ * ordenados por inserção, e intercalações de metades já em ordem são puladas.
+ *
+ * @param base Ponteiro para o início do array.
+ * @param nmemb Número de elementos no array.
+ * @param size Tamanho de cada elemento em bytes.
+ * @param compar Função de comparação.
+ * @param limiar Tamanho máximo de subarray ordenado por inserção.
+ */
+void merge_sort_limiar(void *base, size_t nmemb, size_t size,
+                       int (*compar)(const void *, const void *), size_t limiar);
+
+/**
+ * @brief Tamanho mínimo de array para merge_sort_paralelo() usar threads;
+ *        abaixo dele a versão sequencial é usada.
+ */
+#define SORT_CORTE_PARALELO 65536
+
+/**
+ * @brief Merge Sort estável com múltiplas threads.
+ *
+ * O array é dividido em um bloco por thread, cada bloco é ordenado com
+ * merge_sort_limiar() e os blocos são intercalados em rodadas. Em cada rodada
+ * a saída de cada par é repartida entre as threads por merge path (busca
+ * binária na diagonal), então a intercalação também é paralela. O resultado
+ * é idêntico ao de merge_sort_limiar().
+ *
+ * Arrays com menos de SORT_CORTE_PARALELO elementos, ou quando só uma thread
+ * é útil, seguem direto pelo caminho sequencial.
+ *
+ * @param base Ponteiro para o início do array.
+ * @param nmemb Número de elementos no array.
+ * @param size Tamanho de cada elemento em bytes.
+ * @param compar Função de comparação (chamada concorrentemente; não pode
+ *               depender de estado global mutável).
+ * @param limiar Tamanho máximo de subarray ordenado por inserção.
+ * @param n_threads Número de threads, ou <= 0 para usar o número de CPUs.
+ */
+void merge_sort_paralelo(void *base, size_t nmemb, size_t size,
+                         int (*compar)(const void *, const void *), size_t limiar, int n_threads);
+
 /**
  * @brief Ordena um array usando o algoritmo Insertion Sort.
- * 
+ *
  * @param base Ponteiro para o início do array.
  * @param nmemb Número de elementos no array.
  * @param size Tamanho de cada elemento em bytes.
@@ -24,8 +78,10 @@ void merge_sort(void *base, size_t nmemb, size_t size, int (*compar)(const void
 void insertion_sort(void *base, size_t nmemb, size_t size, int (*compar)(const void *, const void *));
 
 /**
- * @brief Wrapper para a função qsort da biblioteca padrão.
- * 
+ * @brief Ordena um array usando Introsort.
+ *
+ * Equivale a quick_sort_limiar() com SORT_LIMIAR_PADRAO.
+ *
  * @param base Ponteiro para o início do array.
  * @param nmemb Número de elementos no array.
  * @param size Tamanho de cada elemento em bytes.
@@ -33,4 +89,42 @@ void insertion_sort(void *base, size_t nmemb, size_t size, int (*compar)(const v
  */
 void quick_sort(void *base, size_t nmemb, size_t size, int (*compar)(const void *, const void *));
 
+/**
+ * @brief Introsort: Quick Sort com pivô mediana-de-três, Heapsort quando a
+ *        recursão passa de 2*log2(n) níveis e Insertion Sort nas folhas.
+ *
+ * Não é estável. Não aloca nada além de um elemento temporário.
+ *
+ * @param base Ponteiro para o início do array.
+ * @param nmemb Número de elementos no array.
+ * @param size Tamanho de cada elemento em bytes.
+ * @param compar Função de comparação.
+ * @param limiar Tamanho máximo de subarray ordenado por inserção.
+ */
+void quick_sort_limiar(void *base, size_t nmemb, size_t size,
+                       int (*compar)(const void *, const void *), size_t limiar);
+
+/**
+ * @brief Par chave/índice ordenado por radix_sort_chaves().
+ *
+ * O chamador empacota em `chave` tudo que define a ordem (comparação como
+ * inteiro sem sinal) e guarda em `indice` a posição do registro original.
+ */
+typedef struct {
+    uint64_t chave;
+    size_t indice;
+} ChaveRadix;
+
+/**
+ * @brief Radix Sort LSD estável sobre chaves de 64 bits.
+ *
+ * Oito passadas de um byte cada, com contagem e distribuição num buffer
+ * auxiliar do mesmo tamanho. Passadas em que todas as chaves têm o mesmo
+ * byte são puladas. Tempo linear em nmemb.
+ *
+ * @param v Array de pares a ordenar por `chave` crescente.
+ * @param nmemb Número de pares.
+ */
+void radix_sort_chaves(ChaveRadix *v, size_t nmemb);
+
 #endif
@@ -0,0 +1,152 @@
+#ifndef SORT_TIPADO_H
+#define SORT_TIPADO_H
+
+#include <stddef.h>
+#include <stdlib.h>
+
+/**
+ * @file sort_tipado.h
+ * @brief Geração de rotinas de ordenação especializadas para um tipo.
+ *
+ * As funções de sort.h movem elementos com memcpy e chamam a comparação por
+ * ponteiro de função. Quando o tipo é conhecido em tempo de compilação, a
+ * macro SORT_TIPADO gera as mesmas rotinas (Insertion Sort, Merge Sort com
+ * buffer único e Introsort, todos com limiar de inserção) operando direto
+ * sobre o tipo, com atribuição simples e a comparação expandida no local.
+ *
+ * Uso:
+ * @code
+ * #define PAR_MENOR(a, b) ((a)->chave < (b)->chave)
+ * SORT_TIPADO(par, Par, PAR_MENOR)
+ * ...
+ * par_merge_sort(v, n, limiar);
+ * par_quick_sort(v, n, limiar);
+ * @endcode
+ *
+ * MENOR(a, b) recebe dois ponteiros para TIPO e deve ser verdadeiro se e
+ * somente se *a vem estritamente antes de *b. As decisões tomadas são as
+ * mesmas de merge_sort_limiar() e quick_sort_limiar() com uma comparação
+ * equivalente, portanto o resultado também é o mesmo.
+ *
+ * Funções geradas (todas static inline):
+ * - NOME_merge_sort(TIPO *v, size_t n, size_t limiar): estável.
+ * - NOME_quick_sort(TIPO *v, size_t n, size_t limiar): introsort.
+ * - NOME_insercao(TIPO *v, size_t lo, size_t hi): insertion sort em [lo, hi).
+ */
+
+#define SORT_TIPADO(NOME, TIPO, MENOR)                                              \
+                                                                                    \
+static inline void NOME##_insercao(TIPO *v, size_t lo, size_t hi) {                \
+    for (size_t i = lo + 1; i < hi; i++) {                                          \
+        if (!MENOR(&v[i], &v[i - 1])) continue;                                     \
+        TIPO chave = v[i];                                                          \
+        size_t j = i;                                                               \
+        while (j > lo && MENOR(&chave, &v[j - 1])) {                                \
+            v[j] = v[j - 1];                                                        \
+            j--;                                                                    \
+        }                                                                           \
+        v[j] = chave;                                                               \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+static inline void NOME##_merge_rec(TIPO *v, size_t lo, size_t hi,                 \
+                                    size_t limiar, TIPO *aux) {                     \
+    if (hi - lo <= limiar) {                                                        \
+        NOME##_insercao(v, lo, hi);                                                 \
+        return;                                                                     \
+    }                                                                               \
+    size_t meio = lo + (hi - lo) / 2;                                               \
+    NOME##_merge_rec(v, lo, meio, limiar, aux);                                     \
+    NOME##_merge_rec(v, meio, hi, limiar, aux);                                     \
+    if (!MENOR(&v[meio], &v[meio - 1])) return;                                     \
+                                                                                    \
+    size_t n1 = meio - lo;                                                          \
+    for (size_t t = 0; t < n1; t++) aux[t] = v[lo + t];                             \
+    size_t i = 0, j = meio, k = lo;                                                 \
+    while (i < n1 && j < hi) {                                                      \
+        if (MENOR(&v[j], &aux[i])) v[k++] = v[j++];                                 \
+        else v[k++] = aux[i++];                                                     \
+    }                                                                               \
+    while (i < n1) v[k++] = aux[i++];                                               \
+}                                                                                   \
+                                                                                    \
+static inline void NOME##_merge_sort(TIPO *v, size_t n, size_t limiar) {           \
+    if (n < 2) return;                                                              \
+    if (limiar < 2) limiar = 2;                                                     \
+    TIPO *aux = malloc((n / 2 + 1) * sizeof(TIPO));                                 \
+    if (!aux) {                                                                     \
+        NOME##_insercao(v, 0, n);                                                   \
+        return;                                                                     \
+    }                                                                               \
+    NOME##_merge_rec(v, 0, n, limiar, aux);                                         \
+    free(aux);                                                                      \
+}                                                                                   \
+                                                                                    \
+static inline void NOME##_heap_desce(TIPO *v, size_t raiz, size_t n) {             \
+    for (;;) {                                                                      \
+        size_t filho = 2 * raiz + 1;                                                \
+        if (filho >= n) return;                                                     \
+        if (filho + 1 < n && MENOR(&v[filho], &v[filho + 1])) filho++;              \
+        if (!MENOR(&v[raiz], &v[filho])) return;                                    \
+        TIPO tmp = v[raiz]; v[raiz] = v[filho]; v[filho] = tmp;                     \
+        raiz = filho;                                                               \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+static inline void NOME##_heap_sort(TIPO *v, size_t n) {                           \
+    for (size_t i = n / 2; i > 0; i--) NOME##_heap_desce(v, i - 1, n);              \
+    for (size_t fim = n - 1; fim > 0; fim--) {                                      \
+        TIPO tmp = v[0]; v[0] = v[fim]; v[fim] = tmp;                               \
+        NOME##_heap_desce(v, 0, fim);                                               \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+static inline void NOME##_quick_rec(TIPO *v, size_t lo, size_t hi,                 \
+                                    size_t limiar, int profundidade) {              \
+    while (hi - lo > limiar) {                                                      \
+        if (profundidade == 0) {                                                    \
+            NOME##_heap_sort(v + lo, hi - lo);                                      \
+            return;                                                                 \
+        }                                                                           \
+        profundidade--;                                                             \
+                                                                                    \
+        size_t meio = lo + (hi - lo) / 2;                                           \
+        TIPO tmp;                                                                   \
+        if (MENOR(&v[meio], &v[lo])) { tmp = v[lo]; v[lo] = v[meio]; v[meio] = tmp; } \
+        if (MENOR(&v[hi - 1], &v[meio])) {                                          \
+            tmp = v[meio]; v[meio] = v[hi - 1]; v[hi - 1] = tmp;                    \
+            if (MENOR(&v[meio], &v[lo])) { tmp = v[lo]; v[lo] = v[meio]; v[meio] = tmp; } \
+        }                                                                           \
+        TIPO pivo = v[meio];                                                        \
+                                                                                    \
+        size_t i = lo, j = hi - 1;                                                  \
+        for (;;) {                                                                  \
+            while (MENOR(&v[i], &pivo)) i++;                                        \
+            while (MENOR(&pivo, &v[j])) j--;                                        \
+            if (i >= j) break;                                                      \
+            tmp = v[i]; v[i] = v[j]; v[j] = tmp;                                    \
+            i++;                                                                    \
+            j--;                                                                    \
+        }                                                                           \
+        size_t corte = j + 1;                                                       \
+                                                                                    \
+        if (corte - lo < hi - corte) {                                              \
+            NOME##_quick_rec(v, lo, corte, limiar, profundidade);                   \
+            lo = corte;                                                             \
+        } else {                                                                    \
+            NOME##_quick_rec(v, corte, hi, limiar, profundidade);                   \
+            hi = corte;                                                             \
+        }                                                                           \
+    }                                                                               \
+    NOME##_insercao(v, lo, hi);                                                     \
+}                                                                                   \
+                                                                                    \
+static inline void NOME##_quick_sort(TIPO *v, size_t n, size_t limiar) {           \
+    if (n < 2) return;                                                              \
+    if (limiar < 2) limiar = 2;                                                     \
+    int profundidade = 0;                                                           \
+    for (size_t m = n; m > 1; m >>= 1) profundidade += 2;                           \
+    NOME##_quick_rec(v, 0, n, limiar, profundidade);                                \
+}
+
+#endif
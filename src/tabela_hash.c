@@ -0,0 +1,227 @@
+#include "tabela_hash.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Capacidade inicial (potência de dois)
+#define TABELA_CAPACIDADE_INICIAL 16
+
+typedef struct {
+    void* chave;
+    void* valor;
+    uint32_t hash;
+    uint32_t dist;  // Distância até a posição inicial + 1; 0: posição livre
+} EntradaHash;
+
+typedef struct {
+    EntradaHash* entradas;
+    int capacidade;  // Potência de dois
+    int n;
+    FuncaoHash hash;
+    FuncaoIgualdade igual;
+} stTabelaHash;
+
+// Espalha os bits baixos, que escolhem a posição, a partir do hash inteiro
+static inline uint32_t misturaHash(unsigned int h) {
+    uint32_t x = h;
+    x ^= x >> 16;
+    x *= 0x45d9f3bu;
+    x ^= x >> 16;
+    return x;
+}
+
+static EntradaHash* alocaEntradas(int capacidade) {
+    EntradaHash* e = calloc(capacidade, sizeof(EntradaHash));
+    if (e == NULL) {
+        printf("Erro de alocação para tabela hash\n");
+        exit(1);
+    }
+    return e;
+}
+
+// Coloca uma entrada que certamente não está na tabela, com Robin Hood
+static void colocaEntrada(stTabelaHash* t, EntradaHash e) {
+    uint32_t mascara = (uint32_t)t->capacidade - 1;
+    uint32_t p = e.hash & mascara;
+    e.dist = 1;
+
+    while (t->entradas[p].dist != 0) {
+        // Quem está mais perto de casa cede o lugar
+        if (t->entradas[p].dist < e.dist) {
+            EntradaHash tmp = t->entradas[p];
+            t->entradas[p] = e;
+            e = tmp;
+        }
+        p = (p + 1) & mascara;
+        e.dist++;
+    }
+    t->entradas[p] = e;
+}
+
+static void dobraCapacidade(stTabelaHash* t) {
+    EntradaHash* antigas = t->entradas;
+    int cap_antiga = t->capacidade;
+
+    t->capacidade *= 2;
+    t->entradas = alocaEntradas(t->capacidade);
+    for (int p = 0; p < cap_antiga; p++) {
+        if (antigas[p].dist != 0) colocaEntrada(t, antigas[p]);
+    }
+    free(antigas);
+}
+
+// Posição da chave, ou -1
+static int posicaoChave(const stTabelaHash* t, const void* chave) {
+    uint32_t h = misturaHash(t->hash(chave));
+    uint32_t mascara = (uint32_t)t->capacidade - 1;
+    uint32_t p = h & mascara;
+
+    for (uint32_t dist = 1; ; dist++) {
+        const EntradaHash* e = &t->entradas[p];
+        // Uma entrada mais perto de casa que a busca: a chave estaria antes dela
+        if (e->dist < dist) return -1;
+        if (e->hash == h && t->igual(e->chave, chave)) return (int)p;
+        p = (p + 1) & mascara;
+    }
+}
+
+TabelaHash criaTabelaHash(FuncaoHash hash, FuncaoIgualdade igual) {
+    if (hash == NULL || igual == NULL) return NULL;
+
+    stTabelaHash* t = malloc(sizeof(stTabelaHash));
+    if (t == NULL) {
+        printf("Erro de alocação para tabela hash\n");
+        exit(1);
+    }
+    t->capacidade = TABELA_CAPACIDADE_INICIAL;
+    t->entradas = alocaEntradas(t->capacidade);
+    t->n = 0;
+    t->hash = hash;
+    t->igual = igual;
+    return t;
+}
+
+void liberaTabelaHash(TabelaHash T) {
+    if (!T) return;
+
+    stTabelaHash* t = (stTabelaHash*)T;
+    free(t->entradas);
+    free(t);
+}
+
+bool insereTabelaHash(TabelaHash T, void* chave, void* valor) {
+    if (!T || !chave) return false;
+    stTabelaHash* t = (stTabelaHash*)T;
+
+    int p = posicaoChave(t, chave);
+    if (p >= 0) {
+        t->entradas[p].valor = valor;
+        return false;
+    }
+
+    // Ocupação máxima de 7/8: com Robin Hood as sondagens seguem curtas
+    if (8 * (t->n + 1) > 7 * t->capacidade) dobraCapacidade(t);
+
+    EntradaHash e = {chave, valor, misturaHash(t->hash(chave)), 0};
+    colocaEntrada(t, e);
+    t->n++;
+    return true;
+}
+
+void* buscaTabelaHash(TabelaHash T, const void* chave) {
+    if (!T || !chave) return NULL;
+    stTabelaHash* t = (stTabelaHash*)T;
+
+    int p = posicaoChave(t, chave);
+    return p >= 0 ? t->entradas[p].valor : NULL;
+}
+
+bool contemTabelaHash(TabelaHash T, const void* chave) {
+    if (!T || !chave) return false;
+    return posicaoChave((stTabelaHash*)T, chave) >= 0;
+}
+
+bool removeTabelaHash(TabelaHash T, const void* chave) {
+    if (!T || !chave) return false;
+    stTabelaHash* t = (stTabelaHash*)T;
+    uint32_t mascara = (uint32_t)t->capacidade - 1;
+
+    int pos = posicaoChave(t, chave);
+    if (pos < 0) return false;
+
+    // Desloca para trás as entradas seguintes que não estão em casa
+    uint32_t p = (uint32_t)pos;
+    uint32_t q = (p + 1) & mascara;
+    while (t->entradas[q].dist > 1) {
+        t->entradas[p] = t->entradas[q];
+        t->entradas[p].dist--;
+        p = q;
+        q = (q + 1) & mascara;
+    }
+    t->entradas[p].dist = 0;
+    t->entradas[p].chave = NULL;
+    t->entradas[p].valor = NULL;
+
+    t->n--;
+    return true;
+}
+
+int getTamanhoTabelaHash(TabelaHash T) {
+    if (!T) return 0;
+    return ((stTabelaHash*)T)->n;
+}
+
+void limpaTabelaHash(TabelaHash T) {
+    if (!T) return;
+    stTabelaHash* t = (stTabelaHash*)T;
+
+    memset(t->entradas, 0, t->capacidade * sizeof(EntradaHash));
+    t->n = 0;
+}
+
+void percorreTabelaHash(TabelaHash T, FuncaoVisitaHash visita, void* contexto) {
+    if (!T || !visita) return;
+    stTabelaHash* t = (stTabelaHash*)T;
+
+    for (int p = 0; p < t->capacidade; p++) {
+        if (t->entradas[p].dist != 0) {
+            visita(t->entradas[p].chave, t->entradas[p].valor, contexto);
+        }
+    }
+}
+
+/* ================= Funções de hash prontas ================= */
+
+unsigned int hashString(const void* chave) {
+    const unsigned char* s = chave;
+    uint32_t h = 2166136261u;
+    while (*s) {
+        h ^= *s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+bool igualString(const void* a, const void* b) {
+    return strcmp(a, b) == 0;
+}
+
+unsigned int hashPonteiro(const void* chave) {
+    uintptr_t p = (uintptr_t)chave;
+    // Os bits baixos de um endereço alinhado são sempre zero
+    return (unsigned int)((p >> 4) ^ ((uint64_t)p >> 32));
+}
+
+bool igualPonteiro(const void* a, const void* b) {
+    return a == b;
+}
+
+unsigned int hashInteiro(const void* chave) {
+    return (unsigned int)*(const int*)chave * 2654435769u;
+}
+
+bool igualInteiro(const void* a, const void* b) {
+    return *(const int*)a == *(const int*)b;
+}
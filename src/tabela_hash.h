@@ -0,0 +1,166 @@
+#ifndef TABELA_HASH_H
+#define TABELA_HASH_H
+
+#include <stdbool.h>
+
+/**
+ * @file tabela_hash.h
+ * @brief Tabela hash genérica de chave para valor, com endereçamento aberto.
+ *
+ * Os pares ficam num único vetor de capacidade potência de dois, sondado
+ * linearmente com a política Robin Hood: na inserção, uma entrada que está
+ * mais longe da sua posição inicial toma o lugar de uma que está mais perto.
+ * Isso mantém as sequências de sondagem curtas e permite parar uma busca
+ * malsucedida cedo. A remoção desloca as entradas seguintes para trás, sem
+ * deixar marcas de apagado.
+ *
+ * A tabela guarda apenas os ponteiros de chave e valor; quem os aloca é
+ * responsável por liberá-los.
+ */
+
+/**
+ * @brief Tipo opaco para representar a tabela.
+ */
+typedef void* TabelaHash;
+
+/**
+ * @brief Tipo de função de hash de uma chave.
+ *
+ * @param chave Chave.
+ * @return Hash da chave. Chaves iguais devem ter o mesmo hash.
+ */
+typedef unsigned int (*FuncaoHash)(const void* chave);
+
+/**
+ * @brief Tipo de função de igualdade entre chaves.
+ *
+ * @param a Primeira chave.
+ * @param b Segunda chave.
+ * @return true se as chaves são iguais.
+ */
+typedef bool (*FuncaoIgualdade)(const void* a, const void* b);
+
+/**
+ * @brief Tipo de função chamada para cada par em percorreTabelaHash().
+ *
+ * @param chave Chave do par.
+ * @param valor Valor do par.
+ * @param contexto Contexto passado a percorreTabelaHash().
+ */
+typedef void (*FuncaoVisitaHash)(void* chave, void* valor, void* contexto);
+
+/**
+ * @brief Cria uma tabela vazia.
+ *
+ * @param hash Função de hash das chaves.
+ * @param igual Função de igualdade das chaves.
+ * @return Tabela criada, ou NULL se alguma função for NULL.
+ */
+TabelaHash criaTabelaHash(FuncaoHash hash, FuncaoIgualdade igual);
+
+/**
+ * @brief Libera a tabela (chaves e valores não são liberados).
+ *
+ * @param t Tabela a ser liberada.
+ */
+void liberaTabelaHash(TabelaHash t);
+
+/**
+ * @brief Associa o valor à chave. O(1) amortizado.
+ *
+ * Se a chave já está na tabela, só o valor é trocado e a chave guardada
+ * continua a mesma.
+ *
+ * @param t Tabela.
+ * @param chave Chave (não pode ser NULL).
+ * @param valor Valor.
+ * @return true se a chave era nova.
+ */
+bool insereTabelaHash(TabelaHash t, void* chave, void* valor);
+
+/**
+ * @brief Busca o valor associado à chave. O(1) esperado.
+ *
+ * @param t Tabela.
+ * @param chave Chave procurada.
+ * @return O valor, ou NULL se a chave não estiver na tabela.
+ */
+void* buscaTabelaHash(TabelaHash t, const void* chave);
+
+/**
+ * @brief Verifica se a chave está na tabela (útil quando o valor pode ser NULL).
+ *
+ * @param t Tabela.
+ * @param chave Chave procurada.
+ * @return true se a chave está na tabela.
+ */
+bool contemTabelaHash(TabelaHash t, const void* chave);
+
+/**
+ * @brief Remove a chave e seu valor. O(1) esperado.
+ *
+ * @param t Tabela.
+ * @param chave Chave a ser removida.
+ * @return true se a chave estava na tabela.
+ */
+bool removeTabelaHash(TabelaHash t, const void* chave);
+
+/**
+ * @brief Número de pares na tabela.
+ *
+ * @param t Tabela.
+ * @return Número de pares.
+ */
+int getTamanhoTabelaHash(TabelaHash t);
+
+/**
+ * @brief Remove todos os pares, mantendo a capacidade alocada.
+ *
+ * @param t Tabela.
+ */
+void limpaTabelaHash(TabelaHash t);
+
+/**
+ * @brief Chama `visita` para cada par, em ordem arbitrária.
+ *
+ * A tabela não deve ser alterada durante o percurso.
+ *
+ * @param t Tabela.
+ * @param visita Função chamada para cada par.
+ * @param contexto Repassado a `visita`.
+ */
+void percorreTabelaHash(TabelaHash t, FuncaoVisitaHash visita, void* contexto);
+
+/* ================= Funções de hash prontas ================= */
+
+/**
+ * @brief Hash de uma string terminada em '\0' (FNV-1a).
+ */
+unsigned int hashString(const void* chave);
+
+/**
+ * @brief Igualdade de strings (strcmp).
+ */
+bool igualString(const void* a, const void* b);
+
+/**
+ * @brief Hash do próprio endereço da chave.
+ */
+unsigned int hashPonteiro(const void* chave);
+
+/**
+ * @brief Igualdade de endereços.
+ */
+bool igualPonteiro(const void* a, const void* b);
+
+/**
+ * @brief Hash de um int apontado pela chave.
+ */
+unsigned int hashInteiro(const void* chave);
+
+/**
+ * @brief Igualdade dos ints apontados pelas chaves.
+ */
+bool igualInteiro(const void* a, const void* b);
+
+#endif
@@ -0,0 +1,281 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "../src/sort.h"
+#include "../src/sort_tipado.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+
+/*
+ * Benchmark dos algoritmos de sort.c, e das versões tipadas de sort_tipado.h
+ * usadas por -to m|q, sobre vértices sintéticos com a mesma ordem da
+ * varredura angular (ângulo crescente, distância decrescente, INICIO antes
+ * de FIM).
+ *
+ * Para cada distribuição, tamanho e limiar de inserção (-i), mede:
+ * - comparações feitas (rodada separada com comparador contador);
+ * - alocações feitas pelo algoritmo (malloc interceptado com --wrap);
+ * - ns por elemento (melhor de várias repetições, comparador sem contador).
+ *
+ * Uso: ./bench_sort [n_max] [limiar ...]
+ */
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define EPSILON 1e-9
+#define N_MAX_PADRAO 100000
+#define N_MAX_INSERCAO 10000  // Insertion sort é O(n^2); acima disso fica de fora
+#define MAX_LIMIARES 16
+
+typedef struct {
+    float ang;
+    float dist;
+    int tipo;   // 0 = INICIO, 1 = FIM
+    int id;
+} VerticeBench;
+
+/* ================= Contadores ================= */
+
+static unsigned long long n_comparacoes = 0;
+static unsigned long long n_alocacoes = 0;
+static unsigned long long bytes_alocados = 0;
+
+void *__real_malloc(size_t size);
+
+void *__wrap_malloc(size_t size) {
+    n_alocacoes++;
+    bytes_alocados += size;
+    return __real_malloc(size);
+}
+
+static int cmpVertices(const void *a, const void *b) {
+    const VerticeBench *va = a;
+    const VerticeBench *vb = b;
+
+    if (va->ang < vb->ang - EPSILON) return -1;
+    if (va->ang > vb->ang + EPSILON) return 1;
+
+    if (va->dist > vb->dist + EPSILON) return -1;
+    if (va->dist < vb->dist - EPSILON) return 1;
+
+    return va->tipo - vb->tipo;
+}
+
+static int cmpVerticesContando(const void *a, const void *b) {
+    n_comparacoes++;
+    return cmpVertices(a, b);
+}
+
+// Mesmas instâncias de visibilidade.c; a segunda conta as comparações
+#define VERTICE_MENOR(a, b) (cmpVertices((a), (b)) < 0)
+#define VERTICE_MENOR_CONTANDO(a, b) (cmpVerticesContando((a), (b)) < 0)
+SORT_TIPADO(vertices, VerticeBench, VERTICE_MENOR)
+SORT_TIPADO(vertices_contando, VerticeBench, VERTICE_MENOR_CONTANDO)
+
+/* ================= Distribuições ================= */
+
+typedef enum { UNIFORME, AGRUPADA, ORDENADA, ANGULOS_IGUAIS, N_DISTRIBUICOES } Distribuicao;
+
+static const char *nome_distribuicao[] = { "uniforme", "agrupada", "ordenada", "ang_iguais" };
+
+static double aleatorio01(void) {
+    return rand() / ((double)RAND_MAX + 1.0);
+}
+
+static void gera_vertices(VerticeBench *v, size_t n, Distribuicao d) {
+    srand(1234);
+    for (size_t i = 0; i < n; i++) {
+        double ang;
+        switch (d) {
+            case AGRUPADA: {
+                // Oito feixes estreitos, como anteparos concentrados em poucos quarteirões
+                int feixe = rand() % 8;
+                ang = -M_PI + (feixe + 0.5) * (2 * M_PI / 8) + (aleatorio01() - 0.5) * 0.05;
+                break;
+            }
+            case ANGULOS_IGUAIS:
+                // Apenas 16 ângulos distintos: o desempate por distância e tipo domina
+                ang = -M_PI + (rand() % 16) * (2 * M_PI / 16);
+                break;
+            case ORDENADA:
+                ang = -M_PI + 2 * M_PI * (double)i / (double)n;
+                break;
+            default:
+                ang = -M_PI + 2 * M_PI * aleatorio01();
+                break;
+        }
+        v[i].ang = (float)ang;
+        v[i].dist = (float)(1.0 + 1000.0 * aleatorio01());
+        v[i].tipo = rand() % 2;
+        v[i].id = (int)i;
+    }
+    if (d == ORDENADA) {
+        merge_sort(v, n, sizeof(VerticeBench), cmpVertices);
+    }
+}
+
+/* ================= Algoritmos ================= */
+
+typedef enum {
+    INSERCAO, MERGE, QUICK, MERGE_TIPADO, QUICK_TIPADO, MERGE_PARALELO, RADIX, N_ALGORITMOS
+} Algoritmo;
+
+static const char *nome_algoritmo[] = {
+    "insertion", "merge", "quick", "merge_tip", "quick_tip", "merge_par", "radix"
+};
+
+static uint32_t float_ordenavel(float f) {
+    f += 0.0f;
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+}
+
+// Mesma chave usada pela opção -to r em visibilidade.c
+static uint64_t chave_vertice(const VerticeBench *v) {
+    uint32_t dist;
+    float d = v->dist + 0.0f;
+    memcpy(&dist, &d, sizeof(dist));
+    dist = 0x7FFFFFFFu - (dist & 0x7FFFFFFFu);
+    return ((uint64_t)float_ordenavel(v->ang) << 32) | ((uint64_t)dist << 1) | (uint64_t)(v->tipo != 0);
+}
+
+static void ordena_radix(VerticeBench *v, size_t n) {
+    ChaveRadix *chaves = malloc(n * sizeof(ChaveRadix));
+    VerticeBench *ordenados = malloc(n * sizeof(VerticeBench));
+    for (size_t i = 0; i < n; i++) {
+        chaves[i].chave = chave_vertice(&v[i]);
+        chaves[i].indice = i;
+    }
+    radix_sort_chaves(chaves, n);
+    for (size_t i = 0; i < n; i++) {
+        ordenados[i] = v[chaves[i].indice];
+    }
+    memcpy(v, ordenados, n * sizeof(VerticeBench));
+    free(chaves);
+    free(ordenados);
+}
+
+static void executa(Algoritmo a, VerticeBench *v, size_t n, size_t limiar,
+                    int (*compar)(const void *, const void *)) {
+    switch (a) {
+        case INSERCAO:       insertion_sort(v, n, sizeof(VerticeBench), compar); break;
+        case MERGE:          merge_sort_limiar(v, n, sizeof(VerticeBench), compar, limiar); break;
+        case QUICK:          quick_sort_limiar(v, n, sizeof(VerticeBench), compar, limiar); break;
+        case MERGE_TIPADO:
+            if (compar == cmpVerticesContando) vertices_contando_merge_sort(v, n, limiar);
+            else vertices_merge_sort(v, n, limiar);
+            break;
+        case QUICK_TIPADO:
+            if (compar == cmpVerticesContando) vertices_contando_quick_sort(v, n, limiar);
+            else vertices_quick_sort(v, n, limiar);
+            break;
+        case MERGE_PARALELO: merge_sort_paralelo(v, n, sizeof(VerticeBench), compar, limiar, 0); break;
+        case RADIX:          ordena_radix(v, n); break;
+        default: break;
+    }
+}
+
+static int usa_limiar(Algoritmo a) {
+    return a == MERGE || a == QUICK || a == MERGE_TIPADO || a == QUICK_TIPADO || a == MERGE_PARALELO;
+}
+
+static double agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int confere_ordem(const VerticeBench *v, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        if (cmpVertices(&v[i - 1], &v[i]) > 0) return 0;
+    }
+    return 1;
+}
+
+static void mede(Algoritmo a, Distribuicao d, const VerticeBench *original, VerticeBench *trabalho,
+                 size_t n, size_t limiar) {
+    // Comparações e alocações: uma rodada com o comparador contador
+    memcpy(trabalho, original, n * sizeof(VerticeBench));
+    n_comparacoes = 0;
+    n_alocacoes = 0;
+    bytes_alocados = 0;
+    executa(a, trabalho, n, limiar, cmpVerticesContando);
+    unsigned long long comparacoes = n_comparacoes;
+    unsigned long long alocacoes = n_alocacoes;
+    unsigned long long bytes = bytes_alocados;
+    int ok = confere_ordem(trabalho, n);
+
+    // Tempo: melhor de algumas repetições, sem o custo do contador
+    int repeticoes = n <= 10000 ? 20 : (n <= 100000 ? 5 : 2);
+    double melhor = -1;
+    for (int r = 0; r < repeticoes; r++) {
+        memcpy(trabalho, original, n * sizeof(VerticeBench));
+        double t0 = agora_ns();
+        executa(a, trabalho, n, limiar, cmpVertices);
+        double t = agora_ns() - t0;
+        if (melhor < 0 || t < melhor) melhor = t;
+    }
+
+    char limiar_str[16];
+    if (usa_limiar(a)) snprintf(limiar_str, sizeof(limiar_str), "%zu", limiar);
+    else snprintf(limiar_str, sizeof(limiar_str), "-");
+
+    printf("%-10s %-11s %9zu %6s %14llu %6llu %12llu %10.2f %s\n",
+           nome_algoritmo[a], nome_distribuicao[d], n, limiar_str,
+           comparacoes, alocacoes, bytes, melhor / n, ok ? "" : "FORA DE ORDEM");
+}
+
+int main(int argc, char *argv[]) {
+    size_t n_max = N_MAX_PADRAO;
+    size_t limiares[MAX_LIMIARES] = { 4, 10, 16, 32 };
+    int n_limiares = 4;
+
+    if (argc > 1) {
+        n_max = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        n_limiares = 0;
+        for (int i = 2; i < argc && n_limiares < MAX_LIMIARES; i++) {
+            limiares[n_limiares++] = strtoul(argv[i], NULL, 10);
+        }
+    }
+
+    VerticeBench *original = malloc(n_max * sizeof(VerticeBench));
+    VerticeBench *trabalho = malloc(n_max * sizeof(VerticeBench));
+    if (!original || !trabalho) {
+        printf("Erro: sem memória para %zu vértices\n", n_max);
+        return 1;
+    }
+
+    printf("%-10s %-11s %9s %6s %14s %6s %12s %10s\n",
+           "algoritmo", "dist", "n", "lim", "comparacoes", "allocs", "bytes", "ns/elem");
+
+    for (size_t n = 1000; n <= n_max; n *= 10) {
+        for (int d = 0; d < N_DISTRIBUICOES; d++) {
+            gera_vertices(original, n, (Distribuicao)d);
+
+            for (int a = 0; a < N_ALGORITMOS; a++) {
+                if (a == INSERCAO && n > N_MAX_INSERCAO) continue;
+
+                if (usa_limiar((Algoritmo)a)) {
+                    for (int l = 0; l < n_limiares; l++) {
+                        mede((Algoritmo)a, (Distribuicao)d, original, trabalho, n, limiares[l]);
+                    }
+                } else {
+                    mede((Algoritmo)a, (Distribuicao)d, original, trabalho, n, 0);
+                }
+            }
+        }
+        printf("\n");
+    }
+
+    free(original);
+    free(trabalho);
+    return 0;
+}
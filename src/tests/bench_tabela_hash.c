@@ -0,0 +1,132 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "../src/tabela_hash.h"
+#include "../src/lista.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ * Benchmark da tabela hash contra a busca linear na Lista, que é o que o
+ * projeto fazia para achar uma forma pelo ID.
+ *
+ * Para cada tamanho n, mede em ns por operação:
+ * - inserção de n chaves inteiras;
+ * - busca bem-sucedida e malsucedida;
+ * - remoção de todas as chaves.
+ * A Lista só é medida até N_MAX_LISTA, pois cada busca nela é O(n).
+ *
+ * Uso: ./bench_tabela_hash [n_max]
+ */
+
+#define N_MAX_PADRAO 1000000
+#define N_MAX_LISTA 20000
+#define N_BUSCAS 200000
+
+static double agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Evita que o compilador descarte as buscas
+static volatile long sumidouro = 0;
+
+static void mede_tabela(const int* chaves, const int* ausentes, int n, int n_buscas) {
+    TabelaHash t = criaTabelaHash(hashInteiro, igualInteiro);
+
+    double t0 = agora_ns();
+    for (int i = 0; i < n; i++) insereTabelaHash(t, (void*)&chaves[i], (void*)&chaves[i]);
+    double insercao = (agora_ns() - t0) / n;
+
+    t0 = agora_ns();
+    for (int i = 0; i < n_buscas; i++) {
+        int* v = buscaTabelaHash(t, &chaves[(i * 7919) % n]);
+        sumidouro += *v;
+    }
+    double acerto = (agora_ns() - t0) / n_buscas;
+
+    t0 = agora_ns();
+    for (int i = 0; i < n_buscas; i++) {
+        sumidouro += buscaTabelaHash(t, &ausentes[i % n]) != NULL;
+    }
+    double erro = (agora_ns() - t0) / n_buscas;
+
+    t0 = agora_ns();
+    for (int i = 0; i < n; i++) removeTabelaHash(t, &chaves[i]);
+    double remocao = (agora_ns() - t0) / n;
+
+    printf("%-8s %9d %10.1f %10.1f %10.1f %10.1f\n", "hash", n, insercao, acerto, erro, remocao);
+    liberaTabelaHash(t);
+}
+
+static int* busca_lista(Lista l, int chave) {
+    for (Celula c = getInicioLista(l); c; c = getProxCelula(c)) {
+        int* v = getConteudoCelula(c);
+        if (*v == chave) return v;
+    }
+    return NULL;
+}
+
+static void mede_lista(const int* chaves, const int* ausentes, int n, int n_buscas) {
+    Lista l = criaLista();
+
+    double t0 = agora_ns();
+    for (int i = 0; i < n; i++) insereFinalLista(l, (void*)&chaves[i]);
+    double insercao = (agora_ns() - t0) / n;
+
+    t0 = agora_ns();
+    for (int i = 0; i < n_buscas; i++) {
+        int* v = busca_lista(l, chaves[(i * 7919) % n]);
+        sumidouro += *v;
+    }
+    double acerto = (agora_ns() - t0) / n_buscas;
+
+    t0 = agora_ns();
+    for (int i = 0; i < n_buscas; i++) {
+        sumidouro += busca_lista(l, ausentes[i % n]) != NULL;
+    }
+    double erro = (agora_ns() - t0) / n_buscas;
+
+    t0 = agora_ns();
+    for (int i = 0; i < n; i++) removeElementoLista(l, (void*)&chaves[i]);
+    double remocao = (agora_ns() - t0) / n;
+
+    printf("%-8s %9d %10.1f %10.1f %10.1f %10.1f\n", "lista", n, insercao, acerto, erro, remocao);
+    liberaLista(l);
+}
+
+int main(int argc, char *argv[]) {
+    int n_max = N_MAX_PADRAO;
+    if (argc > 1) n_max = atoi(argv[1]);
+    if (n_max < 10) n_max = 10;
+
+    // IDs pares presentes, ímpares ausentes, em ordem embaralhada
+    int* chaves = malloc(n_max * sizeof(int));
+    int* ausentes = malloc(n_max * sizeof(int));
+    if (!chaves || !ausentes) {
+        printf("Erro: sem memória para %d chaves\n", n_max);
+        return 1;
+    }
+    srand(1234);
+    for (int i = 0; i < n_max; i++) {
+        chaves[i] = 2 * i;
+        ausentes[i] = 2 * i + 1;
+    }
+    for (int i = n_max - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int tmp = chaves[i]; chaves[i] = chaves[j]; chaves[j] = tmp;
+    }
+
+    printf("%-8s %9s %10s %10s %10s %10s\n", "estrut", "n", "ins_ns", "acerto_ns", "erro_ns", "rem_ns");
+    for (int n = 1000; n <= n_max; n *= 10) {
+        int n_buscas_lista = n <= 1000 ? 20000 : 2000;
+        if (n <= N_MAX_LISTA) mede_lista(chaves, ausentes, n, n_buscas_lista);
+        mede_tabela(chaves, ausentes, n, N_BUSCAS);
+        printf("\n");
+    }
+
+    free(chaves);
+    free(ausentes);
+    return 0;
+}
@@ -1,5 +1,8 @@
 #include "test_framework.h"
 #include "../src/anteparo.h"
+#include "../src/circulo.h"
+#include "../src/text_style.h"
+#include "../src/vetor.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -23,6 +26,60 @@ void teste_clonar_anteparo() {
     ASSERT_TRUE(1, "Testes de clonagem de anteparo requerem integração com forma");
 }
 
+/* Teste: Anteparo criado a partir de um círculo e guardado numa forma */
+void teste_anteparo_em_forma() {
+    Forma circulo = criaForma(CIRCLE, criaCirculo(1, 100, 50, 10, "red", "blue"));
+    ASSERT_EQUAL(1, getIDCirculo(getDataForma(circulo)), "Dados do círculo acessíveis pela forma");
+    
+    Forma f = criaForma(ANTEPARO, transforma_em_anteparo(circulo, 'h', 7));
+    Anteparo a = getDataForma(f);
+    ASSERT_EQUAL(7, getIDAnteparo(a), "Anteparo recebe o novo ID");
+    ASSERT_FLOAT_EQUAL(90.0, getX1Anteparo(a), 0.001, "Anteparo horizontal começa em x - r");
+    ASSERT_FLOAT_EQUAL(110.0, getX2Anteparo(a), 0.001, "Anteparo horizontal termina em x + r");
+    ASSERT_STR_EQUAL("blue", getCorAnteparo(a), "Anteparo herda a cor da borda");
+    
+    Forma clone = clonaForma(f, 8, 5, 5);
+    ASSERT_EQUAL(8, getIDForma(clone), "Clone recebe o novo ID");
+    ASSERT_FLOAT_EQUAL(95.0, getX1Anteparo(getDataForma(clone)), 0.001, "Clone é deslocado");
+    
+    setCorBForma(f, "green");
+    ASSERT_STR_EQUAL("green", getCorAnteparo(a), "Cor trocada pela forma");
+    
+    desalocaForma(clone);
+    desalocaForma(f);
+    desalocaForma(circulo);
+}
+
+/* Teste: Clones em lote compartilham um bloco e são liberados um a um */
+void teste_clonar_em_lote() {
+    Vetor originais = criaVetor(0);
+    insereFinalVetor(originais, criaForma(CIRCLE, criaCirculo(1, 100, 50, 10, "red", "blue")));
+    insereFinalVetor(originais, criaForma(TEXT_STYLE, criaTextStyle("sans", "n", 12)));
+    Forma base = criaForma(CIRCLE, criaCirculo(2, 0, 0, 5, "red", "black"));
+    insereFinalVetor(originais, criaForma(ANTEPARO, transforma_em_anteparo(base, 'v', 3)));
+    desalocaForma(base);
+    
+    Vetor clones = criaVetor(0);
+    int n = clonaFormasEmLote(originais, 10, 1, 2, clones);
+    ASSERT_EQUAL(2, n, "Estilo de texto não é clonado");
+    ASSERT_EQUAL(2, getTamanhoVetor(clones), "Clones inseridos na saída");
+    ASSERT_EQUAL(10, getIDForma(getElementoVetor(clones, 0)), "Primeiro clone com primeiro_id");
+    ASSERT_EQUAL(12, getIDForma(getElementoVetor(clones, 1)), "ID do estilo de texto fica sem uso");
+    ASSERT_FLOAT_EQUAL(101.0, getXCirculo(getDataForma(getElementoVetor(clones, 0))), 0.001, "Círculo deslocado");
+    ASSERT_FLOAT_EQUAL(-3.0, getY1Anteparo(getDataForma(getElementoVetor(clones, 1))), 0.001, "Anteparo deslocado");
+    
+    // Os clones têm cores próprias: liberar os originais não os afeta
+    while (!vetorVazio(originais)) desalocaForma(removeFinalVetor(originais));
+    ASSERT_STR_EQUAL("blue", getCorBCirculo(getDataForma(getElementoVetor(clones, 0))), "Cor copiada");
+    setCorBForma(getElementoVetor(clones, 1), "green");
+    ASSERT_STR_EQUAL("green", getCorAnteparo(getDataForma(getElementoVetor(clones, 1))), "Cor trocada no clone");
+    
+    desalocaForma(getElementoVetor(clones, 0));
+    desalocaForma(getElementoVetor(clones, 1));
+    liberaVetor(clones);
+    liberaVetor(originais);
+}
+
 int main() {
     RESETAR_ESTATISTICAS();
     
@@ -30,6 +87,8 @@ int main() {
     EXECUTAR_TESTE(teste_criar_destruir_anteparo);
     EXECUTAR_TESTE(teste_anteparo_getters);
     EXECUTAR_TESTE(teste_clonar_anteparo);
+    EXECUTAR_TESTE(teste_anteparo_em_forma);
+    EXECUTAR_TESTE(teste_clonar_em_lote);
     
     IMPRIMIR_RESUMO_TESTES("Módulo Anteparo");
     
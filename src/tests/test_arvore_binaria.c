@@ -158,12 +158,137 @@ void teste_arvore_para_array() {
     liberaArvoreBinaria(arvore, free);
 }
 
+/* Teste: Percorrer em ordem nos dois sentidos pelos nós */
+void teste_iterador_em_ordem() {
+    ArvoreBinaria arvore = criaArvoreBinaria(comparar_ints, NULL);
+    
+    // Inserção numa ordem embaralhada: 7 * i mod 101 percorre 0..100
+    for (int i = 0; i < 101; i++) {
+        insereArvoreBinaria(arvore, criar_int((7 * i) % 101));
+    }
+    
+    int esperado = 0, erros = 0;
+    for (NoArvore no = getMenorNo(arvore); no; no = getProximoNo(no)) {
+        if (*(int*)getDadoNo(no) != esperado) erros++;
+        esperado++;
+    }
+    ASSERT_EQUAL(0, erros, "Sucessores devem vir em ordem crescente");
+    ASSERT_EQUAL(101, esperado, "Todos os elementos devem ser visitados");
+    
+    esperado = 100;
+    erros = 0;
+    for (NoArvore no = getMaiorNo(arvore); no; no = getAnteriorNo(no)) {
+        if (*(int*)getDadoNo(no) != esperado) erros++;
+        esperado--;
+    }
+    ASSERT_EQUAL(0, erros, "Predecessores devem vir em ordem decrescente");
+    ASSERT_EQUAL(-1, esperado, "Todos os elementos devem ser visitados de trás para frente");
+    
+    liberaArvoreBinaria(arvore, free);
+}
+
+/* Teste: Percorrer uma faixa [inicio, fim] pelos limites */
+void teste_iterador_faixa() {
+    ArvoreBinaria arvore = criaArvoreBinaria(comparar_ints, NULL);
+    
+    // Pares de 0 a 98, com o 40 repetido
+    for (int i = 0; i < 50; i++) {
+        insereArvoreBinaria(arvore, criar_int((37 * i) % 50 * 2));
+    }
+    insereArvoreBinaria(arvore, criar_int(40));
+    
+    int inicio = 31, fim = 48;
+    NoArvore fim_faixa = getPrimeiroNoMaior(arvore, &fim);
+    int soma = 0, visitados = 0;
+    for (NoArvore no = getPrimeiroNoMaiorOuIgual(arvore, &inicio); no != fim_faixa;
+         no = getProximoNo(no)) {
+        soma += *(int*)getDadoNo(no);
+        visitados++;
+    }
+    // 32, 34, 36, 38, 40, 40, 42, 44, 46, 48
+    ASSERT_EQUAL(10, visitados, "Faixa deve ter 10 elementos");
+    ASSERT_EQUAL(400, soma, "Faixa deve ter os pares de 32 a 48 e o 40 repetido");
+    
+    int chave = 40;
+    NoArvore no = getPrimeiroNoMaiorOuIgual(arvore, &chave);
+    ASSERT_EQUAL(40, *(int*)getDadoNo(no), "Limite inferior exato");
+    ASSERT_EQUAL(40, *(int*)getDadoNo(getProximoNo(no)), "Repetido vem em seguida");
+    ASSERT_EQUAL(42, *(int*)getDadoNo(getPrimeiroNoMaior(arvore, &chave)), "Limite superior pula os repetidos");
+    
+    chave = -5;
+    ASSERT_TRUE(getPrimeiroNoMaiorOuIgual(arvore, &chave) == getMenorNo(arvore), "Chave abaixo de todos dá o menor");
+    chave = 98;
+    ASSERT_NULL(getPrimeiroNoMaior(arvore, &chave), "Nenhum elemento maior que o máximo");
+    chave = 99;
+    ASSERT_NULL(getPrimeiroNoMaiorOuIgual(arvore, &chave), "Chave acima de todos não tem limite");
+    
+    liberaArvoreBinaria(arvore, free);
+}
+
+/* Teste: Árvore com pool de nós se comporta como a comum e reaproveita os nós */
+void teste_arvore_com_pool() {
+    // Blocos pequenos para forçar vários blocos
+    ArvoreBinaria arvore = criaArvoreBinariaComPool(comparar_ints, NULL, 4);
+    int valores[50];
+    NoArvore nos[50];
+    
+    for (int i = 0; i < 50; i++) {
+        valores[i] = (13 * i) % 50;
+        nos[i] = insereArvoreBinaria(arvore, &valores[i]);
+    }
+    ASSERT_EQUAL(50, tamanhoArvore(arvore), "Árvore com pool deve ter 50 elementos");
+    
+    // Remove os ímpares: os nós vão para a lista livre
+    for (int i = 0; i < 50; i++) {
+        if (valores[i] % 2 == 1) removeNoArvore(arvore, nos[i]);
+    }
+    int esperado = 0, erros = 0;
+    for (NoArvore no = getMenorNo(arvore); no; no = getProximoNo(no)) {
+        if (*(int*)getDadoNo(no) != esperado) erros++;
+        esperado += 2;
+    }
+    ASSERT_EQUAL(0, erros, "Restam os pares, em ordem");
+    ASSERT_EQUAL(25, tamanhoArvore(arvore), "Árvore deve ter 25 elementos");
+    
+    // Um nó removido é reaproveitado pela próxima inserção
+    removeNoArvore(arvore, nos[0]);
+    ASSERT_TRUE(insereArvoreBinaria(arvore, &valores[0]) == nos[0], "Nó removido deve ser reaproveitado");
+    
+    // Depois de limpar, os nós voltam a sair do primeiro bloco
+    limpaArvoreBinaria(arvore, NULL);
+    ASSERT_TRUE(arvoreVazia(arvore), "Árvore limpa deve estar vazia");
+    erros = 0;
+    for (int i = 0; i < 50; i++) {
+        NoArvore no = insereArvoreBinaria(arvore, &valores[i]);
+        if (no != nos[i]) erros++;
+    }
+    ASSERT_EQUAL(0, erros, "Árvore limpa deve reusar os mesmos nós, na mesma ordem");
+    ASSERT_EQUAL(49, *(int*)getMaiorElemento(arvore), "Árvore reaproveitada continua ordenada");
+    
+    liberaArvoreBinaria(arvore, NULL);
+}
+
+/* Teste: Limpar árvore com pool desalocando os dados */
+void teste_pool_limpa_com_dados() {
+    ArvoreBinaria arvore = criaArvoreBinariaComPool(comparar_ints, NULL, 0);
+    for (int i = 0; i < 300; i++) insereArvoreBinaria(arvore, criar_int(i));
+    
+    limpaArvoreBinaria(arvore, free);
+    ASSERT_EQUAL(0, tamanhoArvore(arvore), "Árvore limpa deve ter tamanho 0");
+    
+    insereArvoreBinaria(arvore, criar_int(7));
+    ASSERT_EQUAL(7, *(int*)getMenorElemento(arvore), "Árvore limpa continua utilizável");
+    
+    liberaArvoreBinaria(arvore, free);
+}
+
 /* Teste: Operações em árvore vazia */
 void teste_operacoes_arvore_vazia() {
     ArvoreBinaria arvore = criaArvoreBinaria(comparar_ints, NULL);
     
     ASSERT_NULL(getMenorElemento(arvore), "Mínimo de árvore vazia deve ser NULL");
     ASSERT_NULL(getMaiorElemento(arvore), "Máximo de árvore vazia deve ser NULL");
+    ASSERT_NULL(getMaiorNo(arvore), "Árvore vazia não tem último nó");
     
     int valor_busca = 10;
     ASSERT_NULL(buscaArvoreBinaria(arvore, &valor_busca), "Busca em árvore vazia deve retornar NULL");
@@ -206,6 +331,10 @@ int main() {
     EXECUTAR_TESTE(teste_min_max);
     EXECUTAR_TESTE(teste_remover_elementos);
     EXECUTAR_TESTE(teste_arvore_para_array);
+    EXECUTAR_TESTE(teste_iterador_em_ordem);
+    EXECUTAR_TESTE(teste_iterador_faixa);
+    EXECUTAR_TESTE(teste_arvore_com_pool);
+    EXECUTAR_TESTE(teste_pool_limpa_com_dados);
     EXECUTAR_TESTE(teste_operacoes_arvore_vazia);
     EXECUTAR_TESTE(teste_altura_arvore);
     
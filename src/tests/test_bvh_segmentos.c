@@ -0,0 +1,95 @@
+#include "test_framework.h"
+#include "../src/bvh_segmentos.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+/* Auxiliar: Segmentos curtos aleatórios num quadrado de lado 1000 */
+static SegmentoPlano* segmentos_aleatorios(int n, unsigned semente) {
+    SegmentoPlano* s = malloc(n * sizeof(SegmentoPlano));
+    srand(semente);
+    for (int i = 0; i < n; i++) {
+        s[i].x1 = rand() % 1000;
+        s[i].y1 = rand() % 1000;
+        s[i].x2 = s[i].x1 + (rand() % 81) - 40;
+        s[i].y2 = s[i].y1 + (rand() % 81) - 40;
+    }
+    return s;
+}
+
+/* Auxiliar: Cruzamento próprio por força bruta */
+static double orient(double ax, double ay, double bx, double by, double cx, double cy) {
+    return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+static bool bloqueado_forca_bruta(const SegmentoPlano* segs, int n,
+                                  float ax, float ay, float bx, float by) {
+    for (int i = 0; i < n; i++) {
+        double d1 = orient(ax, ay, bx, by, segs[i].x1, segs[i].y1);
+        double d2 = orient(ax, ay, bx, by, segs[i].x2, segs[i].y2);
+        double d3 = orient(segs[i].x1, segs[i].y1, segs[i].x2, segs[i].y2, ax, ay);
+        double d4 = orient(segs[i].x1, segs[i].y1, segs[i].x2, segs[i].y2, bx, by);
+        if (d1 * d2 < 0 && d3 * d4 < 0) return true;
+    }
+    return false;
+}
+
+/* Teste: Consulta pela hierarquia concorda com o teste contra todos */
+void teste_bloqueio_equivale_forca_bruta() {
+    int n = 800;
+    SegmentoPlano* segs = segmentos_aleatorios(n, 5);
+    BVHSegmentos b = criaBVHSegmentos(segs, n);
+    ASSERT_NOT_NULL(b, "Hierarquia deve ser criada");
+
+    int discordancias = 0, bloqueados = 0;
+    srand(41);
+    for (int i = 0; i < 3000; i++) {
+        float ax = rand() % 1000, ay = rand() % 1000;
+        // Metade das consultas curtas, metade atravessando a cena
+        float alcance = (i % 2) ? 60 : 1000;
+        float bx = ax + (rand() % (int)(2 * alcance + 1)) - alcance;
+        float by = ay + (rand() % (int)(2 * alcance + 1)) - alcance;
+
+        bool esperado = bloqueado_forca_bruta(segs, n, ax, ay, bx, by);
+        if (esperado) bloqueados++;
+        if (segmentoBloqueadoBVH(b, segs, ax, ay, bx, by) != esperado) discordancias++;
+    }
+
+    printf("    3000 consultas, %d bloqueadas, %d discordâncias\n", bloqueados, discordancias);
+    ASSERT_TRUE(bloqueados > 0 && bloqueados < 3000, "Deve haver consultas livres e bloqueadas");
+    ASSERT_EQUAL(0, discordancias, "Hierarquia deve concordar com a força bruta");
+
+    liberaBVHSegmentos(b);
+    free(segs);
+}
+
+/* Teste: Encostar na extremidade ou correr colinear não bloqueia */
+void teste_toque_nao_bloqueia() {
+    SegmentoPlano segs[2] = {{10, -10, 10, 10}, {20, 0, 30, 0}};
+    BVHSegmentos b = criaBVHSegmentos(segs, 2);
+
+    ASSERT_TRUE(segmentoBloqueadoBVH(b, segs, 0, 0, 15, 0), "Cruzamento próprio bloqueia");
+    ASSERT_FALSE(segmentoBloqueadoBVH(b, segs, 0, 0, 10, 0), "Terminar sobre o anteparo não bloqueia");
+    ASSERT_FALSE(segmentoBloqueadoBVH(b, segs, 0, 10, 20, 10), "Passar pela extremidade não bloqueia");
+    ASSERT_FALSE(segmentoBloqueadoBVH(b, segs, 15, 0, 40, 0), "Segmento colinear não bloqueia");
+    ASSERT_FALSE(segmentoBloqueadoBVH(b, segs, 0, 20, 40, 20), "Segmento longe não bloqueia");
+
+    liberaBVHSegmentos(b);
+}
+
+/* Teste: Sem segmentos não há hierarquia nem bloqueio */
+void teste_bvh_vazia() {
+    ASSERT_NULL(criaBVHSegmentos(NULL, 0), "Sem segmentos não há hierarquia");
+    ASSERT_FALSE(segmentoBloqueadoBVH(NULL, NULL, 0, 0, 1, 1), "Hierarquia nula não bloqueia");
+}
+
+int main() {
+    RESETAR_ESTATISTICAS();
+
+    EXECUTAR_TESTE(teste_bloqueio_equivale_forca_bruta);
+    EXECUTAR_TESTE(teste_toque_nao_bloqueia);
+    EXECUTAR_TESTE(teste_bvh_vazia);
+
+    IMPRIMIR_RESUMO_TESTES("Módulo BVH de Segmentos");
+
+    return CODIGO_SAIDA_TESTE();
+}
@@ -0,0 +1,136 @@
+#include "test_framework.h"
+#include "../src/colunas_formas.h"
+#include "../src/vetor.h"
+#include "../src/forma.h"
+#include "../src/poligono.h"
+#include "../src/circulo.h"
+#include "../src/retangulo.h"
+#include "../src/linha.h"
+#include "../src/texto.h"
+#include "../src/text_style.h"
+#include "../src/anteparo.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+/* Auxiliar: Forma aleatória de qualquer tipo */
+static Forma forma_aleatoria(int id) {
+    float x = rand() % 1000;
+    float y = rand() % 1000;
+    switch (rand() % 6) {
+        case 0:
+            return criaForma(CIRCLE, criaCirculo(id, x, y, 1 + rand() % 40, "red", "blue"));
+        case 1:
+            return criaForma(RECTANGLE, criaRetangulo(id, x, y, 1 + rand() % 60, 1 + rand() % 60, "red", "blue"));
+        case 2:
+            return criaForma(LINE, criaLinha(id, x, y, x + (rand() % 81) - 40, y + (rand() % 81) - 40, "black"));
+        case 3: {
+            Forma linha = criaForma(LINE, criaLinha(id, x, y, x + (rand() % 81) - 40, y, "black"));
+            Forma ant = criaForma(ANTEPARO, transforma_em_anteparo(linha, 'h', id));
+            desalocaForma(linha);
+            return ant;
+        }
+        case 4:
+            return criaForma(TEXT, criaTexto(id, x, y, "black", "black", 'i', "abc"));
+        default:
+            return criaForma(TEXT_STYLE, criaTextStyle("sans", "n", 12));
+    }
+}
+
+/* Auxiliar: Libera as formas do vetor e o vetor */
+static void libera_formas(Vetor formas) {
+    while (!vetorVazio(formas)) {
+        desalocaForma(removeFinalVetor(formas));
+    }
+    liberaVetor(formas);
+}
+
+/* Teste: Candidatas são as mesmas de getBBForma + haInterseccaoBB, cada uma uma vez */
+void teste_equivale_bounding_box() {
+    srand(11);
+    Vetor formas = criaVetor(0);
+    for (int i = 0; i < 600; i++) insereFinalVetor(formas, forma_aleatoria(i + 1));
+
+    ColunasFormas colunas = criaColunasFormas(formas);
+    ASSERT_TRUE(getNumFormasColunas(colunas) <= 600, "Estilos de texto ficam de fora");
+
+    int* saida = malloc(getNumFormasColunas(colunas) * sizeof(int));
+    int* vezes = malloc(getTamanhoVetor(formas) * sizeof(int));
+    int discordancias = 0;
+    for (int q = 0; q < 50; q++) {
+        float x0 = rand() % 1000, y0 = rand() % 1000;
+        float x1 = x0 + rand() % 300, y1 = y0 + rand() % 300;
+        int m = candidatasColunasFormas(colunas, x0, y0, x1, y1, saida);
+
+        for (int i = 0; i < getTamanhoVetor(formas); i++) vezes[i] = 0;
+        for (int k = 0; k < m; k++) {
+            vezes[saida[k]]++;
+            // Dentro de um tipo as posições crescem
+            if (k > 0 && saida[k] < saida[k - 1] &&
+                getTipoForma(getElementoVetor(formas, saida[k])) ==
+                getTipoForma(getElementoVetor(formas, saida[k - 1]))) {
+                discordancias++;
+            }
+        }
+
+        BoundingBox consulta = criaBoundingBox(x0, y0, x1, y1);
+        for (int i = 0; i < getTamanhoVetor(formas); i++) {
+            BoundingBox bb = getBBForma(getElementoVetor(formas, i));
+            if (vezes[i] != (haInterseccaoBB(consulta, bb) ? 1 : 0)) discordancias++;
+            liberaBoundingBox(bb);
+        }
+        liberaBoundingBox(consulta);
+    }
+    ASSERT_EQUAL(0, discordancias, "Colunas devem achar as mesmas formas, crescentes em cada tipo");
+
+    free(vezes);
+    free(saida);
+    liberaColunasFormas(colunas);
+    libera_formas(formas);
+}
+
+/* Teste: Encostar no retângulo de consulta conta como intersecção */
+void teste_borda_conta() {
+    Vetor formas = criaVetor(0);
+    insereFinalVetor(formas, criaForma(CIRCLE, criaCirculo(1, 0, 0, 10, "red", "red")));
+    insereFinalVetor(formas, criaForma(RECTANGLE, criaRetangulo(2, 20, 0, 5, 5, "red", "red")));
+    insereFinalVetor(formas, criaForma(LINE, criaLinha(3, 50, 50, 40, 60, "black")));
+
+    ColunasFormas colunas = criaColunasFormas(formas);
+    int saida[3];
+
+    ASSERT_EQUAL(2, candidatasColunasFormas(colunas, 10, 0, 20, 1, saida), "Círculo e retângulo encostam");
+    ASSERT_EQUAL(0, saida[0], "Círculo vem primeiro");
+    ASSERT_EQUAL(1, saida[1], "Retângulo vem depois");
+    ASSERT_EQUAL(1, candidatasColunasFormas(colunas, 30, 60, 40, 70, saida), "Ponta da linha encosta");
+    ASSERT_EQUAL(2, saida[0], "Linha achada");
+    ASSERT_EQUAL(0, candidatasColunasFormas(colunas, 100, 100, 200, 200, saida), "Nada longe das formas");
+
+    liberaColunasFormas(colunas);
+    libera_formas(formas);
+}
+
+/* Teste: Vetor vazio e colunas nulas */
+void teste_colunas_vazias() {
+    Vetor formas = criaVetor(0);
+    ColunasFormas colunas = criaColunasFormas(formas);
+    int saida[1];
+
+    ASSERT_EQUAL(0, getNumFormasColunas(colunas), "Sem formas, sem colunas");
+    ASSERT_EQUAL(0, candidatasColunasFormas(colunas, -1e9, -1e9, 1e9, 1e9, saida), "Nenhuma candidata");
+    ASSERT_EQUAL(0, candidatasColunasFormas(NULL, 0, 0, 1, 1, saida), "Colunas nulas não têm formas");
+
+    liberaColunasFormas(colunas);
+    liberaVetor(formas);
+}
+
+int main() {
+    RESETAR_ESTATISTICAS();
+
+    EXECUTAR_TESTE(teste_equivale_bounding_box);
+    EXECUTAR_TESTE(teste_borda_conta);
+    EXECUTAR_TESTE(teste_colunas_vazias);
+
+    IMPRIMIR_RESUMO_TESTES("Módulo Colunas de Formas");
+
+    return CODIGO_SAIDA_TESTE();
+}
@@ -0,0 +1,66 @@
+#include "test_framework.h"
+#include "../src/curva_hilbert.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+/* Teste: Grade 2 x 2 na ordem clássica (0,0) (0,1) (1,1) (1,0) */
+void teste_ordem_um() {
+    ASSERT_EQUAL(0, (int)indiceHilbert(0, 0, 1), "Primeira célula");
+    ASSERT_EQUAL(1, (int)indiceHilbert(0, 1, 1), "Segunda célula");
+    ASSERT_EQUAL(2, (int)indiceHilbert(1, 1, 1), "Terceira célula");
+    ASSERT_EQUAL(3, (int)indiceHilbert(1, 0, 1), "Quarta célula");
+}
+
+/* Teste: Cada posição da curva aparece uma vez e liga células vizinhas */
+void teste_bijecao_e_vizinhanca() {
+    int ordem = 5;
+    int lado = 1 << ordem;
+    int n = lado * lado;
+    int* cel_x = malloc(n * sizeof(int));
+    int* cel_y = malloc(n * sizeof(int));
+    bool* vista = calloc(n, sizeof(bool));
+
+    int fora = 0, repetidas = 0;
+    for (int x = 0; x < lado; x++) {
+        for (int y = 0; y < lado; y++) {
+            uint64_t d = indiceHilbert(x, y, ordem);
+            if (d >= (uint64_t)n) { fora++; continue; }
+            if (vista[d]) repetidas++;
+            vista[d] = true;
+            cel_x[d] = x;
+            cel_y[d] = y;
+        }
+    }
+    ASSERT_EQUAL(0, fora, "Posições dentro de [0, 4^ordem)");
+    ASSERT_EQUAL(0, repetidas, "Nenhuma posição repetida");
+
+    int saltos = 0;
+    for (int d = 1; d < n; d++) {
+        int dist = abs(cel_x[d] - cel_x[d - 1]) + abs(cel_y[d] - cel_y[d - 1]);
+        if (dist != 1) saltos++;
+    }
+    ASSERT_EQUAL(0, saltos, "Posições consecutivas são células vizinhas");
+
+    free(cel_x);
+    free(cel_y);
+    free(vista);
+}
+
+/* Teste: Ordem máxima usa toda a faixa de 64 bits sem estourar */
+void teste_ordem_maxima() {
+    ASSERT_TRUE(indiceHilbert(0, 0, HILBERT_ORDEM_MAX) == 0, "Origem é o início da curva");
+    ASSERT_TRUE(indiceHilbert(UINT32_MAX, 0, HILBERT_ORDEM_MAX) == UINT64_MAX,
+                "Canto (máx, 0) é o fim da curva");
+}
+
+int main() {
+    RESETAR_ESTATISTICAS();
+
+    EXECUTAR_TESTE(teste_ordem_um);
+    EXECUTAR_TESTE(teste_bijecao_e_vizinhanca);
+    EXECUTAR_TESTE(teste_ordem_maxima);
+
+    IMPRIMIR_RESUMO_TESTES("Módulo Curva de Hilbert");
+
+    return CODIGO_SAIDA_TESTE();
+}
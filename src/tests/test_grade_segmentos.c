@@ -0,0 +1,147 @@
+#include "test_framework.h"
+#include "../src/grade_segmentos.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+/* Auxiliar: Segmentos curtos aleatórios num quadrado de lado 1000 */
+static SegmentoPlano* segmentos_aleatorios(int n, unsigned semente) {
+    SegmentoPlano* s = malloc(n * sizeof(SegmentoPlano));
+    srand(semente);
+    for (int i = 0; i < n; i++) {
+        s[i].x1 = rand() % 1000;
+        s[i].y1 = rand() % 1000;
+        s[i].x2 = s[i].x1 + (rand() % 81) - 40;
+        s[i].y2 = s[i].y1 + (rand() % 81) - 40;
+    }
+    return s;
+}
+
+/* Teste: Percorrendo todos os anéis cada segmento aparece exatamente uma vez */
+void teste_aneis_cobrem_todos() {
+    int n = 500;
+    SegmentoPlano* segs = segmentos_aleatorios(n, 3);
+    GradeSegmentos g = criaGradeSegmentos(segs, n);
+    ASSERT_NOT_NULL(g, "Grade deve ser criada");
+
+    int* saida = malloc(n * sizeof(int));
+    int* vezes = calloc(n, sizeof(int));
+    float pontos[3][2] = {{500, 500}, {0, 0}, {-300, 1500}};
+
+    for (int p = 0; p < 3; p++) {
+        for (int i = 0; i < n; i++) vezes[i] = 0;
+        iniciaConsultaGrade(g);
+        int aneis = getNumAneisGrade(g, pontos[p][0], pontos[p][1]);
+        for (int a = 0; a < aneis; a++) {
+            int m = segmentosDoAnel(g, pontos[p][0], pontos[p][1], a, saida);
+            for (int k = 0; k < m; k++) vezes[saida[k]]++;
+        }
+
+        int erros = 0;
+        for (int i = 0; i < n; i++) {
+            if (vezes[i] != 1) erros++;
+        }
+        ASSERT_EQUAL(0, erros, "Cada segmento deve aparecer uma única vez");
+    }
+
+    free(saida);
+    free(vezes);
+    liberaGradeSegmentos(g);
+    free(segs);
+}
+
+/* Teste: Segmentos próximos do ponto aparecem nos primeiros anéis */
+void teste_aneis_em_ordem_de_distancia() {
+    int n = 500;
+    SegmentoPlano* segs = segmentos_aleatorios(n, 9);
+    GradeSegmentos g = criaGradeSegmentos(segs, n);
+    float lado = getLadoCelulaGrade(g);
+    ASSERT_TRUE(lado > 0, "Célula deve ter lado positivo");
+
+    int* saida = malloc(n * sizeof(int));
+    int* anel_de = malloc(n * sizeof(int));
+    iniciaConsultaGrade(g);
+    int aneis = getNumAneisGrade(g, 500, 500);
+    for (int a = 0; a < aneis; a++) {
+        int m = segmentosDoAnel(g, 500, 500, a, saida);
+        for (int k = 0; k < m; k++) anel_de[saida[k]] = a;
+    }
+
+    // Um segmento com extremidade a menos de r * lado do ponto está nos anéis 0..r
+    int fora_de_ordem = 0;
+    for (int i = 0; i < n; i++) {
+        float dx = segs[i].x1 - 500, dy = segs[i].y1 - 500;
+        float d = sqrtf(dx * dx + dy * dy);
+        int r = (int)(d / lado) + 1;
+        if (anel_de[i] > r) fora_de_ordem++;
+    }
+    ASSERT_EQUAL(0, fora_de_ordem, "Segmento próximo não pode aparecer num anel distante");
+
+    free(saida);
+    free(anel_de);
+    liberaGradeSegmentos(g);
+    free(segs);
+}
+
+/* Teste: Raio pela grade acha o mesmo segmento que o teste contra todos */
+void teste_raio_equivale_forca_bruta() {
+    int n = 500;
+    SegmentoPlano* segs = segmentos_aleatorios(n, 17);
+    GradeSegmentos g = criaGradeSegmentos(segs, n);
+
+    int discordancias = 0, acertos = 0;
+    srand(23);
+    for (int i = 0; i < 2000; i++) {
+        float ox = (rand() % 1400) - 200;
+        float oy = (rand() % 1400) - 200;
+        float dx = (rand() % 201) - 100;
+        float dy = (rand() % 201) - 100;
+        if (dx == 0 && dy == 0) continue;
+
+        // Força bruta: menor t entre todos os segmentos
+        double melhor = INFINITY;
+        for (int k = 0; k < n; k++) {
+            double ex = segs[k].x2 - segs[k].x1, ey = segs[k].y2 - segs[k].y1;
+            double den = dx * ey - dy * ex;
+            if (den == 0) continue;
+            double wx = segs[k].x1 - ox, wy = segs[k].y1 - oy;
+            double t = (wx * ey - wy * ex) / den;
+            double u = (wx * dy - wy * dx) / den;
+            if (t >= 0 && u >= 0 && u <= 1 && t < melhor) melhor = t;
+        }
+
+        float t = 0;
+        int k = lancaRaioGrade(g, segs, ox, oy, dx, dy, &t);
+        if (k < 0) {
+            if (melhor != INFINITY) discordancias++;
+        } else {
+            acertos++;
+            if (fabs(t - melhor) > 1e-3 * (1 + melhor)) discordancias++;
+        }
+    }
+
+    printf("    %d raios com acerto, %d discordâncias\n", acertos, discordancias);
+    ASSERT_TRUE(acertos > 0, "Algum raio deve atingir um segmento");
+    ASSERT_EQUAL(0, discordancias, "Grade deve achar o segmento mais próximo no raio");
+
+    liberaGradeSegmentos(g);
+    free(segs);
+}
+
+/* Teste: Grade sem segmentos não é criada */
+void teste_grade_vazia() {
+    ASSERT_NULL(criaGradeSegmentos(NULL, 0), "Sem segmentos não há grade");
+    ASSERT_EQUAL(0, getNumAneisGrade(NULL, 0, 0), "Grade nula não tem anéis");
+}
+
+int main() {
+    RESETAR_ESTATISTICAS();
+
+    EXECUTAR_TESTE(teste_aneis_cobrem_todos);
+    EXECUTAR_TESTE(teste_aneis_em_ordem_de_distancia);
+    EXECUTAR_TESTE(teste_raio_equivale_forca_bruta);
+    EXECUTAR_TESTE(teste_grade_vazia);
+
+    IMPRIMIR_RESUMO_TESTES("Módulo Grade de Segmentos");
+
+    return CODIGO_SAIDA_TESTE();
+}
@@ -0,0 +1,150 @@
+#include "test_framework.h"
+#include "../src/indice_ids.h"
+#include "../src/vetor.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+/* Teste: Busca acha o item inserido e some depois da remoção */
+void teste_insere_busca_remove() {
+    IndiceIds ind = criaIndiceIds();
+    int itens[3];
+
+    insereIndiceIds(ind, 10, &itens[0]);
+    insereIndiceIds(ind, 20, &itens[1]);
+    insereIndiceIds(ind, 30, &itens[2]);
+    ASSERT_EQUAL(3, getTamanhoIndiceIds(ind), "Índice deve ter 3 pares");
+    ASSERT_TRUE(buscaIndiceIds(ind, 20) == &itens[1], "Busca deve achar o item do ID 20");
+    ASSERT_NULL(buscaIndiceIds(ind, 25), "ID ausente não deve ser achado");
+
+    ASSERT_TRUE(removeIndiceIds(ind, 20, &itens[1]), "Remoção do par existente");
+    ASSERT_FALSE(removeIndiceIds(ind, 20, &itens[1]), "Par já removido");
+    ASSERT_NULL(buscaIndiceIds(ind, 20), "ID removido não deve ser achado");
+    ASSERT_TRUE(buscaIndiceIds(ind, 30) == &itens[2], "Demais IDs continuam no índice");
+
+    liberaIndiceIds(ind);
+}
+
+/* Teste: IDs repetidos são pares distintos; a busca devolve o mais antigo */
+void teste_ids_repetidos() {
+    IndiceIds ind = criaIndiceIds();
+    int a, b;
+
+    insereIndiceIds(ind, 7, &a);
+    insereIndiceIds(ind, 7, &b);
+    ASSERT_TRUE(buscaIndiceIds(ind, 7) == &a, "Busca devolve o inserido primeiro");
+
+    removeIndiceIds(ind, 7, &a);
+    ASSERT_TRUE(buscaIndiceIds(ind, 7) == &b, "Resta o segundo item do ID");
+
+    liberaIndiceIds(ind);
+}
+
+/* Teste: Inserções e remoções aleatórias batem com um vetor de referência */
+void teste_equivale_referencia() {
+    int n = 5000;
+    int* ids = malloc(n * sizeof(int));
+    bool* presente = calloc(n, sizeof(bool));
+    IndiceIds ind = criaIndiceIds();
+
+    srand(11);
+    for (int k = 0; k < n; k++) {
+        ids[k] = rand() % 3000;  // Com repetições
+        insereIndiceIds(ind, ids[k], &ids[k]);
+        presente[k] = true;
+        // Remove de vez em quando um item anterior
+        if (k % 3 == 0) {
+            int r = rand() % (k + 1);
+            if (presente[r]) {
+                removeIndiceIds(ind, ids[r], &ids[r]);
+                presente[r] = false;
+            }
+        }
+    }
+
+    int vivos = 0;
+    for (int k = 0; k < n; k++) if (presente[k]) vivos++;
+    ASSERT_EQUAL(vivos, getTamanhoIndiceIds(ind), "Tamanho deve bater com a referência");
+
+    // Faixas estreitas (busca por ID) e largas (varredura da tabela)
+    int faixas[4][2] = {{100, 140}, {0, 2999}, {-50, 10}, {2990, 100000}};
+    int erros = 0;
+    for (int f = 0; f < 4; f++) {
+        Vetor saida = criaVetor(0);
+        int m = faixaIndiceIds(ind, faixas[f][0], faixas[f][1], saida);
+
+        // Esperado: itens presentes na faixa, em ordem de inserção
+        int esperados = 0;
+        for (int k = 0; k < n; k++) {
+            if (!presente[k] || ids[k] < faixas[f][0] || ids[k] > faixas[f][1]) continue;
+            if (getElementoVetor(saida, esperados) != &ids[k]) erros++;
+            esperados++;
+        }
+        if (m != esperados || getTamanhoVetor(saida) != esperados) erros++;
+        liberaVetor(saida);
+    }
+    ASSERT_EQUAL(0, erros, "Faixas devem trazer os itens na ordem de inserção");
+
+    liberaIndiceIds(ind);
+    free(ids);
+    free(presente);
+}
+
+/* Teste: Faixa larga e esparsa depois de muitas remoções e IDs fora de ordem */
+void teste_faixa_esparsa() {
+    int n = 20000;
+    int* itens = malloc(n * sizeof(int));
+    IndiceIds ind = criaIndiceIds();
+
+    // IDs espalhados de 1000 em 1000, inseridos de trás para frente
+    for (int k = n - 1; k >= 0; k--) insereIndiceIds(ind, k * 1000, &itens[k]);
+    // Sobram só os múltiplos de 7
+    for (int k = 0; k < n; k++) {
+        if (k % 7 != 0) removeIndiceIds(ind, k * 1000, &itens[k]);
+    }
+
+    Vetor saida = criaVetor(0);
+    int m = faixaIndiceIds(ind, 3500, 3500000, saida);
+    // k em [4, 3500] múltiplo de 7
+    ASSERT_EQUAL(500, m, "Faixa deve trazer os múltiplos de 7 restantes");
+
+    // Inseridos de trás para frente: a ordem de inserção é decrescente em ID
+    int fora_de_ordem = 0, anterior = n;
+    for (int q = 0; q < getTamanhoVetor(saida); q++) {
+        int k = (int*)getElementoVetor(saida, q) - itens;
+        if (k >= anterior || k % 7 != 0) fora_de_ordem++;
+        anterior = k;
+    }
+    ASSERT_EQUAL(0, fora_de_ordem, "Itens devem vir na ordem de inserção");
+
+    liberaVetor(saida);
+    liberaIndiceIds(ind);
+    free(itens);
+}
+
+/* Teste: Índice nulo ou faixa invertida não encontram nada */
+void teste_indice_vazio() {
+    Vetor saida = criaVetor(0);
+    IndiceIds ind = criaIndiceIds();
+
+    ASSERT_NULL(buscaIndiceIds(NULL, 1), "Índice nulo não tem itens");
+    ASSERT_EQUAL(0, faixaIndiceIds(ind, 1, 100, saida), "Índice vazio não tem itens");
+    ASSERT_EQUAL(0, faixaIndiceIds(ind, 5, 1, saida), "Faixa invertida é vazia");
+    ASSERT_TRUE(vetorVazio(saida), "Nada deve ser inserido na saída");
+
+    liberaIndiceIds(ind);
+    liberaVetor(saida);
+}
+
+int main() {
+    RESETAR_ESTATISTICAS();
+
+    EXECUTAR_TESTE(teste_insere_busca_remove);
+    EXECUTAR_TESTE(teste_ids_repetidos);
+    EXECUTAR_TESTE(teste_equivale_referencia);
+    EXECUTAR_TESTE(teste_faixa_esparsa);
+    EXECUTAR_TESTE(teste_indice_vazio);
+
+    IMPRIMIR_RESUMO_TESTES("Módulo Índice de IDs");
+
+    return CODIGO_SAIDA_TESTE();
+}
@@ -0,0 +1,199 @@
+#include "test_framework.h"
+#include "../src/intersecao_segmentos.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+/* Auxiliar: Segmentos aleatórios num quadrado de lado 1000 */
+static SegmentoPlano* segmentos_aleatorios(int n, int comprimento, unsigned semente) {
+    SegmentoPlano* s = malloc(n * sizeof(SegmentoPlano));
+    srand(semente);
+    for (int i = 0; i < n; i++) {
+        s[i].x1 = (rand() % 100000) / 100.0f;
+        s[i].y1 = (rand() % 100000) / 100.0f;
+        s[i].x2 = s[i].x1 + (rand() % (2 * comprimento + 1)) - comprimento;
+        s[i].y2 = s[i].y1 + (rand() % (2 * comprimento + 1)) - comprimento;
+    }
+    return s;
+}
+
+/* Teste: Dois segmentos em X se cruzam no centro */
+void teste_cruzamento_em_x() {
+    SegmentoPlano a = {0, 0, 10, 10};
+    SegmentoPlano b = {0, 10, 10, 0};
+    float x, y;
+
+    ASSERT_TRUE(cruzamentoSegmentos(&a, &b, &x, &y), "Segmentos em X devem se cruzar");
+    ASSERT_FLOAT_EQUAL(5.0f, x, 0.0001f, "X do cruzamento");
+    ASSERT_FLOAT_EQUAL(5.0f, y, 0.0001f, "Y do cruzamento");
+
+    float x2, y2;
+    cruzamentoSegmentos(&b, &a, &x2, &y2);
+    ASSERT_TRUE(x == x2 && y == y2, "Ponto não deve depender da ordem dos argumentos");
+}
+
+/* Teste: Toque em extremidade, paralelos e colineares não são cruzamentos */
+void teste_toque_nao_e_cruzamento() {
+    SegmentoPlano a = {0, 0, 10, 0};
+    SegmentoPlano t = {5, 0, 5, 10};      // Extremidade sobre 'a'
+    SegmentoPlano p = {0, 1, 10, 1};      // Paralelo
+    SegmentoPlano c = {5, 0, 15, 0};      // Colinear sobreposto
+
+    ASSERT_FALSE(cruzamentoSegmentos(&a, &t, NULL, NULL), "Toque em T não divide");
+    ASSERT_FALSE(cruzamentoSegmentos(&a, &p, NULL, NULL), "Paralelos não se cruzam");
+    ASSERT_FALSE(cruzamentoSegmentos(&a, &c, NULL, NULL), "Colineares não se cruzam");
+}
+
+/* Teste: Divisão gera os pedaços no sentido do original */
+void teste_divide_segmentos() {
+    SegmentoPlano segs[3] = {
+        {0, 0, 10, 0},
+        {2, -5, 2, 5},
+        {8, 5, 8, -5}
+    };
+    PedacoSegmento* pedacos = NULL;
+    int n = divideSegmentosCruzados(segs, 3, &pedacos);
+
+    ASSERT_EQUAL(7, n, "Horizontal em 3 pedaços e cada vertical em 2");
+    ASSERT_EQUAL(0, pedacos[0].origem, "Pedaços agrupados pela ordem da entrada");
+    ASSERT_FLOAT_EQUAL(2.0f, pedacos[0].x2, 0.0001f, "Primeiro corte da horizontal em x=2");
+    ASSERT_FLOAT_EQUAL(8.0f, pedacos[1].x2, 0.0001f, "Segundo corte da horizontal em x=8");
+    ASSERT_FLOAT_EQUAL(10.0f, pedacos[2].x2, 0.0001f, "Último pedaço termina na extremidade");
+    ASSERT_FLOAT_EQUAL(5.0f, pedacos[5].y1, 0.0001f, "Vertical invertida mantém o sentido");
+
+    free(pedacos);
+}
+
+/* Teste: Varredura encontra os mesmos pares que a força bruta */
+void teste_varredura_equivale_forca_bruta() {
+    int faltando = 0, sobrando = 0, total_bruta = 0;
+
+    for (unsigned semente = 1; semente <= 5; semente++) {
+        int n = 400;
+        SegmentoPlano* segs = segmentos_aleatorios(n, 60 * semente, semente);
+
+        char* cruza = calloc((size_t)n * n, 1);
+        for (int i = 0; i < n; i++) {
+            for (int j = i + 1; j < n; j++) {
+                if (cruzamentoSegmentos(&segs[i], &segs[j], NULL, NULL)) {
+                    cruza[(size_t)i * n + j] = 1;
+                    total_bruta++;
+                }
+            }
+        }
+
+        int* pares = NULL;
+        int k = encontraCruzamentos(segs, n, &pares);
+        for (int p = 0; p < k; p++) {
+            int a = pares[2 * p], b = pares[2 * p + 1];
+            int i = a < b ? a : b, j = a < b ? b : a;
+            if (cruza[(size_t)i * n + j] == 1) cruza[(size_t)i * n + j] = 2;
+            else sobrando++;
+        }
+        for (size_t q = 0; q < (size_t)n * n; q++) {
+            if (cruza[q] == 1) faltando++;
+        }
+
+        free(pares);
+        free(cruza);
+        free(segs);
+    }
+
+    printf("    %d cruzamentos, %d faltando, %d sobrando\n", total_bruta, faltando, sobrando);
+    ASSERT_EQUAL(0, faltando, "Varredura não deve perder cruzamentos");
+    ASSERT_EQUAL(0, sobrando, "Varredura não deve repetir nem inventar cruzamentos");
+}
+
+/* Teste: Segmentos repetidos, colineares e vários pelo mesmo ponto */
+void teste_varredura_casos_degenerados() {
+    int n = 300;
+    SegmentoPlano* segs = malloc(n * sizeof(SegmentoPlano));
+    srand(11);
+    for (int i = 0; i < n; i++) {
+        if (i % 3 == 2) {
+            segs[i] = segs[i - 1];  // Repetido, como um clone no mesmo lugar
+            continue;
+        }
+        // Grade pequena: muitos segmentos horizontais, verticais e pelo mesmo ponto
+        segs[i].x1 = rand() % 20;
+        segs[i].y1 = rand() % 20;
+        segs[i].x2 = (i % 4 == 0) ? segs[i].x1 : rand() % 20;
+        segs[i].y2 = (i % 4 == 1) ? segs[i].y1 : rand() % 20;
+    }
+
+    int total_bruta = 0;
+    char* cruza = calloc((size_t)n * n, 1);
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            if (cruzamentoSegmentos(&segs[i], &segs[j], NULL, NULL)) {
+                cruza[(size_t)i * n + j] = 1;
+                total_bruta++;
+            }
+        }
+    }
+
+    int* pares = NULL;
+    int k = encontraCruzamentos(segs, n, &pares);
+    int encontrados = 0;
+    for (int p = 0; p < k; p++) {
+        int a = pares[2 * p], b = pares[2 * p + 1];
+        int i = a < b ? a : b, j = a < b ? b : a;
+        if (cruza[(size_t)i * n + j] == 1) {
+            cruza[(size_t)i * n + j] = 2;
+            encontrados++;
+        }
+    }
+
+    printf("    %d cruzamentos, %d encontrados em %d pares\n", total_bruta, encontrados, k);
+    ASSERT_EQUAL(total_bruta, encontrados, "Varredura deve achar todos os cruzamentos");
+    ASSERT_EQUAL(total_bruta, k, "Nenhum par repetido ou inventado");
+
+    free(pares);
+    free(cruza);
+    free(segs);
+}
+
+/* Teste: Dividir contra a lista dá os mesmos pedaços que a varredura */
+void teste_divide_contra_equivale() {
+    int n = 200;
+    SegmentoPlano* segs = segmentos_aleatorios(n, 150, 42);
+
+    PedacoSegmento* todos = NULL;
+    int total = divideSegmentosCruzados(segs, n, &todos);
+
+    int diferentes = 0, pos = 0;
+    for (int i = 0; i < n; i++) {
+        PedacoSegmento* meus = NULL;
+        int m = divideSegmentoContra(&segs[i], segs, n, i, &meus);
+        for (int k = 0; k < m; k++) {
+            PedacoSegmento* a = &meus[k];
+            PedacoSegmento* b = &todos[pos + k];
+            if (pos + k >= total || a->x1 != b->x1 || a->y1 != b->y1 ||
+                a->x2 != b->x2 || a->y2 != b->y2 || b->origem != i) {
+                diferentes++;
+            }
+        }
+        pos += m;
+        free(meus);
+    }
+
+    ASSERT_EQUAL(total, pos, "Mesmo número de pedaços");
+    ASSERT_EQUAL(0, diferentes, "Pedaços idênticos bit a bit");
+
+    free(todos);
+    free(segs);
+}
+
+int main() {
+    RESETAR_ESTATISTICAS();
+
+    EXECUTAR_TESTE(teste_cruzamento_em_x);
+    EXECUTAR_TESTE(teste_toque_nao_e_cruzamento);
+    EXECUTAR_TESTE(teste_divide_segmentos);
+    EXECUTAR_TESTE(teste_varredura_equivale_forca_bruta);
+    EXECUTAR_TESTE(teste_varredura_casos_degenerados);
+    EXECUTAR_TESTE(teste_divide_contra_equivale);
+
+    IMPRIMIR_RESUMO_TESTES("Módulo Interseção de Segmentos");
+
+    return CODIGO_SAIDA_TESTE();
+}
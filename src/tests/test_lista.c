@@ -134,6 +134,32 @@ void teste_operacoes_lista_vazia() {
     liberaLista(l);
 }
 
+/* Teste: Remover célula durante a travessia */
+void teste_remover_celula() {
+    Lista l = criaLista();
+    for (int k = 1; k <= 5; k++) insereFinalLista(l, criar_int(k * 10));
+    
+    // Remove as células de valor múltiplo de 20, mantendo o conteúdo da de 40
+    int* guardado = NULL;
+    Celula c = getInicioLista(l);
+    while (c != NULL) {
+        Celula prox = getProxCelula(c);
+        int* v = getConteudoCelula(c);
+        if (*v == 20) removeCelula(l, c, true);
+        if (*v == 40) { guardado = v; removeCelula(l, c, false); }
+        c = prox;
+    }
+    
+    ASSERT_EQUAL(3, getTamanhoLista(l), "Lista deve ter 3 elementos");
+    ASSERT_EQUAL(10, *(int*)getConteudoCelula(getInicioLista(l)), "Primeiro continua 10");
+    ASSERT_EQUAL(30, *(int*)getConteudoCelula(getProxCelula(getInicioLista(l))), "Segundo passa a ser 30");
+    ASSERT_EQUAL(50, *(int*)getConteudoCelula(getFimLista(l)), "Último continua 50");
+    ASSERT_EQUAL(40, *guardado, "Conteúdo não liberado continua válido");
+    
+    free(guardado);
+    liberaLista(l);
+}
+
 /* Teste: Copiar lista */
 void teste_copiar_lista() {
     Lista l1 = criaLista();
@@ -175,6 +201,7 @@ int main() {
     EXECUTAR_TESTE(teste_remover_final);
     EXECUTAR_TESTE(teste_navegacao);
     EXECUTAR_TESTE(teste_operacoes_lista_vazia);
+    EXECUTAR_TESTE(teste_remover_celula);
     EXECUTAR_TESTE(teste_copiar_lista);
     
     IMPRIMIR_RESUMO_TESTES("Módulo Lista");
@@ -0,0 +1,164 @@
+#include "test_framework.h"
+#include "../src/poligono.h"
+#include "../src/forma.h"
+#include "../src/circulo.h"
+#include "../src/retangulo.h"
+#include "../src/linha.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* Auxiliar: Polígono estrelado com raios aleatórios em torno de (cx, cy) */
+static Poligono cria_estrela(int n, float cx, float cy, unsigned semente) {
+    Poligono p = criaPoligonoCapacidade(n);
+    srand(semente);
+    for (int i = 0; i < n; i++) {
+        double ang = 2 * M_PI * i / n;
+        float r = 50 + rand() % 200;
+        insereVerticeXY(p, cx + r * cos(ang), cy + r * sin(ang));
+    }
+    return p;
+}
+
+/* Referência: cruzamento de segmentos, como em poligono.c */
+static bool cruza(float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4) {
+    float d = (x1 - x2) * (y3 - y4) - (y1 - y2) * (x3 - x4);
+    if (fabs(d) < 1e-9) return false;
+    float t = ((x1 - x3) * (y3 - y4) - (y1 - y3) * (x3 - x4)) / d;
+    float u = -((x1 - x2) * (y1 - y3) - (y1 - y2) * (x1 - x3)) / d;
+    return (t >= 0 && t <= 1 && u >= 0 && u <= 1);
+}
+
+/* Referência: linha intersecta o polígono percorrendo todas as arestas */
+static bool linha_intersecta_ref(Poligono p, float x1, float y1, float x2, float y2) {
+    if (isInsideXY(p, x1, y1) || isInsideXY(p, x2, y2)) return true;
+    int n = getNumVertices(p);
+    for (int i = 0, j = n - 1; i < n; j = i++) {
+        if (cruza(x1, y1, x2, y2, getXVertice(p, j), getYVertice(p, j),
+                  getXVertice(p, i), getYVertice(p, i))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Teste: Vértices ficam no buffer na ordem de inserção */
+void teste_vertices_em_ordem() {
+    Poligono p = criaPoligono();
+    for (int i = 0; i < 100; i++) {
+        insereVerticeXY(p, i, 2 * i);
+    }
+
+    ASSERT_EQUAL(100, getNumVertices(p), "Polígono deve ter 100 vértices");
+    ASSERT_FLOAT_EQUAL(42.0f, getXVertice(p, 42), 0.001f, "X do vértice 42");
+    ASSERT_FLOAT_EQUAL(84.0f, getYVertice(p, 42), 0.001f, "Y do vértice 42");
+
+    Poligono c = copiaPoligono(p);
+    ASSERT_EQUAL(100, getNumVertices(c), "Cópia deve ter os mesmos vértices");
+    ASSERT_FLOAT_EQUAL(99.0f, getXVertice(c, 99), 0.001f, "Último vértice da cópia");
+
+    liberaPoligono(p);
+    liberaPoligono(c);
+}
+
+/* Teste: Ponto dentro de um quadrado */
+void teste_is_inside_quadrado() {
+    Poligono p = criaPoligono();
+    insereVerticeXY(p, 0, 0);
+    insereVerticeXY(p, 10, 0);
+    insereVerticeXY(p, 10, 10);
+    insereVerticeXY(p, 0, 10);
+
+    ASSERT_TRUE(isInsideXY(p, 5, 5), "Centro deve estar dentro");
+    ASSERT_FALSE(isInsideXY(p, 15, 5), "Ponto à direita deve estar fora");
+    ASSERT_FALSE(isInsideXY(p, -1, -1), "Ponto abaixo e à esquerda deve estar fora");
+
+    liberaPoligono(p);
+}
+
+/* Teste: Grade de arestas dá o mesmo resultado que percorrer todas as arestas */
+void teste_grade_equivale_percurso_completo() {
+    Poligono p = cria_estrela(2000, 500, 500, 3);
+    int discordancias = 0;
+
+    srand(5);
+    for (int i = 0; i < 2000; i++) {
+        float x = rand() % 1000;
+        float y = rand() % 1000;
+        float x2 = x + (rand() % 101) - 50;
+        float y2 = y + (rand() % 101) - 50;
+
+        Forma f = criaForma(LINE, criaLinha(i, x, y, x2, y2, "black"));
+        if (formaIntersectaPoligono(p, f) != linha_intersecta_ref(p, x, y, x2, y2)) {
+            discordancias++;
+        }
+        desalocaForma(f);
+    }
+    liberaPoligono(p);
+
+    printf("    %d discordâncias em 2000 linhas\n", discordancias);
+    ASSERT_EQUAL(0, discordancias, "Grade deve concordar com o percurso de todas as arestas");
+}
+
+/* Teste: Linhas longas, diagonais e paralelas aos eixos, atravessando a grade toda */
+void teste_grade_linhas_longas() {
+    Poligono p = cria_estrela(2000, 500, 500, 3);
+    int discordancias = 0;
+
+    srand(17);
+    for (int i = 0; i < 2000; i++) {
+        float x = (rand() % 1200) - 100;
+        float y = (rand() % 1200) - 100;
+        float x2 = (rand() % 1200) - 100;
+        float y2 = (rand() % 1200) - 100;
+        if (i % 4 == 1) y2 = y;   // Horizontal
+        if (i % 4 == 2) x2 = x;   // Vertical
+
+        Forma f = criaForma(LINE, criaLinha(i, x, y, x2, y2, "black"));
+        if (formaIntersectaPoligono(p, f) != linha_intersecta_ref(p, x, y, x2, y2)) {
+            discordancias++;
+        }
+        desalocaForma(f);
+    }
+    liberaPoligono(p);
+
+    ASSERT_EQUAL(0, discordancias, "Percurso das células do segmento deve concordar com a referência");
+}
+
+/* Teste: Círculos e retângulos dentro, fora e na fronteira de um polígono grande */
+void teste_grade_circulo_retangulo() {
+    Poligono p = cria_estrela(1000, 500, 500, 8);
+
+    Forma dentro = criaForma(CIRCLE, criaCirculo(1, 500, 500, 5, "red", "red"));
+    Forma longe = criaForma(CIRCLE, criaCirculo(2, 980, 980, 5, "red", "red"));
+    Forma envolve = criaForma(RECTANGLE, criaRetangulo(3, 0, 0, 1000, 1000, "red", "red"));
+    Forma fora = criaForma(RECTANGLE, criaRetangulo(4, 900, 900, 20, 20, "red", "red"));
+
+    ASSERT_TRUE(formaIntersectaPoligono(p, dentro), "Círculo no centro deve intersectar");
+    ASSERT_FALSE(formaIntersectaPoligono(p, longe), "Círculo distante não deve intersectar");
+    ASSERT_TRUE(formaIntersectaPoligono(p, envolve), "Retângulo que envolve o polígono deve intersectar");
+    ASSERT_FALSE(formaIntersectaPoligono(p, fora), "Retângulo no canto não deve intersectar");
+
+    desalocaForma(dentro);
+    desalocaForma(longe);
+    desalocaForma(envolve);
+    desalocaForma(fora);
+    liberaPoligono(p);
+}
+
+int main() {
+    RESETAR_ESTATISTICAS();
+
+    EXECUTAR_TESTE(teste_vertices_em_ordem);
+    EXECUTAR_TESTE(teste_is_inside_quadrado);
+    EXECUTAR_TESTE(teste_grade_equivale_percurso_completo);
+    EXECUTAR_TESTE(teste_grade_linhas_longas);
+    EXECUTAR_TESTE(teste_grade_circulo_retangulo);
+
+    IMPRIMIR_RESUMO_TESTES("Módulo Polígono");
+
+    return CODIGO_SAIDA_TESTE();
+}
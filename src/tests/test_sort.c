@@ -1,5 +1,6 @@
 #include "test_framework.h"
 #include "../src/sort.h"
+#include "../src/sort_tipado.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -150,6 +151,191 @@ void teste_ordenar_array_vazio() {
     ASSERT_TRUE(1, "Ordenar array vazio não deve causar crash");
 }
 
+/* Teste: Versões híbridas com vários limiares em arrays maiores */
+void teste_limiares_arrays_grandes() {
+    int tamanho = 2000;
+    int* original = malloc(tamanho * sizeof(int));
+    int* copia = malloc(tamanho * sizeof(int));
+    size_t limiares[] = {0, 1, 2, 10, 64, 5000};
+    
+    srand(42);
+    for (int i = 0; i < tamanho; i++) {
+        original[i] = rand() % 500;
+    }
+    
+    int ok_merge = 1, ok_quick = 1;
+    for (int k = 0; k < 6; k++) {
+        copiar_array(copia, original, tamanho);
+        merge_sort_limiar(copia, tamanho, sizeof(int), comparar_ints, limiares[k]);
+        if (!esta_ordenado(copia, tamanho)) ok_merge = 0;
+        
+        copiar_array(copia, original, tamanho);
+        quick_sort_limiar(copia, tamanho, sizeof(int), comparar_ints, limiares[k]);
+        if (!esta_ordenado(copia, tamanho)) ok_quick = 0;
+    }
+    
+    ASSERT_TRUE(ok_merge, "Merge sort deve ordenar com qualquer limiar");
+    ASSERT_TRUE(ok_quick, "Introsort deve ordenar com qualquer limiar");
+    
+    free(original);
+    free(copia);
+}
+
+/* Teste: Entradas que degradam o quicksort ingênuo */
+void teste_quick_sort_entradas_adversas() {
+    int tamanho = 4096;
+    int* arr = malloc(tamanho * sizeof(int));
+    
+    for (int i = 0; i < tamanho; i++) arr[i] = 7;
+    quick_sort_limiar(arr, tamanho, sizeof(int), comparar_ints, 4);
+    ASSERT_TRUE(esta_ordenado(arr, tamanho), "Introsort deve lidar com todos os elementos iguais");
+    
+    /* Órgão de tubos: sobe e desce */
+    for (int i = 0; i < tamanho; i++) arr[i] = i < tamanho / 2 ? i : tamanho - i;
+    quick_sort_limiar(arr, tamanho, sizeof(int), comparar_ints, 4);
+    ASSERT_TRUE(esta_ordenado(arr, tamanho), "Introsort deve lidar com sequência em órgão de tubos");
+    
+    free(arr);
+}
+
+typedef struct {
+    int chave;
+    int posicao;
+} ParOrdenacao;
+
+int comparar_pares(const void* a, const void* b) {
+    return ((const ParOrdenacao*)a)->chave - ((const ParOrdenacao*)b)->chave;
+}
+
+/* Teste: Merge sort deve ser estável em elementos maiores que um ponteiro */
+void teste_merge_sort_estavel() {
+    int tamanho = 500;
+    ParOrdenacao* arr = malloc(tamanho * sizeof(ParOrdenacao));
+    
+    srand(7);
+    for (int i = 0; i < tamanho; i++) {
+        arr[i].chave = rand() % 10;
+        arr[i].posicao = i;
+    }
+    
+    merge_sort_limiar(arr, tamanho, sizeof(ParOrdenacao), comparar_pares, 8);
+    
+    int estavel = 1;
+    for (int i = 1; i < tamanho; i++) {
+        if (arr[i].chave < arr[i-1].chave) estavel = 0;
+        if (arr[i].chave == arr[i-1].chave && arr[i].posicao < arr[i-1].posicao) estavel = 0;
+    }
+    ASSERT_TRUE(estavel, "Merge sort deve preservar a ordem relativa de chaves iguais");
+    
+    free(arr);
+}
+
+#define PAR_MENOR(a, b) ((a)->chave < (b)->chave)
+SORT_TIPADO(pares, ParOrdenacao, PAR_MENOR)
+
+/* Teste: Rotinas geradas por SORT_TIPADO dão o mesmo resultado das genéricas */
+void teste_sort_tipado_equivale_generico() {
+    int tamanho = 3000;
+    ParOrdenacao* original = malloc(tamanho * sizeof(ParOrdenacao));
+    ParOrdenacao* generico = malloc(tamanho * sizeof(ParOrdenacao));
+    ParOrdenacao* tipado = malloc(tamanho * sizeof(ParOrdenacao));
+    
+    srand(11);
+    for (int i = 0; i < tamanho; i++) {
+        original[i].chave = rand() % 100;
+        original[i].posicao = i;
+    }
+    
+    memcpy(generico, original, tamanho * sizeof(ParOrdenacao));
+    memcpy(tipado, original, tamanho * sizeof(ParOrdenacao));
+    merge_sort_limiar(generico, tamanho, sizeof(ParOrdenacao), comparar_pares, 12);
+    pares_merge_sort(tipado, tamanho, 12);
+    ASSERT_TRUE(memcmp(generico, tipado, tamanho * sizeof(ParOrdenacao)) == 0,
+                "Merge sort tipado deve produzir a mesma ordem do genérico");
+    
+    memcpy(generico, original, tamanho * sizeof(ParOrdenacao));
+    memcpy(tipado, original, tamanho * sizeof(ParOrdenacao));
+    quick_sort_limiar(generico, tamanho, sizeof(ParOrdenacao), comparar_pares, 12);
+    pares_quick_sort(tipado, tamanho, 12);
+    ASSERT_TRUE(memcmp(generico, tipado, tamanho * sizeof(ParOrdenacao)) == 0,
+                "Introsort tipado deve produzir a mesma ordem do genérico");
+    
+    free(original);
+    free(generico);
+    free(tipado);
+}
+
+/* Teste: Merge sort paralelo deve dar a mesma ordem estável do sequencial */
+void teste_merge_sort_paralelo_equivale_sequencial() {
+    // Tamanhos acima do corte, com número de blocos par e ímpar
+    int tamanhos[] = {SORT_CORTE_PARALELO, SORT_CORTE_PARALELO * 3 + 17};
+    int threads[] = {2, 3, 4, 7};
+    
+    for (int t = 0; t < 2; t++) {
+        int tamanho = tamanhos[t];
+        ParOrdenacao* original = malloc(tamanho * sizeof(ParOrdenacao));
+        ParOrdenacao* sequencial = malloc(tamanho * sizeof(ParOrdenacao));
+        ParOrdenacao* paralelo = malloc(tamanho * sizeof(ParOrdenacao));
+        
+        srand(13 + t);
+        for (int i = 0; i < tamanho; i++) {
+            original[i].chave = rand() % 1000;
+            original[i].posicao = i;
+        }
+        memcpy(sequencial, original, tamanho * sizeof(ParOrdenacao));
+        merge_sort_limiar(sequencial, tamanho, sizeof(ParOrdenacao), comparar_pares, 10);
+        
+        for (int k = 0; k < 4; k++) {
+            memcpy(paralelo, original, tamanho * sizeof(ParOrdenacao));
+            merge_sort_paralelo(paralelo, tamanho, sizeof(ParOrdenacao), comparar_pares, 10, threads[k]);
+            ASSERT_TRUE(memcmp(sequencial, paralelo, tamanho * sizeof(ParOrdenacao)) == 0,
+                        "Merge sort paralelo deve produzir a mesma ordem do sequencial");
+        }
+        
+        free(original);
+        free(sequencial);
+        free(paralelo);
+    }
+    
+    // Abaixo do corte segue pelo caminho sequencial
+    int arr[] = {5, 3, 9, 1, 7};
+    merge_sort_paralelo(arr, 5, sizeof(int), comparar_ints, 10, 4);
+    ASSERT_TRUE(esta_ordenado(arr, 5), "Array pequeno deve ser ordenado pelo caminho sequencial");
+}
+
+/* Teste: Radix sort de chaves deve ordenar como inteiros sem sinal e ser estável */
+void teste_radix_sort_chaves() {
+    int tamanho = 5000;
+    ChaveRadix* arr = malloc(tamanho * sizeof(ChaveRadix));
+    
+    srand(17);
+    for (int i = 0; i < tamanho; i++) {
+        // Bytes altos variados, bytes do meio constantes (passadas puladas), muitas repetições
+        arr[i].chave = ((uint64_t)(rand() % 50) << 56) | 0x0000AB0000000000ULL | (uint64_t)(rand() % 4);
+        arr[i].indice = i;
+    }
+    
+    radix_sort_chaves(arr, tamanho);
+    
+    int ordenado = 1;
+    for (int i = 1; i < tamanho; i++) {
+        if (arr[i].chave < arr[i-1].chave) ordenado = 0;
+        if (arr[i].chave == arr[i-1].chave && arr[i].indice < arr[i-1].indice) ordenado = 0;
+    }
+    ASSERT_TRUE(ordenado, "Radix sort deve ordenar as chaves preservando a ordem de iguais");
+    
+    // Todas as chaves iguais: nenhuma passada é necessária
+    for (int i = 0; i < tamanho; i++) {
+        arr[i].chave = 42;
+        arr[i].indice = i;
+    }
+    radix_sort_chaves(arr, tamanho);
+    ASSERT_TRUE(arr[0].indice == 0 && arr[tamanho-1].indice == (size_t)(tamanho - 1),
+                "Chaves iguais devem manter a ordem original");
+    
+    free(arr);
+}
+
 int main() {
     RESETAR_ESTATISTICAS();
     
@@ -161,6 +347,12 @@ int main() {
     EXECUTAR_TESTE(teste_ordenar_com_duplicatas);
     EXECUTAR_TESTE(teste_ordenar_um_elemento);
     EXECUTAR_TESTE(teste_ordenar_array_vazio);
+    EXECUTAR_TESTE(teste_limiares_arrays_grandes);
+    EXECUTAR_TESTE(teste_quick_sort_entradas_adversas);
+    EXECUTAR_TESTE(teste_merge_sort_estavel);
+    EXECUTAR_TESTE(teste_sort_tipado_equivale_generico);
+    EXECUTAR_TESTE(teste_merge_sort_paralelo_equivale_sequencial);
+    EXECUTAR_TESTE(teste_radix_sort_chaves);
     
     IMPRIMIR_RESUMO_TESTES("Módulo Sort");
     
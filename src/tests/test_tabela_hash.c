@@ -0,0 +1,137 @@
+#include "test_framework.h"
+#include "../src/tabela_hash.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+/* Teste: Inserir, buscar, trocar valor e remover com chaves string */
+void teste_chaves_string() {
+    TabelaHash t = criaTabelaHash(hashString, igualString);
+    int a = 1, b = 2, c = 3;
+    char chave_igual[] = "azul";
+
+    ASSERT_TRUE(insereTabelaHash(t, "azul", &a), "Chave nova");
+    ASSERT_TRUE(insereTabelaHash(t, "verde", &b), "Chave nova");
+    ASSERT_EQUAL(2, getTamanhoTabelaHash(t), "Tabela deve ter 2 pares");
+
+    // Outra string com o mesmo conteúdo é a mesma chave
+    ASSERT_TRUE(buscaTabelaHash(t, chave_igual) == &a, "Busca por conteúdo, não por endereço");
+    ASSERT_FALSE(insereTabelaHash(t, chave_igual, &c), "Chave repetida só troca o valor");
+    ASSERT_TRUE(buscaTabelaHash(t, "azul") == &c, "Valor trocado");
+    ASSERT_EQUAL(2, getTamanhoTabelaHash(t), "Tamanho não muda ao trocar valor");
+
+    ASSERT_TRUE(removeTabelaHash(t, "azul"), "Remoção de chave existente");
+    ASSERT_FALSE(removeTabelaHash(t, "azul"), "Chave já removida");
+    ASSERT_NULL(buscaTabelaHash(t, "azul"), "Chave removida não é achada");
+    ASSERT_TRUE(buscaTabelaHash(t, "verde") == &b, "Demais chaves continuam");
+
+    liberaTabelaHash(t);
+}
+
+/* Teste: Valor NULL é distinguido de chave ausente por contemTabelaHash */
+void teste_valor_nulo() {
+    TabelaHash t = criaTabelaHash(hashPonteiro, igualPonteiro);
+    int x;
+
+    insereTabelaHash(t, &x, NULL);
+    ASSERT_NULL(buscaTabelaHash(t, &x), "Valor guardado é NULL");
+    ASSERT_TRUE(contemTabelaHash(t, &x), "Mas a chave está na tabela");
+
+    liberaTabelaHash(t);
+}
+
+/* Teste: Operações aleatórias batem com um vetor de referência */
+void teste_equivale_referencia() {
+    int universo = 4000;
+    int* chaves = malloc(universo * sizeof(int));
+    int* valor_ref = malloc(universo * sizeof(int));  // -1: ausente
+    int* valores = malloc(universo * sizeof(int));
+    TabelaHash t = criaTabelaHash(hashInteiro, igualInteiro);
+
+    for (int k = 0; k < universo; k++) {
+        chaves[k] = k * 37 - 50000;  // Inclui negativos
+        valor_ref[k] = -1;
+        valores[k] = k;
+    }
+
+    srand(7);
+    int erros = 0;
+    for (int op = 0; op < 60000; op++) {
+        int k = rand() % universo;
+        int escolha = rand() % 3;
+        if (escolha == 0) {
+            bool nova = insereTabelaHash(t, &chaves[k], &valores[k]);
+            if (nova != (valor_ref[k] < 0)) erros++;
+            valor_ref[k] = k;
+        } else if (escolha == 1) {
+            bool removida = removeTabelaHash(t, &chaves[k]);
+            if (removida != (valor_ref[k] >= 0)) erros++;
+            valor_ref[k] = -1;
+        } else {
+            int* v = buscaTabelaHash(t, &chaves[k]);
+            if (valor_ref[k] < 0 ? v != NULL : (v == NULL || *v != k)) erros++;
+        }
+    }
+
+    int presentes = 0;
+    for (int k = 0; k < universo; k++) if (valor_ref[k] >= 0) presentes++;
+    ASSERT_EQUAL(0, erros, "Todas as operações devem bater com a referência");
+    ASSERT_EQUAL(presentes, getTamanhoTabelaHash(t), "Tamanho deve bater com a referência");
+
+    liberaTabelaHash(t);
+    free(chaves);
+    free(valor_ref);
+    free(valores);
+}
+
+/* Auxiliar: Soma os valores inteiros visitados */
+static void soma_valor(void* chave, void* valor, void* contexto) {
+    (void)chave;
+    *(long*)contexto += *(int*)valor;
+}
+
+/* Teste: Percurso visita cada par uma vez; limpar esvazia a tabela */
+void teste_percorre_e_limpa() {
+    int n = 1000;
+    int* chaves = malloc(n * sizeof(int));
+    TabelaHash t = criaTabelaHash(hashInteiro, igualInteiro);
+
+    long esperado = 0;
+    for (int k = 0; k < n; k++) {
+        chaves[k] = k;
+        insereTabelaHash(t, &chaves[k], &chaves[k]);
+        esperado += k;
+    }
+
+    long soma = 0;
+    percorreTabelaHash(t, soma_valor, &soma);
+    ASSERT_TRUE(soma == esperado, "Percurso deve visitar cada par uma vez");
+
+    limpaTabelaHash(t);
+    ASSERT_EQUAL(0, getTamanhoTabelaHash(t), "Tabela limpa fica vazia");
+    ASSERT_FALSE(contemTabelaHash(t, &chaves[10]), "Nenhuma chave resta");
+    ASSERT_TRUE(insereTabelaHash(t, &chaves[10], NULL), "Tabela limpa continua utilizável");
+
+    liberaTabelaHash(t);
+    free(chaves);
+}
+
+/* Teste: Funções nulas e tabela nula */
+void teste_tabela_invalida() {
+    ASSERT_NULL(criaTabelaHash(NULL, igualString), "Sem função de hash não há tabela");
+    ASSERT_NULL(buscaTabelaHash(NULL, "x"), "Tabela nula não tem valores");
+    ASSERT_EQUAL(0, getTamanhoTabelaHash(NULL), "Tabela nula tem tamanho 0");
+}
+
+int main() {
+    RESETAR_ESTATISTICAS();
+
+    EXECUTAR_TESTE(teste_chaves_string);
+    EXECUTAR_TESTE(teste_valor_nulo);
+    EXECUTAR_TESTE(teste_equivale_referencia);
+    EXECUTAR_TESTE(teste_percorre_e_limpa);
+    EXECUTAR_TESTE(teste_tabela_invalida);
+
+    IMPRIMIR_RESUMO_TESTES("Módulo Tabela Hash");
+
+    return CODIGO_SAIDA_TESTE();
+}
@@ -0,0 +1,92 @@
+#include "test_framework.h"
+#include "../src/trata_geo.h"
+#include "../src/leitor_arquivos.h"
+#include "../src/forma.h"
+#include "../src/linha.h"
+#include "../src/anteparo.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#define GEO_TESTE "cidade_teste.geo"
+#define SVG_TESTE "./cidade_teste.svg"
+
+/* Auxiliar: Cidade lida de um .geo temporário com um círculo longe da origem */
+static Cidade cria_cidade_teste(DadosDoArquivo* arq) {
+    FILE* f = fopen(GEO_TESTE, "w");
+    fprintf(f, "c 1 500 500 10 red blue\n");
+    fclose(f);
+
+    *arq = criar_dados_arquivo(GEO_TESTE);
+    return executa_comando_geo(*arq, ".", NULL);
+}
+
+/* Auxiliar: Libera a cidade e apaga os arquivos gerados */
+static void libera_cidade_teste(Cidade cidade, DadosDoArquivo arq) {
+    desaloca_geo(cidade);
+    destruir_dados_arquivo(arq);
+    remove(GEO_TESTE);
+    remove(SVG_TESTE);
+}
+
+/* Auxiliar: Anteparo a partir da linha (x1, y1) -> (x2, y2) */
+static Forma cria_anteparo_teste(int id, float x1, float y1, float x2, float y2) {
+    Forma linha = criaForma(LINE, criaLinha(id, x1, y1, x2, y2, "black"));
+    Forma ant = criaForma(ANTEPARO, transforma_em_anteparo(linha, 'h', id));
+    desalocaForma(linha);
+    return ant;
+}
+
+/* Teste: A hierarquia é refeita quando um anteparo entra ou sai da cidade */
+void teste_linha_de_visao_versao() {
+    DadosDoArquivo arq;
+    Cidade cidade = cria_cidade_teste(&arq);
+
+    ASSERT_TRUE(linhaDeVisao(cidade, 0, 0, 100, 0), "Sem anteparos, tudo é visível");
+
+    Forma parede = cria_anteparo_teste(2, 50, -10, 50, 10);
+    insere_forma_cidade(cidade, parede);
+    ASSERT_FALSE(linhaDeVisao(cidade, 0, 0, 100, 0), "Anteparo inserido bloqueia AB");
+    ASSERT_TRUE(linhaDeVisao(cidade, 0, 20, 100, 20), "Segmento acima do anteparo continua livre");
+
+    remove_forma_cidade(cidade, parede);
+    desalocaForma(parede);
+    ASSERT_TRUE(linhaDeVisao(cidade, 0, 0, 100, 0), "Anteparo removido deixa de bloquear");
+
+    libera_cidade_teste(cidade, arq);
+}
+
+/* Teste: Mesma coisa pela troca em lote de substitui_formas_cidade */
+void teste_linha_de_visao_substituicao() {
+    DadosDoArquivo arq;
+    Cidade cidade = cria_cidade_teste(&arq);
+
+    Vetor inserir = criaVetor(0);
+    insereFinalVetor(inserir, cria_anteparo_teste(2, 50, -10, 50, 10));
+    insereFinalVetor(inserir, cria_anteparo_teste(3, -10, 50, 10, 50));
+    substitui_formas_cidade(cidade, NULL, inserir);
+    ASSERT_FALSE(linhaDeVisao(cidade, 0, 0, 100, 0), "Primeiro anteparo bloqueia");
+    ASSERT_FALSE(linhaDeVisao(cidade, 0, 0, 0, 100), "Segundo anteparo bloqueia");
+
+    Vetor remover = criaVetor(0);
+    insereFinalVetor(remover, getElementoVetor(inserir, 0));
+    substitui_formas_cidade(cidade, remover, NULL);
+    ASSERT_TRUE(linhaDeVisao(cidade, 0, 0, 100, 0), "Anteparo retirado deixa de bloquear");
+    ASSERT_FALSE(linhaDeVisao(cidade, 0, 0, 0, 100), "O outro continua bloqueando");
+
+    desalocaForma(getElementoVetor(remover, 0));
+    liberaVetor(remover);
+    liberaVetor(inserir);
+    libera_cidade_teste(cidade, arq);
+}
+
+int main() {
+    RESETAR_ESTATISTICAS();
+
+    EXECUTAR_TESTE(teste_linha_de_visao_versao);
+    EXECUTAR_TESTE(teste_linha_de_visao_substituicao);
+
+    IMPRIMIR_RESUMO_TESTES("Módulo Trata GEO");
+
+    return CODIGO_SAIDA_TESTE();
+}
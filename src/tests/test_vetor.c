@@ -0,0 +1,114 @@
+#include "test_framework.h"
+#include "../src/vetor.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+/* Teste: Inserir além da capacidade inicial preserva os elementos e a ordem */
+void teste_insercao_crescimento() {
+    int itens[1000];
+    Vetor v = criaVetor(0);
+
+    ASSERT_TRUE(vetorVazio(v), "Vetor novo deve estar vazio");
+    for (int i = 0; i < 1000; i++) insereFinalVetor(v, &itens[i]);
+    ASSERT_EQUAL(1000, getTamanhoVetor(v), "Vetor deve ter 1000 elementos");
+
+    int erros = 0;
+    void** dados = getDadosVetor(v);
+    for (int i = 0; i < 1000; i++) {
+        if (getElementoVetor(v, i) != &itens[i] || dados[i] != &itens[i]) erros++;
+    }
+    ASSERT_EQUAL(0, erros, "Elementos devem ficar na ordem de inserção");
+    ASSERT_NULL(getElementoVetor(v, 1000), "Posição além do fim é inválida");
+    ASSERT_NULL(getElementoVetor(v, -1), "Posição negativa é inválida");
+
+    setElementoVetor(v, 3, &itens[0]);
+    ASSERT_TRUE(getElementoVetor(v, 3) == &itens[0], "Elemento substituído");
+
+    liberaVetor(v);
+}
+
+/* Teste: Reserva e anexação */
+void teste_reserva_anexa() {
+    int a[5], b[300];
+    Vetor v = criaVetor(2);
+    Vetor w = criaVetor(0);
+
+    for (int i = 0; i < 5; i++) insereFinalVetor(v, &a[i]);
+    for (int i = 0; i < 300; i++) insereFinalVetor(w, &b[i]);
+
+    reservaVetor(v, 1000);
+    void** antes = getDadosVetor(v);
+    anexaVetor(v, w);
+    ASSERT_TRUE(getDadosVetor(v) == antes, "Com espaço reservado não há realocação");
+    ASSERT_EQUAL(305, getTamanhoVetor(v), "Destino recebe todos os elementos");
+    ASSERT_EQUAL(300, getTamanhoVetor(w), "Origem não é alterada");
+    ASSERT_TRUE(getElementoVetor(v, 4) == &a[4], "Elementos antigos continuam");
+    ASSERT_TRUE(getElementoVetor(v, 5) == &b[0], "Anexados vêm depois, em ordem");
+    ASSERT_TRUE(getElementoVetor(v, 304) == &b[299], "Último anexado no final");
+
+    limpaVetor(v);
+    ASSERT_TRUE(vetorVazio(v), "Vetor limpo fica vazio");
+    anexaVetor(v, w);
+    ASSERT_EQUAL(300, getTamanhoVetor(v), "Vetor limpo continua utilizável");
+
+    liberaVetor(v);
+    liberaVetor(w);
+}
+
+/* Teste: As várias formas de remoção */
+void teste_remocao() {
+    int x[6];
+    Vetor v = criaVetor(0);
+    for (int i = 0; i < 6; i++) insereFinalVetor(v, &x[i]);
+
+    // removeVetor preserva a ordem: 0 2 3 4 5
+    ASSERT_TRUE(removeVetor(v, 1) == &x[1], "Remove a posição pedida");
+    ASSERT_TRUE(getElementoVetor(v, 1) == &x[2], "Seguintes andam uma posição");
+
+    // removeTrocaVetor põe o último no lugar: 0 5 3 4
+    ASSERT_TRUE(removeTrocaVetor(v, 1) == &x[2], "Remove a posição pedida");
+    ASSERT_TRUE(getElementoVetor(v, 1) == &x[5], "Último ocupa o lugar do removido");
+
+    // removeElementoVetor: 0 5 4
+    ASSERT_TRUE(removeElementoVetor(v, &x[3]), "Elemento presente é removido");
+    ASSERT_FALSE(removeElementoVetor(v, &x[3]), "Elemento ausente não é achado");
+    ASSERT_TRUE(getElementoVetor(v, 2) == &x[4], "Ordem dos demais preservada");
+
+    ASSERT_TRUE(removeFinalVetor(v) == &x[4], "Remove o último");
+    ASSERT_EQUAL(2, getTamanhoVetor(v), "Restam 2 elementos");
+
+    truncaVetor(v, 5);
+    ASSERT_EQUAL(2, getTamanhoVetor(v), "Truncar para mais não muda nada");
+    truncaVetor(v, 1);
+    ASSERT_EQUAL(1, getTamanhoVetor(v), "Truncado para 1 elemento");
+    ASSERT_TRUE(getElementoVetor(v, 0) == &x[0], "Primeiro elemento continua");
+
+    ASSERT_NULL(removeVetor(v, 1), "Posição inválida não remove nada");
+    ASSERT_TRUE(removeFinalVetor(v) == &x[0], "Remove o único elemento");
+    ASSERT_NULL(removeFinalVetor(v), "Vetor vazio não tem último");
+
+    liberaVetor(v);
+}
+
+/* Teste: Vetor nulo */
+void teste_vetor_nulo() {
+    ASSERT_EQUAL(0, getTamanhoVetor(NULL), "Vetor nulo tem tamanho 0");
+    ASSERT_TRUE(vetorVazio(NULL), "Vetor nulo está vazio");
+    ASSERT_NULL(getElementoVetor(NULL, 0), "Vetor nulo não tem elementos");
+    ASSERT_NULL(removeFinalVetor(NULL), "Vetor nulo não tem último");
+    insereFinalVetor(NULL, NULL);
+    liberaVetor(NULL);
+}
+
+int main() {
+    RESETAR_ESTATISTICAS();
+
+    EXECUTAR_TESTE(teste_insercao_crescimento);
+    EXECUTAR_TESTE(teste_reserva_anexa);
+    EXECUTAR_TESTE(teste_remocao);
+    EXECUTAR_TESTE(teste_vetor_nulo);
+
+    IMPRIMIR_RESUMO_TESTES("Módulo Vetor");
+
+    return CODIGO_SAIDA_TESTE();
+}
@@ -0,0 +1,630 @@
+#include "test_framework.h"
+#include "../src/visibilidade.h"
+#include "../src/poligono.h"
+#include "../src/forma.h"
+#include "../src/linha.h"
+#include "../src/anteparo.h"
+#include "../src/vetor.h"
+#include "../src/circulo.h"
+#include "../src/retangulo.h"
+#include "../src/cache_visibilidade.h"
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+
+/* Auxiliar: Cria um anteparo a partir de uma linha e o insere no vetor */
+static void adiciona_anteparo(Vetor formas, int id, float x1, float y1, float x2, float y2) {
+    Forma linha = criaForma(LINE, criaLinha(id, x1, y1, x2, y2, "black"));
+    Anteparo a = transforma_em_anteparo(linha, 'h', id);
+    insereFinalVetor(formas, criaForma(ANTEPARO, a));
+    desalocaForma(linha);
+}
+
+/* Auxiliar: Libera as formas da cena */
+static void libera_cena(Vetor formas) {
+    while (!vetorVazio(formas)) {
+        desalocaForma(removeFinalVetor(formas));
+    }
+    liberaVetor(formas);
+}
+
+/* Auxiliar: Cena com anteparos aleatórios que não passam sobre o observador */
+static Vetor cria_cena_aleatoria(unsigned semente, int n_anteparos) {
+    Vetor formas = criaVetor(0);
+    srand(semente);
+    for (int i = 0; i < n_anteparos; i++) {
+        float x = 20 + rand() % 460;
+        float y = 20 + rand() % 460;
+        if (x > 230 && x < 270 && y > 230 && y < 270) continue;
+        float dx = (rand() % 61) - 30;
+        float dy = (rand() % 61) - 30;
+        adiciona_anteparo(formas, i + 1, x, y, x + dx, y + dy);
+    }
+    return formas;
+}
+
+/* Teste: Anteparo entre observador e ponto bloqueia a visão */
+void teste_anteparo_bloqueia_ponto() {
+    Vetor formas = criaVetor(0);
+    adiciona_anteparo(formas, 1, 10, -10, 10, 10);
+    
+    ContextoVisibilidade ctx = criaContextoVisibilidade(0, 0, formas, 'q', 10);
+    ASSERT_NOT_NULL(ctx, "Contexto deve ser criado");
+    
+    ASSERT_TRUE(pontoVisivel(ctx, 5, 0), "Ponto antes do anteparo deve ser visível");
+    ASSERT_FALSE(pontoVisivel(ctx, 15, 0), "Ponto atrás do anteparo não deve ser visível");
+    ASSERT_TRUE(pontoVisivel(ctx, -15, 0), "Ponto do lado oposto deve ser visível");
+    ASSERT_TRUE(pontoVisivel(ctx, 0, 0), "Observador deve ser visível");
+    
+    liberaContextoVisibilidade(ctx);
+    libera_cena(formas);
+}
+
+/* Teste: Anteparo que cruza o ângulo -pi (à esquerda do observador) também bloqueia */
+void teste_anteparo_atras_bloqueia_ponto() {
+    Vetor formas = criaVetor(0);
+    adiciona_anteparo(formas, 1, -10, -10, -10, 10);
+    
+    ContextoVisibilidade ctx = criaContextoVisibilidade(0, 0, formas, 'q', 10);
+    
+    ASSERT_TRUE(pontoVisivel(ctx, -5, 0), "Ponto antes do anteparo deve ser visível");
+    ASSERT_FALSE(pontoVisivel(ctx, -15, 0), "Ponto atrás do anteparo não deve ser visível");
+    ASSERT_FALSE(pontoVisivel(ctx, -15, 3), "Ponto acima de -pi também não");
+    ASSERT_FALSE(pontoVisivel(ctx, -15, -3), "Ponto abaixo de -pi também não");
+    ASSERT_TRUE(pontoVisivel(ctx, 15, 0), "Ponto do lado oposto deve ser visível");
+    
+    liberaContextoVisibilidade(ctx);
+    libera_cena(formas);
+}
+
+/* Teste: Anteparos cruzados em X escondem o que está atrás dos dois braços */
+void teste_anteparos_cruzados() {
+    Vetor formas = criaVetor(0);
+    adiciona_anteparo(formas, 1, 10, -10, 30, 10);
+    adiciona_anteparo(formas, 2, 10, 10, 30, -10);
+    
+    ContextoVisibilidade ctx = criaContextoVisibilidade(0, 0, formas, 'q', 10);
+    
+    ASSERT_TRUE(pontoVisivel(ctx, 15, 0), "Ponto na abertura do X deve ser visível");
+    ASSERT_FALSE(pontoVisivel(ctx, 40, 0), "Ponto atrás do cruzamento não deve ser visível");
+    ASSERT_FALSE(pontoVisivel(ctx, 25, 3), "Ponto atrás do braço mais próximo não deve ser visível");
+    ASSERT_TRUE(pontoVisivel(ctx, 5, 8), "Ponto fora do X deve ser visível");
+    
+    liberaContextoVisibilidade(ctx);
+    libera_cena(formas);
+}
+
+/* Teste: Índice angular concorda com ray casting no polígono */
+void teste_ponto_visivel_equivale_ray_casting() {
+    int discordancias = 0;
+    int total = 0;
+    
+    for (unsigned semente = 1; semente <= 5; semente++) {
+        Vetor formas = cria_cena_aleatoria(semente, 60);
+        ContextoVisibilidade ctx = criaContextoVisibilidade(250, 250, formas, 'q', 10);
+        Poligono regiao = getPoligonoVisibilidade(ctx);
+        
+        srand(semente * 100);
+        for (int i = 0; i < 2000; i++) {
+            float px = (rand() % 60000) / 100.0f - 50;
+            float py = (rand() % 60000) / 100.0f - 50;
+            if (pontoVisivel(ctx, px, py) != isInsideXY(regiao, px, py)) {
+                discordancias++;
+            }
+            total++;
+        }
+        
+        liberaContextoVisibilidade(ctx);
+        libera_cena(formas);
+    }
+    
+    printf("    %d pontos, %d discordâncias\n", total, discordancias);
+    ASSERT_EQUAL(0, discordancias, "pontoVisivel deve concordar com isInsideXY fora da fronteira");
+}
+
+/* Teste: Versão em lote dá o mesmo resultado da consulta individual */
+void teste_pontos_visiveis_lote() {
+    Vetor formas = cria_cena_aleatoria(9, 40);
+    ContextoVisibilidade ctx = criaContextoVisibilidade(250, 250, formas, 'm', 10);
+    
+    int n = 500;
+    float* xs = malloc(n * sizeof(float));
+    float* ys = malloc(n * sizeof(float));
+    bool* saida = malloc(n * sizeof(bool));
+    
+    srand(21);
+    for (int i = 0; i < n; i++) {
+        xs[i] = rand() % 500;
+        ys[i] = rand() % 500;
+    }
+    pontosVisiveis(ctx, xs, ys, n, saida);
+    
+    int iguais = 1;
+    for (int i = 0; i < n; i++) {
+        if (saida[i] != pontoVisivel(ctx, xs[i], ys[i])) iguais = 0;
+    }
+    ASSERT_TRUE(iguais, "pontosVisiveis deve concordar com pontoVisivel");
+    
+    free(xs);
+    free(ys);
+    free(saida);
+    liberaContextoVisibilidade(ctx);
+    libera_cena(formas);
+}
+
+/* Teste: Perfil angular de profundidade mede a distância até o anteparo */
+void teste_profundidade_visibilidade() {
+    Vetor formas = criaVetor(0);
+    adiciona_anteparo(formas, 1, 10, -10, 10, 10);
+    
+    ContextoVisibilidade ctx = criaContextoVisibilidade(0, 0, formas, 'q', 10);
+    
+    ASSERT_FLOAT_EQUAL(10.0f, profundidadeVisibilidade(ctx, 0.0f), 0.01f,
+                       "Na direção do anteparo a profundidade é a distância até ele");
+    ASSERT_TRUE(profundidadeVisibilidade(ctx, 3.14159f) > 10.0f,
+                "Na direção oposta a profundidade vai até o retângulo envolvente");
+    
+    liberaContextoVisibilidade(ctx);
+    libera_cena(formas);
+}
+
+/* Teste: Acerto pelo perfil angular concorda com a interseção com o polígono */
+void teste_forma_atingida_equivale_poligono() {
+    int discordancias = 0;
+    int total = 0;
+    
+    for (unsigned semente = 1; semente <= 5; semente++) {
+        Vetor formas = cria_cena_aleatoria(semente, 60);
+        ContextoVisibilidade ctx = criaContextoVisibilidade(250, 250, formas, 'q', 10);
+        Poligono regiao = getPoligonoVisibilidade(ctx);
+        
+        srand(semente * 7);
+        for (int i = 0; i < 300; i++) {
+            float x = rand() % 500;
+            float y = rand() % 500;
+            Forma f;
+            switch (i % 3) {
+                case 0: f = criaForma(CIRCLE, criaCirculo(1000 + i, x, y, 1 + rand() % 15, "red", "red")); break;
+                case 1: f = criaForma(RECTANGLE, criaRetangulo(1000 + i, x, y, 1 + rand() % 30, 1 + rand() % 30, "red", "red")); break;
+                default: f = criaForma(LINE, criaLinha(1000 + i, x, y, x + (rand() % 41) - 20, y + (rand() % 41) - 20, "red")); break;
+            }
+            
+            if (formaAtingida(ctx, f) != formaIntersectaPoligono(regiao, f)) {
+                discordancias++;
+            }
+            total++;
+            desalocaForma(f);
+        }
+        
+        liberaContextoVisibilidade(ctx);
+        libera_cena(formas);
+    }
+    
+    printf("    %d formas, %d discordâncias\n", total, discordancias);
+    ASSERT_EQUAL(0, discordancias, "formaAtingida deve concordar com formaIntersectaPoligono");
+}
+
+/* Auxiliar: Anteparo (x1, y1)-(x2, y2) girado de 'ang' radianos em torno da origem */
+static void adiciona_anteparo_girado(Vetor formas, int id, double ang,
+                                     float x1, float y1, float x2, float y2) {
+    double c = cos(ang), s = sin(ang);
+    adiciona_anteparo(formas, id, x1 * c - y1 * s, x1 * s + y1 * c, x2 * c - y2 * s, x2 * s + y2 * c);
+}
+
+/* Teste: Anteparo que delimita V(x) fica sobre a fronteira e é atingido */
+void teste_anteparo_na_fronteira_atingido() {
+    int perdidos = 0;
+    int escondidos_atingidos = 0;
+    
+    // Só o meio do anteparo 1 aparece entre os anteparos 3 e 4; o 2 fica atrás dele.
+    // Girar a cena tira os vértices de V(x) das coordenadas exatas.
+    for (int graus = 0; graus < 360; graus++) {
+        double ang = graus * 3.14159265358979 / 180;
+        Vetor formas = criaVetor(0);
+        adiciona_anteparo_girado(formas, 1, ang, 100, -50, 100, 50);
+        adiciona_anteparo_girado(formas, 2, ang, 200, -20, 200, 20);
+        adiciona_anteparo_girado(formas, 3, ang, 50, -30, 50, -10);
+        adiciona_anteparo_girado(formas, 4, ang, 50, 10, 50, 30);
+        
+        ContextoVisibilidade ctx = criaContextoVisibilidade(0, 0, formas, 'q', 10);
+        Poligono regiao = getPoligonoVisibilidade(ctx);
+        Forma frente = getElementoVetor(formas, 0);
+        Forma atras = getElementoVetor(formas, 1);
+        
+        if (!formaAtingida(ctx, frente) || !formaIntersectaPoligono(regiao, frente)) perdidos++;
+        if (formaAtingida(ctx, atras) || formaIntersectaPoligono(regiao, atras)) escondidos_atingidos++;
+        
+        liberaContextoVisibilidade(ctx);
+        libera_cena(formas);
+    }
+    
+    ASSERT_EQUAL(0, perdidos, "Anteparo visível sobre a fronteira deve ser atingido em qualquer rotação");
+    ASSERT_EQUAL(0, escondidos_atingidos, "Anteparo escondido não deve ser atingido");
+}
+
+/* Teste: Os próprios anteparos da cena, rentes à fronteira, dão o mesmo acerto nos dois testes */
+void teste_anteparos_da_cena_equivale_poligono() {
+    int discordancias = 0;
+    int atingidos = 0;
+    int total = 0;
+    
+    for (unsigned semente = 1; semente <= 10; semente++) {
+        Vetor formas = cria_cena_aleatoria(semente, 120);
+        ContextoVisibilidade ctx = criaContextoVisibilidade(250, 250, formas, 'q', 10);
+        Poligono regiao = getPoligonoVisibilidade(ctx);
+        
+        for (int i = 0; i < getTamanhoVetor(formas); i++) {
+            Forma f = getElementoVetor(formas, i);
+            bool atingido = formaAtingida(ctx, f);
+            if (atingido != formaIntersectaPoligono(regiao, f)) discordancias++;
+            atingidos += atingido;
+            total++;
+        }
+        
+        liberaContextoVisibilidade(ctx);
+        libera_cena(formas);
+    }
+    
+    printf("    %d anteparos, %d atingidos, %d discordâncias\n", total, atingidos, discordancias);
+    ASSERT_EQUAL(0, discordancias, "formaAtingida deve concordar com formaIntersectaPoligono nos anteparos");
+}
+
+/* Auxiliar: Polígonos com a mesma sequência de vértices */
+static bool mesmos_vertices(Poligono a, Poligono b) {
+    if (getNumVertices(a) != getNumVertices(b)) return false;
+    for (int i = 0; i < getNumVertices(a); i++) {
+        if (getXVertice(a, i) != getXVertice(b, i) || getYVertice(a, i) != getYVertice(b, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Teste: Atualização incremental dá o mesmo V(x) que recalcular do zero */
+void teste_atualiza_equivale_recalculo() {
+    int discordancias = 0;
+    int poligonos_diferentes = 0;
+    int rodadas = 0;
+    
+    for (unsigned semente = 1; semente <= 5; semente++) {
+        Vetor formas = cria_cena_aleatoria(semente, 60);
+        // Forma que fixa o retângulo envolvente, para as alterações não o mudarem
+        insereFinalVetor(formas, criaForma(RECTANGLE, criaRetangulo(9999, -50, -50, 600, 600, "none", "none")));
+        
+        ContextoVisibilidade ctx = criaContextoVisibilidade(250, 250, formas, 'q', 10);
+        
+        srand(semente * 31);
+        for (int r = 0; r < 6; r++) {
+            // Remove alguns anteparos e insere outros
+            int n_rem = 1 + rand() % 3;
+            for (int k = 0; k < n_rem && getTamanhoVetor(formas) > 1; k++) {
+                Forma f = removeVetor(formas, 0);
+                if (getTipoForma(f) == ANTEPARO) desalocaForma(f);
+                else insereFinalVetor(formas, f);
+            }
+            int n_add = rand() % 3;
+            for (int k = 0; k < n_add; k++) {
+                float x = 20 + rand() % 180;
+                float y = 20 + rand() % 460;
+                adiciona_anteparo(formas, 500 + r * 10 + k, x, y, x + (rand() % 41) - 20, y + (rand() % 41) - 20);
+            }
+            
+            ASSERT_TRUE(atualizaContextoVisibilidade(ctx, formas), "Atualização deve ser aplicada");
+            ContextoVisibilidade novo = criaContextoVisibilidade(250, 250, formas, 'q', 10);
+            
+            if (!mesmos_vertices(getPoligonoVisibilidade(ctx), getPoligonoVisibilidade(novo))) {
+                poligonos_diferentes++;
+            }
+            for (int i = 0; i < 500; i++) {
+                float px = rand() % 500;
+                float py = rand() % 500;
+                if (pontoVisivel(ctx, px, py) != pontoVisivel(novo, px, py)) discordancias++;
+            }
+            rodadas++;
+            liberaContextoVisibilidade(novo);
+        }
+        
+        liberaContextoVisibilidade(ctx);
+        libera_cena(formas);
+    }
+    
+    printf("    %d atualizações, %d polígonos diferentes, %d pontos discordantes\n",
+           rodadas, poligonos_diferentes, discordancias);
+    ASSERT_EQUAL(0, poligonos_diferentes, "V(x) atualizado deve ter os vértices do recalculado");
+    ASSERT_EQUAL(0, discordancias, "pontoVisivel deve concordar com o recalculado");
+}
+
+/* Teste: Atualização recusada quando o retângulo envolvente muda */
+void teste_atualiza_envolvente_mudou() {
+    Vetor formas = criaVetor(0);
+    adiciona_anteparo(formas, 1, 10, -10, 10, 10);
+    ContextoVisibilidade ctx = criaContextoVisibilidade(0, 0, formas, 'q', 10);
+    
+    ASSERT_TRUE(atualizaContextoVisibilidade(ctx, formas), "Sem alterações o contexto já está em dia");
+    
+    adiciona_anteparo(formas, 2, 100, 100, 120, 100);
+    ASSERT_FALSE(atualizaContextoVisibilidade(ctx, formas), "Envolvente maior exige recriar o contexto");
+    ASSERT_FALSE(pontoVisivel(ctx, 15, 0), "Contexto recusado continua como estava");
+    
+    liberaContextoVisibilidade(ctx);
+    libera_cena(formas);
+}
+
+/* Teste: V(x) aproximado por raios concorda com o exato longe da fronteira */
+void teste_visibilidade_aproximada() {
+    Vetor formas = cria_cena_aleatoria(5, 60);
+    ContextoVisibilidade exato = criaContextoVisibilidade(250, 250, formas, 'q', 10);
+    ContextoVisibilidade aprox = criaContextoVisibilidadeAprox(250, 250, formas, 2048);
+    ASSERT_NOT_NULL(aprox, "Contexto aproximado deve ser criado");
+    ASSERT_NULL(criaContextoVisibilidadeAprox(250, 250, formas, 2), "Menos de 3 raios não formam polígono");
+    
+    ASSERT_EQUAL(2048, getNumVertices(getPoligonoVisibilidade(aprox)), "Um vértice por raio");
+    ASSERT_FLOAT_EQUAL(0.0f, getErroVisibilidade(exato), 1e-9f, "Contexto exato não tem erro");
+    float erro = getErroVisibilidade(aprox);
+    ASSERT_TRUE(erro > 0 && erro < 5, "Erro da aproximação deve ser pequeno com 2048 raios");
+    
+    // Longe da fronteira exata (mais que o erro) as duas regiões concordam
+    int discordancias = 0, comparados = 0;
+    srand(77);
+    for (int i = 0; i < 3000; i++) {
+        float px = rand() % 500;
+        float py = rand() % 500;
+        float theta = atan2f(py - 250, px - 250);
+        float d = sqrtf((px - 250) * (px - 250) + (py - 250) * (py - 250));
+        if (fabsf(d - profundidadeVisibilidade(exato, theta)) <= erro) continue;
+        comparados++;
+        if (pontoVisivel(exato, px, py) != pontoVisivel(aprox, px, py)) discordancias++;
+    }
+    printf("    %d pontos, %d discordâncias (erro %.2f)\n", comparados, discordancias, erro);
+    ASSERT_TRUE(discordancias * 100 < comparados, "Aproximação deve concordar em quase todos os pontos");
+    
+    ASSERT_FALSE(atualizaContextoVisibilidade(aprox, formas), "Contexto aproximado é sempre recriado");
+    
+    liberaContextoVisibilidade(exato);
+    liberaContextoVisibilidade(aprox);
+    libera_cena(formas);
+}
+
+/* Teste: Anteparo adicionado sobre o ângulo -pi muda o início da varredura */
+void teste_atualiza_anteparo_na_emenda() {
+    Vetor formas = criaVetor(0);
+    adiciona_anteparo(formas, 1, -30, -10, -30, 10);
+    adiciona_anteparo(formas, 2, 10, -40, 10, 40);
+    ContextoVisibilidade ctx = criaContextoVisibilidade(0, 0, formas, 'q', 10);
+    ASSERT_TRUE(pontoVisivel(ctx, -25, 0), "Antes da alteração o ponto é visível");
+    
+    adiciona_anteparo(formas, 3, -20, -20, -20, 20);
+    ASSERT_TRUE(atualizaContextoVisibilidade(ctx, formas), "Atualização deve ser aplicada");
+    ASSERT_FALSE(pontoVisivel(ctx, -25, 0), "Ponto atrás do novo anteparo em -pi");
+    ASSERT_FALSE(pontoVisivel(ctx, -25, 4), "Ponto atrás do novo anteparo acima de -pi");
+    ASSERT_TRUE(pontoVisivel(ctx, -15, 0), "Ponto antes do novo anteparo");
+    
+    liberaContextoVisibilidade(ctx);
+    libera_cena(formas);
+}
+
+/* Teste: Cache devolve o mesmo contexto para a mesma chave e recalcula quando a versão muda */
+void teste_cache_visibilidade() {
+    Vetor formas = cria_cena_aleatoria(11, 40);
+    CacheVisibilidade cache = criaCacheVisibilidade(2, 'q', 10, 0);
+
+    ContextoVisibilidade a = obtemContextoCache(cache, 250, 250, 0, formas);
+    ContextoVisibilidade b = obtemContextoCache(cache, 250, 250, 0, formas);
+    ASSERT_NOT_NULL(a, "Contexto deve ser criado");
+    ASSERT_TRUE(a == b, "Mesma chave deve devolver o mesmo contexto");
+    ASSERT_EQUAL(1, getAcertosCache(cache), "Segunda consulta deve ser acerto");
+    ASSERT_EQUAL(1, getFalhasCache(cache), "Primeira consulta deve ser falha");
+
+    // Polígono do cache igual ao de um cálculo novo
+    ContextoVisibilidade novo = criaContextoVisibilidade(250, 250, formas, 'q', 10);
+    Poligono pc = getPoligonoVisibilidade(b);
+    Poligono pn = getPoligonoVisibilidade(novo);
+    ASSERT_EQUAL(getNumVertices(pn), getNumVertices(pc), "Mesmo número de vértices");
+    bool iguais = true;
+    for (int i = 0; i < getNumVertices(pn) && i < getNumVertices(pc); i++) {
+        if (getXVertice(pn, i) != getXVertice(pc, i) || getYVertice(pn, i) != getYVertice(pc, i)) {
+            iguais = false;
+        }
+    }
+    ASSERT_TRUE(iguais, "Vértices do contexto em cache devem ser os do cálculo novo");
+    liberaContextoVisibilidade(novo);
+
+    // LRU com capacidade 2: (100,100) entra, (250,250) é usado, (400,400) expulsa (100,100)
+    obtemContextoCache(cache, 100, 100, 0, formas);
+    obtemContextoCache(cache, 250, 250, 0, formas);
+    obtemContextoCache(cache, 400, 400, 0, formas);
+    obtemContextoCache(cache, 250, 250, 0, formas);
+    ASSERT_EQUAL(3, getAcertosCache(cache), "(250,250) deve continuar no cache");
+    obtemContextoCache(cache, 100, 100, 0, formas);
+    ASSERT_EQUAL(4, getFalhasCache(cache), "(100,100) deve ter sido expulso");
+
+    // Nova versão: a entrada da mesma posição é atualizada, não recriada
+    adiciona_anteparo(formas, 900, 300, 300, 320, 310);
+    ContextoVisibilidade atualizado = obtemContextoCache(cache, 250, 250, 1, formas);
+    ASSERT_EQUAL(1, getAtualizacoesCache(cache), "Outra versão deve atualizar o contexto");
+    ASSERT_EQUAL(4, getFalhasCache(cache), "Atualização não conta como falha");
+    ASSERT_FALSE(pontoVisivel(atualizado, 350, 345), "Novo anteparo deve bloquear a visão");
+
+    liberaCacheVisibilidade(cache);
+    libera_cena(formas);
+}
+
+/* Auxiliar: Interiores dos segmentos PQ e AB se cruzam */
+static bool segmentos_cruzam(float px, float py, float qx, float qy,
+                             float ax, float ay, float bx, float by) {
+    double d1 = (qx - px) * (double)(ay - py) - (qy - py) * (double)(ax - px);
+    double d2 = (qx - px) * (double)(by - py) - (qy - py) * (double)(bx - px);
+    double d3 = (bx - ax) * (double)(py - ay) - (by - ay) * (double)(px - ax);
+    double d4 = (bx - ax) * (double)(qy - ay) - (by - ay) * (double)(qx - ax);
+    return ((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) &&
+           ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0));
+}
+
+/* Teste: V(x) com anteparos que se cruzam concorda com a linha de visão direta */
+void teste_visibilidade_equivale_forca_bruta() {
+    int discordancias = 0;
+    int total = 0;
+    
+    for (unsigned semente = 1; semente <= 5; semente++) {
+        Vetor formas = cria_cena_aleatoria(semente, 120);
+        ContextoVisibilidade ctx = criaContextoVisibilidade(250, 250, formas, 'q', 10);
+        
+        srand(semente * 7);
+        for (int i = 0; i < 2000; i++) {
+            float px = (rand() % 50000) / 100.0f;
+            float py = (rand() % 50000) / 100.0f;
+            bool visivel = true;
+            for (int q = 0; q < getTamanhoVetor(formas) && visivel; q++) {
+                Anteparo a = getDataForma(getElementoVetor(formas, q));
+                visivel = !segmentos_cruzam(250, 250, px, py, getX1Anteparo(a), getY1Anteparo(a),
+                                            getX2Anteparo(a), getY2Anteparo(a));
+            }
+            if (pontoVisivel(ctx, px, py) != visivel) discordancias++;
+            total++;
+        }
+        
+        liberaContextoVisibilidade(ctx);
+        libera_cena(formas);
+    }
+    
+    printf("    %d discordâncias em %d pontos\n", discordancias, total);
+    // Pontos rentes a um anteparo podem cair de qualquer lado por arredondamento
+    ASSERT_TRUE(discordancias * 500 < total, "V(x) deve concordar com a linha de visão direta");
+}
+
+/* Teste: Anteparos atingidos, como em pintura e destruição, concordam com a linha de visão direta */
+void teste_anteparos_atingidos_equivale_forca_bruta() {
+    const int amostras = 41;
+    int perdidos = 0;
+    int escondidos_atingidos = 0;
+    int visiveis = 0;
+    int total = 0;
+    
+    for (unsigned semente = 1; semente <= 10; semente++) {
+        // Anteparos longos e densos: muitos se cruzam e são cortados antes da varredura
+        Vetor formas = criaVetor(0);
+        srand(semente * 31);
+        for (int i = 0; i < 150; i++) {
+            float x = 20 + rand() % 460;
+            float y = 20 + rand() % 460;
+            if (x > 230 && x < 270 && y > 230 && y < 270) continue;
+            adiciona_anteparo(formas, i + 1, x, y, x + (rand() % 121) - 60, y + (rand() % 121) - 60);
+        }
+        ContextoVisibilidade ctx = criaContextoVisibilidade(250, 250, formas, 'q', 10);
+        int n = getTamanhoVetor(formas);
+        
+        for (int i = 0; i < n; i++) {
+            Forma f = getElementoVetor(formas, i);
+            Anteparo a = getDataForma(f);
+            float x1 = getX1Anteparo(a), y1 = getY1Anteparo(a);
+            float x2 = getX2Anteparo(a), y2 = getY2Anteparo(a);
+            
+            // Fração de pontos do anteparo vistos do observador sem passar por outro anteparo
+            int vistos = 0;
+            for (int k = 0; k < amostras; k++) {
+                float t = (k + 0.5f) / amostras;
+                float px = x1 + t * (x2 - x1), py = y1 + t * (y2 - y1);
+                bool visivel = true;
+                for (int q = 0; q < n && visivel; q++) {
+                    if (q == i) continue;
+                    Anteparo b = getDataForma(getElementoVetor(formas, q));
+                    visivel = !segmentos_cruzam(250, 250, px, py, getX1Anteparo(b), getY1Anteparo(b),
+                                                getX2Anteparo(b), getY2Anteparo(b));
+                }
+                vistos += visivel;
+            }
+            
+            bool atingido = formaAtingida(ctx, f);
+            // Anteparos vistos só de raspão ficam de fora: o arredondamento decide o lado
+            if (vistos >= 2) {
+                visiveis++;
+                if (!atingido) perdidos++;
+            } else if (vistos == 0 && atingido) {
+                escondidos_atingidos++;
+            }
+            total++;
+        }
+        
+        liberaContextoVisibilidade(ctx);
+        libera_cena(formas);
+    }
+    
+    printf("    %d anteparos, %d visíveis, %d perdidos, %d escondidos atingidos\n",
+           total, visiveis, perdidos, escondidos_atingidos);
+    ASSERT_EQUAL(0, perdidos, "Todo anteparo visível deve ser atingido");
+    // Um anteparo escondido que encosta num visível (cruzamento) toca V(x) e pode contar
+    ASSERT_TRUE(escondidos_atingidos * 100 < total, "Anteparos escondidos quase nunca são atingidos");
+}
+
+/* Auxiliar: Anel quadrado de anteparos em torno de (cx, cy) e anteparos aleatórios fora dele */
+static Vetor cria_cena_com_anel(float cx, float cy, float lado, int n_fora) {
+    Vetor formas = criaVetor(0);
+    float h = lado / 2;
+    adiciona_anteparo(formas, 1, cx - h, cy - h, cx + h, cy - h);
+    adiciona_anteparo(formas, 2, cx + h, cy - h, cx + h, cy + h);
+    adiciona_anteparo(formas, 3, cx + h, cy + h, cx - h, cy + h);
+    adiciona_anteparo(formas, 4, cx - h, cy + h, cx - h, cy - h);
+    
+    srand(17);
+    for (int i = 0; i < n_fora; i++) {
+        float x = rand() % 500;
+        float y = rand() % 500;
+        if (fabs(x - cx) < lado && fabs(y - cy) < lado) continue;
+        adiciona_anteparo(formas, 10 + i, x, y, x + (rand() % 21) - 10, y + (rand() % 21) - 10);
+    }
+    return formas;
+}
+
+/* Teste: Anteparos atrás de um anel fechado não entram na varredura */
+void teste_corte_anel_fechado() {
+    Vetor formas = cria_cena_com_anel(250, 250, 40, 200);
+    ContextoVisibilidade ctx = criaContextoVisibilidade(250, 250, formas, 'q', 10);
+    
+    ASSERT_EQUAL(8, getNumSegmentosVisibilidade(ctx), "Só o retângulo envolvente e o anel");
+    ASSERT_TRUE(pontoVisivel(ctx, 260, 255), "Ponto dentro do anel deve ser visível");
+    ASSERT_FALSE(pontoVisivel(ctx, 300, 250), "Ponto fora do anel não deve ser visível");
+    ASSERT_FALSE(pontoVisivel(ctx, 10, 490), "Ponto longe não deve ser visível");
+    
+    // Anteparo novo fora do anel continua escondido
+    adiciona_anteparo(formas, 500, 400, 400, 420, 420);
+    ASSERT_TRUE(atualizaContextoVisibilidade(ctx, formas), "Anteparo escondido não impede a atualização");
+    ASSERT_EQUAL(8, getNumSegmentosVisibilidade(ctx), "Anteparo escondido não entra");
+    
+    // Sem um lado do anel o corte deixa de valer
+    desalocaForma(removeVetor(formas, 0));
+    ASSERT_FALSE(atualizaContextoVisibilidade(ctx, formas), "Anel aberto exige recriar o contexto");
+    liberaContextoVisibilidade(ctx);
+    
+    ctx = criaContextoVisibilidade(250, 250, formas, 'q', 10);
+    ASSERT_TRUE(getNumSegmentosVisibilidade(ctx) > 100, "Sem o anel todos os anteparos entram");
+    ASSERT_TRUE(pontoVisivel(ctx, 250, 200), "Ponto pela abertura do anel deve ser visível");
+    
+    liberaContextoVisibilidade(ctx);
+    libera_cena(formas);
+}
+
+int main() {
+    RESETAR_ESTATISTICAS();
+    
+    EXECUTAR_TESTE(teste_anteparo_bloqueia_ponto);
+    EXECUTAR_TESTE(teste_anteparo_atras_bloqueia_ponto);
+    EXECUTAR_TESTE(teste_anteparos_cruzados);
+    EXECUTAR_TESTE(teste_ponto_visivel_equivale_ray_casting);
+    EXECUTAR_TESTE(teste_pontos_visiveis_lote);
+    EXECUTAR_TESTE(teste_profundidade_visibilidade);
+    EXECUTAR_TESTE(teste_forma_atingida_equivale_poligono);
+    EXECUTAR_TESTE(teste_anteparo_na_fronteira_atingido);
+    EXECUTAR_TESTE(teste_anteparos_da_cena_equivale_poligono);
+    EXECUTAR_TESTE(teste_visibilidade_equivale_forca_bruta);
+    EXECUTAR_TESTE(teste_anteparos_atingidos_equivale_forca_bruta);
+    EXECUTAR_TESTE(teste_corte_anel_fechado);
+    EXECUTAR_TESTE(teste_visibilidade_aproximada);
+    EXECUTAR_TESTE(teste_atualiza_equivale_recalculo);
+    EXECUTAR_TESTE(teste_atualiza_envolvente_mudou);
+    EXECUTAR_TESTE(teste_atualiza_anteparo_na_emenda);
+    EXECUTAR_TESTE(teste_cache_visibilidade);
+    
+    IMPRIMIR_RESUMO_TESTES("Módulo Visibilidade");
+    
+    return CODIGO_SAIDA_TESTE();
+}
@@ -58,14 +58,30 @@ void desalocaTextStyle(void* textstyle){
         return; 
     }
 
+    desalocaCamposTextStyle(textstyle);
+    free(textstyle);
+
+}
+
+void desalocaCamposTextStyle(void* textstyle){
+
+    if(!textstyle){
+
+        return; 
+    }
+
     TextStyle *ts = (TextStyle*)textstyle;
 
     free(ts->ff);
     free(ts->fw);
-    free(ts);
 
 }
 
+size_t getTamanhoTextStyle(void){
+
+    return sizeof(TextStyle);
+}
+
 char *getTextFF(void* textstyle) {
 
 
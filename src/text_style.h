@@ -13,6 +13,8 @@
 #ifndef TEXT_STYLE_H
 #define TEXT_STYLE_H
 
+#include <stddef.h>
+
 typedef void* TEXTSTYLE;
 
 /**
@@ -34,6 +36,22 @@ TEXTSTYLE criaTextStyle(char* ff, char* fw, int fs);
  */
 void desalocaTextStyle(void* textstyle);
 
+/**
+ * @brief Libera as strings do TextStyle, mas não a estrutura em si.
+ * 
+ * Usada quando a estrutura está embutida em outro bloco (ver criaForma()).
+ * 
+ * @param textstyle Ponteiro para o TextStyle. Se for NULL, nada acontece.
+ */
+void desalocaCamposTextStyle(void* textstyle);
+
+/**
+ * @brief Retorna o tamanho, em bytes, da estrutura de um TextStyle.
+ * 
+ * @return size_t Tamanho da estrutura.
+ */
+size_t getTamanhoTextStyle(void);
+
 /**
  * @brief Retorna a font family de um objeto TextStyle.
  * 
@@ -282,23 +282,51 @@ void setTxtTexto(TEXTO t, char *txt){
 
 void desalocaTexto(TEXTO t){
 
+    desalocaCamposTexto(t);
+    free(t);
+
+}
+
+void desalocaCamposTexto(TEXTO t){
+
     texto* tTemp = ((texto*)t);
 
     free(tTemp->txt);
     free(tTemp->corB);
     free(tTemp->corP);
- 
 
-    free(tTemp);
+}
+
+size_t getTamanhoTexto(void){
 
+    return sizeof(texto);
 }
 TEXTO clonaTexto(TEXTO t, int novo_id, float dx, float dy){
+    texto *clone = (texto*) malloc(sizeof(texto));
+    if(clone == NULL){
+        printf("Erro de alocação");
+        exit(1);
+    }
+    clonaTextoEm(clone, t, novo_id, dx, dy);
+    return clone;
+}
+
+void clonaTextoEm(void *destino, TEXTO t, int novo_id, float dx, float dy){
     texto *tTemp = ((texto*)t);
-    return criaTexto(novo_id,
-                    tTemp->x + dx,
-                    tTemp->y + dy,
-                    tTemp->corB,
-                    tTemp->corP,
-                    tTemp->ancora,
-                    tTemp->txt);
+    texto *clone = ((texto*)destino);
+
+    clone->id = novo_id;
+    clone->x = tTemp->x + dx;
+    clone->y = tTemp->y + dy;
+    clone->ancora = tTemp->ancora;
+    clone->corB =(char*)malloc(sizeof(char) * strlen(tTemp->corB)+1);
+    clone->corP =(char*)malloc(sizeof(char) * strlen(tTemp->corP)+1);
+    clone->txt =(char*)malloc(sizeof(char) * strlen(tTemp->txt)+1);
+    if(clone->corB == NULL || clone->corP == NULL || clone->txt == NULL){
+        printf("Erro de alocação");
+        exit(1);
+    }
+    strcpy(clone->corB, tTemp->corB);
+    strcpy(clone->corP, tTemp->corP);
+    strcpy(clone->txt, tTemp->txt);
 }
@@ -2,6 +2,8 @@
 #ifndef TEXTO_H
 #define TEXTO_H
 
+#include <stddef.h>
+
 
 /**
 * Interface para o módulo de manipulação de textos gráficos.
@@ -149,11 +151,37 @@ float calculoAreaTexto(TEXTO t);
  */
 void desalocaTexto(TEXTO t);
 
+/**
+ * @brief Libera o conteúdo e as cores do texto, mas não a estrutura em si.
+ *
+ * Usada quando a estrutura está embutida em outro bloco (ver criaForma()).
+ */
+void desalocaCamposTexto(TEXTO t);
+
+/**
+ * @brief Retorna o tamanho, em bytes, da estrutura de um texto.
+ */
+size_t getTamanhoTexto(void);
+
 /**
  * @brief Cria um clone do texto com novo ID e deslocamento.
  */
 TEXTO clonaTexto(TEXTO t, int novo_id, float dx, float dy);
 
+/**
+ * @brief Escreve um clone do texto, com novo ID e deslocamento, na memória indicada.
+ * 
+ * Como clonaTexto(), mas sem alocar a estrutura: destino deve ter
+ * getTamanhoTexto() bytes, alinhados para qualquer tipo.
+ * 
+ * @param destino Memória que recebe o clone.
+ * @param t Ponteiro para o texto original.
+ * @param novo_id Novo ID para o clone.
+ * @param dx Deslocamento em X.
+ * @param dy Deslocamento em Y.
+ */
+void clonaTextoEm(void *destino, TEXTO t, int novo_id, float dx, float dy);
+
 
 #endif 
 
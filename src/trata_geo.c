@@ -7,32 +7,51 @@
 #include "texto.h"
 #include "text_style.h"
 #include "anteparo.h"
+#include "bvh_segmentos.h"
+#include "colunas_formas.h"
+#include "curva_hilbert.h"
+#include "indice_ids.h"
+#include "sort.h"
+#include "sort_tipado.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
 #include "forma.h"
 
 
 
 typedef struct 
 {
-    Lista lista_formas;
+    Vetor formas;  // Todas as formas, na ordem de inserção
     Lista lista_para_free;
     Lista lista_svg;
     int maior_id;  // Armazena o maior ID encontrado durante o processamento
     char* nome_geo;  // Armazena o nome do arquivo GEO
+    unsigned int versao;  // Incrementada a cada inserção/remoção de forma
+    BVHSegmentos bvh;            // Anteparos da versao_bvh, para linhaDeVisao
+    SegmentoPlano* segs_bvh;
+    unsigned int versao_bvh;
+    IndiceIds indice_ids;        // ID -> forma, na ordem de formas
+    ColunasFormas colunas;       // Geometria de formas na versao_colunas, por tipo
+    unsigned int versao_colunas;
+    unsigned int proxima_seq;    // Sequência da próxima forma a entrar
+    Vetor formas_espaciais;      // As mesmas formas na ordem da curva de Hilbert (NULL se desativada)
+    int inseridas_desde_ordem;   // Formas que entraram no fim de formas_espaciais desde a última reordenação
 
 }Cidade_t;
 
-typedef struct 
-{
-
-    tipo_forma tipo;
-    void* data;
+// Bits por coordenada da grade da curva de Hilbert
+#define ORDEM_ESPACIAL_BITS 16
+// Reordena quando as formas inseridas no fim passam de 1/FRACAO do vetor (e de MIN)
+#define ORDEM_ESPACIAL_FRACAO 4
+#define ORDEM_ESPACIAL_MIN 64
 
+#define PONTEIRO_MENOR(a, b) (*(a) < *(b))
+SORT_TIPADO(ponteiros, uintptr_t, PONTEIRO_MENOR)
 
-}Forma_t;
-
+static void reordena_formas_espaciais(Cidade_t *chao_t);
 static void executa_comando_retangulo(Cidade_t *cidade);
 static void executa_comando_circulo(Cidade_t *cidade);
 static void executa_comando_linha(Cidade_t *cidade);
@@ -52,10 +71,20 @@ Cidade executa_comando_geo(DadosDoArquivo fileData,  char *caminho_output,  char
 
     } 
 
-    cidade->lista_formas = criaLista();
+    cidade->formas = criaVetor(0);
     cidade->lista_para_free = criaLista();
     cidade->lista_svg = criaLista();
     cidade->maior_id = 0;  // Inicializa o maior ID como 0
+    cidade->versao = 0;
+    cidade->bvh = NULL;
+    cidade->segs_bvh = NULL;
+    cidade->versao_bvh = 0;
+    cidade->indice_ids = criaIndiceIds();
+    cidade->colunas = NULL;
+    cidade->versao_colunas = 0;
+    cidade->proxima_seq = 0;
+    cidade->formas_espaciais = NULL;
+    cidade->inseridas_desde_ordem = 0;
     
     // Armazena o nome do arquivo GEO
     char *nome_orig = obter_nome_arquivo(fileData);
@@ -106,11 +135,11 @@ Cidade executa_comando_geo(DadosDoArquivo fileData,  char *caminho_output,  char
 
 }
 
-Lista get_lista_cidade(Cidade cidade){
+Vetor get_formas_cidade(Cidade cidade){
 
     Cidade_t *chao_t = (Cidade_t *)cidade;
 
-    return chao_t->lista_formas;
+    return chao_t->formas;
 }
 
 Lista get_lista_svg_cidade(Cidade cidade){
@@ -123,42 +152,20 @@ Lista get_lista_svg_cidade(Cidade cidade){
 void desaloca_geo(Cidade cidade){
 
     Cidade_t* chao_t = (Cidade_t *)cidade;
-    liberaLista(chao_t->lista_formas);
+    liberaVetor(chao_t->formas);
+    liberaVetor(chao_t->formas_espaciais);
     liberaLista(chao_t->lista_svg);
 
     while(!listaVazia(chao_t->lista_para_free)){
       
-        Forma_t  *forma = removeInicioLista(chao_t->lista_para_free);
-
-        
-        switch(forma->tipo){
-       
-            case CIRCLE:   desalocaCirculo(forma->data);
-            break;
-            
-            case RECTANGLE:  desalocarRetangulo(forma->data);
-            break;
-
-            case LINE: desalocaLinha(forma->data);
-            break;
-
-            case TEXT: desalocaTexto(forma->data);
-            break;
-
-            case TEXT_STYLE: desalocaTextStyle(forma->data);
-            break;
-
-            case ANTEPARO: desalocaAnteparo(forma->data);
-            break;
-
-            default:
-            break;
-
-          }
-          free(forma);
+        desalocaForma(removeInicioLista(chao_t->lista_para_free));
 
     }
     liberaLista(chao_t->lista_para_free);
+    liberaBVHSegmentos(chao_t->bvh);
+    free(chao_t->segs_bvh);
+    liberaIndiceIds(chao_t->indice_ids);
+    liberaColunasFormas(chao_t->colunas);
     if (chao_t->nome_geo) {
         free(chao_t->nome_geo);
     }
@@ -177,6 +184,262 @@ Lista obtem_lista_para_desalocar(Cidade cidade) {
 
 }
 
+// Formas que entram no fim do vetor desfazem aos poucos a ordem espacial
+static void verifica_ordem_espacial(Cidade_t *cidade, int inseridas) {
+    if (cidade->formas_espaciais == NULL) return;
+    cidade->inseridas_desde_ordem += inseridas;
+    int limiar = getTamanhoVetor(cidade->formas) / ORDEM_ESPACIAL_FRACAO;
+    if (limiar < ORDEM_ESPACIAL_MIN) limiar = ORDEM_ESPACIAL_MIN;
+    if (cidade->inseridas_desde_ordem >= limiar) reordena_formas_espaciais(cidade);
+}
+
+void insere_forma_cidade(Cidade cidade, Forma forma) {
+    Cidade_t *chao_t = (Cidade_t *)cidade;
+    setSeqForma(forma, chao_t->proxima_seq++);
+    insereFinalVetor(chao_t->formas, forma);
+    if (chao_t->formas_espaciais) insereFinalVetor(chao_t->formas_espaciais, forma);
+    insereFinalLista(chao_t->lista_svg, forma);
+    insereFinalLista(chao_t->lista_para_free, forma);
+    int id = getIDForma(forma);
+    if (id >= 0) insereIndiceIds(chao_t->indice_ids, id, forma);
+    chao_t->versao++;
+    verifica_ordem_espacial(chao_t, 1);
+}
+
+void remove_forma_cidade(Cidade cidade, Forma forma) {
+    Cidade_t *chao_t = (Cidade_t *)cidade;
+    removeElementoVetor(chao_t->formas, forma);
+    if (chao_t->formas_espaciais) removeElementoVetor(chao_t->formas_espaciais, forma);
+    removeElementoLista(chao_t->lista_svg, forma);
+    removeElementoLista(chao_t->lista_para_free, forma);
+    int id = getIDForma(forma);
+    if (id >= 0) removeIndiceIds(chao_t->indice_ids, id, forma);
+    chao_t->versao++;
+}
+
+// O endereço está no vetor ordenado?
+static bool contemPonteiro(const uintptr_t *v, int n, uintptr_t p) {
+    int lo = 0, hi = n;
+    while (lo < hi) {
+        int meio = lo + (hi - lo) / 2;
+        if (v[meio] < p) lo = meio + 1;
+        else hi = meio;
+    }
+    return lo < n && v[lo] == p;
+}
+
+// Retira da lista, numa só passada, as células cujo conteúdo está no vetor
+static void removeConjuntoLista(Lista lista, const uintptr_t *v, int n) {
+    Celula c = getInicioLista(lista);
+    while (c != NULL) {
+        Celula prox = getProxCelula(c);
+        if (contemPonteiro(v, n, (uintptr_t)getConteudoCelula(c))) removeCelula(lista, c, false);
+        c = prox;
+    }
+}
+
+// Compacta as formas, numa só passada, descartando as que estão no vetor
+static void removeConjuntoFormas(Vetor formas, const uintptr_t *v, int n) {
+    void **dados = getDadosVetor(formas);
+    int total = getTamanhoVetor(formas);
+    int k = 0;
+    for (int i = 0; i < total; i++) {
+        if (!contemPonteiro(v, n, (uintptr_t)dados[i])) dados[k++] = dados[i];
+    }
+    truncaVetor(formas, k);
+}
+
+void substitui_formas_cidade(Cidade cidade, Vetor remover, Vetor inserir) {
+    Cidade_t *chao_t = (Cidade_t *)cidade;
+    int n = getTamanhoVetor(remover);
+
+    if (n > 0) {
+        uintptr_t *v = malloc(n * sizeof(uintptr_t));
+        if (v == NULL) {
+            printf("Erro de alocação para formas a remover\n");
+            exit(1);
+        }
+        for (int k = 0; k < n; k++) {
+            Forma f = getElementoVetor(remover, k);
+            v[k] = (uintptr_t)f;
+            int id = getIDForma(f);
+            if (id >= 0) removeIndiceIds(chao_t->indice_ids, id, f);
+        }
+        ponteiros_quick_sort(v, n, SORT_LIMIAR_PADRAO);
+
+        removeConjuntoFormas(chao_t->formas, v, n);
+        if (chao_t->formas_espaciais) removeConjuntoFormas(chao_t->formas_espaciais, v, n);
+        removeConjuntoLista(chao_t->lista_svg, v, n);
+        removeConjuntoLista(chao_t->lista_para_free, v, n);
+        free(v);
+    }
+
+    anexaVetor(chao_t->formas, inserir);
+    if (chao_t->formas_espaciais) anexaVetor(chao_t->formas_espaciais, inserir);
+    for (int k = 0; k < getTamanhoVetor(inserir); k++) {
+        Forma f = getElementoVetor(inserir, k);
+        setSeqForma(f, chao_t->proxima_seq++);
+        insereFinalLista(chao_t->lista_svg, f);
+        insereFinalLista(chao_t->lista_para_free, f);
+        int id = getIDForma(f);
+        if (id >= 0) insereIndiceIds(chao_t->indice_ids, id, f);
+    }
+
+    if (n > 0 || !vetorVazio(inserir)) chao_t->versao++;
+    verifica_ordem_espacial(chao_t, getTamanhoVetor(inserir));
+}
+
+Forma busca_forma_id_cidade(Cidade cidade, int id) {
+    Cidade_t *chao_t = (Cidade_t *)cidade;
+    return buscaIndiceIds(chao_t->indice_ids, id);
+}
+
+int busca_faixa_ids_cidade(Cidade cidade, int i, int j, Vetor saida) {
+    Cidade_t *chao_t = (Cidade_t *)cidade;
+    return faixaIndiceIds(chao_t->indice_ids, i, j, saida);
+}
+
+unsigned int get_versao_cidade(Cidade cidade) {
+    Cidade_t *chao_t = (Cidade_t *)cidade;
+    return chao_t->versao;
+}
+
+// Refaz a hierarquia dos anteparos se a cidade mudou desde a última consulta
+static void atualiza_bvh_cidade(Cidade_t *cidade) {
+    if (cidade->segs_bvh != NULL && cidade->versao_bvh == cidade->versao) return;
+
+    liberaBVHSegmentos(cidade->bvh);
+    free(cidade->segs_bvh);
+    cidade->bvh = NULL;
+
+    int n_formas = getTamanhoVetor(cidade->formas);
+    int n = 0;
+    for (int i = 0; i < n_formas; i++) {
+        if (getTipoForma(getElementoVetor(cidade->formas, i)) == ANTEPARO) n++;
+    }
+
+    cidade->segs_bvh = malloc((n + 1) * sizeof(SegmentoPlano));
+    if (cidade->segs_bvh == NULL) {
+        printf("Erro de alocação para anteparos da cidade\n");
+        exit(1);
+    }
+
+    int k = 0;
+    for (int i = 0; i < n_formas; i++) {
+        Forma f = getElementoVetor(cidade->formas, i);
+        if (getTipoForma(f) != ANTEPARO) continue;
+        Anteparo a = getDataForma(f);
+        cidade->segs_bvh[k++] = (SegmentoPlano){getX1Anteparo(a), getY1Anteparo(a),
+                                                getX2Anteparo(a), getY2Anteparo(a)};
+    }
+    cidade->bvh = criaBVHSegmentos(cidade->segs_bvh, n);
+    cidade->versao_bvh = cidade->versao;
+}
+
+bool linhaDeVisao(Cidade cidade, float ax, float ay, float bx, float by) {
+    Cidade_t *chao_t = (Cidade_t *)cidade;
+    atualiza_bvh_cidade(chao_t);
+    return !segmentoBloqueadoBVH(chao_t->bvh, chao_t->segs_bvh, ax, ay, bx, by);
+}
+
+ColunasFormas get_colunas_cidade(Cidade cidade) {
+    Cidade_t *chao_t = (Cidade_t *)cidade;
+
+    // Refeitas só se a cidade mudou desde a última consulta
+    if (chao_t->colunas == NULL || chao_t->versao_colunas != chao_t->versao) {
+        liberaColunasFormas(chao_t->colunas);
+        chao_t->colunas = criaColunasFormas(get_formas_colunas_cidade(cidade));
+        chao_t->versao_colunas = chao_t->versao;
+    }
+    return chao_t->colunas;
+}
+
+Vetor get_formas_colunas_cidade(Cidade cidade) {
+    Cidade_t *chao_t = (Cidade_t *)cidade;
+    return chao_t->formas_espaciais ? chao_t->formas_espaciais : chao_t->formas;
+}
+
+// Refaz formas_espaciais a partir da ordem de inserção, ordenando pela curva de Hilbert
+static void reordena_formas_espaciais(Cidade_t *chao_t) {
+    int n = getTamanhoVetor(chao_t->formas);
+    chao_t->inseridas_desde_ordem = 0;
+
+    // As colunas guardam posições no vetor de formas_espaciais
+    liberaColunasFormas(chao_t->colunas);
+    chao_t->colunas = NULL;
+
+    truncaVetor(chao_t->formas_espaciais, 0);
+    anexaVetor(chao_t->formas_espaciais, chao_t->formas);
+    if (n < 2) return;
+
+    // Centro do retângulo envolvente de cada forma; estilos de texto não têm
+    float *cx = malloc(n * sizeof(float));
+    float *cy = malloc(n * sizeof(float));
+    ChaveRadix *chaves = malloc(n * sizeof(ChaveRadix));
+    void **copia = malloc(n * sizeof(void*));
+    if (!cx || !cy || !chaves || !copia) {
+        printf("Erro de alocação para reordenar formas\n");
+        exit(1);
+    }
+
+    float min_x = INFINITY, min_y = INFINITY, max_x = -INFINITY, max_y = -INFINITY;
+    for (int i = 0; i < n; i++) {
+        BoundingBox bb = getBBForma(getElementoVetor(chao_t->formas, i));
+        if (bb == NULL) {
+            cx[i] = NAN;
+            continue;
+        }
+        cx[i] = (getBBMinX(bb) + getBBMaxX(bb)) / 2;
+        cy[i] = (getBBMinY(bb) + getBBMaxY(bb)) / 2;
+        liberaBoundingBox(bb);
+        if (cx[i] < min_x) min_x = cx[i];
+        if (cx[i] > max_x) max_x = cx[i];
+        if (cy[i] < min_y) min_y = cy[i];
+        if (cy[i] > max_y) max_y = cy[i];
+    }
+
+    // Centros levados para uma grade de 2^16 x 2^16 células sobre o envolvente
+    float lado = fmaxf(max_x - min_x, max_y - min_y);
+    float escala = lado > 0 ? (float)((1 << ORDEM_ESPACIAL_BITS) - 1) / lado : 0;
+    for (int i = 0; i < n; i++) {
+        chaves[i].indice = i;
+        if (isnan(cx[i])) {
+            chaves[i].chave = UINT64_MAX;  // Sem geometria: vão para o fim
+            continue;
+        }
+        uint32_t gx = (uint32_t)((cx[i] - min_x) * escala);
+        uint32_t gy = (uint32_t)((cy[i] - min_y) * escala);
+        chaves[i].chave = indiceHilbert(gx, gy, ORDEM_ESPACIAL_BITS);
+    }
+
+    // Estável: formas na mesma célula mantêm a ordem de inserção
+    radix_sort_chaves(chaves, n);
+
+    void **dados = getDadosVetor(chao_t->formas_espaciais);
+    for (int i = 0; i < n; i++) copia[i] = dados[chaves[i].indice];
+    memcpy(dados, copia, n * sizeof(void*));
+
+    free(cx);
+    free(cy);
+    free(chaves);
+    free(copia);
+}
+
+void define_ordem_espacial_cidade(Cidade cidade, bool ativa) {
+    Cidade_t *chao_t = (Cidade_t *)cidade;
+    if (ativa) {
+        if (chao_t->formas_espaciais == NULL) {
+            chao_t->formas_espaciais = criaVetor(getTamanhoVetor(chao_t->formas));
+        }
+        reordena_formas_espaciais(chao_t);
+    } else if (chao_t->formas_espaciais != NULL) {
+        liberaVetor(chao_t->formas_espaciais);
+        chao_t->formas_espaciais = NULL;
+        liberaColunasFormas(chao_t->colunas);
+        chao_t->colunas = NULL;
+    }
+}
+
 //Funções Privadas
 static void executa_comando_circulo(Cidade_t *cidade){
 
@@ -197,16 +460,16 @@ static void executa_comando_circulo(Cidade_t *cidade){
         cidade->maior_id = id_num;
     }
   
-    Forma_t *forma = malloc(sizeof(Forma_t));
+    Forma forma = criaForma(CIRCLE, c);
     if (forma == NULL) {
       printf("Erro de alocação\n");
       exit(1);
     }
-    forma->tipo = CIRCLE;
-    forma->data = c;
-    insereFinalLista(cidade->lista_formas, forma);
+    setSeqForma(forma, cidade->proxima_seq++);
+    insereFinalVetor(cidade->formas, forma);
     insereFinalLista(cidade->lista_para_free, forma);
     insereFinalLista(cidade->lista_svg, forma);
+    insereIndiceIds(cidade->indice_ids, id_num, forma);
 }
 
 
@@ -229,16 +492,16 @@ static void executa_comando_retangulo(Cidade_t *cidade) {
         cidade->maior_id = id_num;
     }
   
-    Forma_t *forma = malloc(sizeof(Forma_t));
+    Forma forma = criaForma(RECTANGLE, r);
     if (forma == NULL) {
       printf("Erro de alocação\n");
       exit(1);
     }
-    forma->tipo = RECTANGLE;
-    forma->data = r;
-    insereFinalLista(cidade->lista_formas, forma);
+    setSeqForma(forma, cidade->proxima_seq++);
+    insereFinalVetor(cidade->formas, forma);
     insereFinalLista(cidade->lista_para_free, forma);
     insereFinalLista(cidade->lista_svg, forma);
+    insereIndiceIds(cidade->indice_ids, id_num, forma);
   }
 
   static void executa_comando_linha(Cidade_t *cidade) {
@@ -258,16 +521,16 @@ static void executa_comando_retangulo(Cidade_t *cidade) {
         cidade->maior_id = id_num;
     }
   
-    Forma_t *forma = malloc(sizeof(Forma_t));
+    Forma forma = criaForma(LINE, l);
     if (forma == NULL) {
       printf("Erro de alocação\n");
       exit(1);
     }
-    forma->tipo = LINE;
-    forma->data = l;
-    insereFinalLista(cidade->lista_formas, forma);
+    setSeqForma(forma, cidade->proxima_seq++);
+    insereFinalVetor(cidade->formas, forma);
     insereFinalLista(cidade->lista_para_free, forma);
     insereFinalLista(cidade->lista_svg, forma);
+    insereIndiceIds(cidade->indice_ids, id_num, forma);
   }
 
   static void executa_comando_texto(Cidade_t *cidade) {
@@ -288,16 +551,16 @@ static void executa_comando_retangulo(Cidade_t *cidade) {
         cidade->maior_id = id_num;
     }
   
-    Forma_t *forma = malloc(sizeof(Forma_t));
+    Forma forma = criaForma(TEXT, t);
     if (forma == NULL) {
       printf("Erro de alocação\n");
       exit(1);
     }
-    forma->tipo = TEXT;
-    forma->data = t;
-    insereFinalLista(cidade->lista_formas, forma);
+    setSeqForma(forma, cidade->proxima_seq++);
+    insereFinalVetor(cidade->formas, forma);
     insereFinalLista(cidade->lista_para_free, forma);
     insereFinalLista(cidade->lista_svg, forma);
+    insereIndiceIds(cidade->indice_ids, id_num, forma);
   }
 
 
@@ -310,14 +573,13 @@ static void executa_comando_retangulo(Cidade_t *cidade) {
     TEXTSTYLE ts =
         criaTextStyle(ff, fw, atoi(fs));
   
-    Forma_t *forma = malloc(sizeof(Forma_t));
+    Forma forma = criaForma(TEXT_STYLE, ts);
     if (forma == NULL) {
       printf("Erro de alocação\n");
       exit(1);
     }
-    forma->tipo = TEXT_STYLE;
-    forma->data = ts;
-    insereFinalLista(cidade->lista_formas, forma);
+    setSeqForma(forma, cidade->proxima_seq++);
+    insereFinalVetor(cidade->formas, forma);
     insereFinalLista(cidade->lista_para_free, forma);
     insereFinalLista(cidade->lista_svg, forma);
 
@@ -378,10 +640,11 @@ static void cria_lista_svg(Cidade_t *cidade, char* caminho_output, DadosDoArquiv
     file,
     "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 1000 1000\">\n");
     while (!listaVazia(cidade->lista_svg)) {
-    Forma_t *forma = removeFinalLista(cidade->lista_svg);
+    Forma forma = removeFinalLista(cidade->lista_svg);
     if (forma != NULL) {
-      if (forma->tipo == CIRCLE) {
-        CIRCULO c = (CIRCULO)forma->data;
+      tipo_forma tipo = getTipoForma(forma);
+      if (tipo == CIRCLE) {
+        CIRCULO c = (CIRCULO)getDataForma(forma);
 
 
     fprintf(
@@ -392,8 +655,8 @@ static void cria_lista_svg(Cidade_t *cidade, char* caminho_output, DadosDoArquiv
     getCorBCirculo(c));
 
 
-    } else if (forma->tipo == RECTANGLE) {
-    RETANGULO r = (RETANGULO)forma->data;
+    } else if (tipo == RECTANGLE) {
+    RETANGULO r = (RETANGULO)getDataForma(forma);
     fprintf(file,
     "<rect x='%.2f' y='%.2f' width='%.2f' height='%.2f' fill='%s' "
     "stroke='%s'/>\n",
@@ -403,16 +666,16 @@ static void cria_lista_svg(Cidade_t *cidade, char* caminho_output, DadosDoArquiv
     getCorBRetangulo(r));
 
 
-    } else if (forma->tipo == LINE) {
-    LINHA l = (LINHA)forma->data;
+    } else if (tipo == LINE) {
+    LINHA l = (LINHA)getDataForma(forma);
     fprintf(file,
     "<line x1='%.2f' y1='%.2f' x2='%.2f' y2='%.2f' stroke='%s'/>\n",
     getX1Linha(l), getY1Linha(l), getX2Linha(l),
     getY2Linha(l), getCorLinha(l));
 
 
-    } else if (forma->tipo == TEXT) {
-    TEXTO t = (TEXTO)forma->data;
+    } else if (tipo == TEXT) {
+    TEXTO t = (TEXTO)getDataForma(forma);
     char ancora = getAncoraTexto(t);
      char *texto_ancora = "start"; 
 
@@ -1,8 +1,12 @@
 #ifndef TRATA_GEO_H
 #define TRATA_GEO_H
 
+#include <stdbool.h>
 #include "lista.h"
+#include "vetor.h"
+#include "colunas_formas.h"
 #include "leitor_arquivos.h" 
+#include "forma.h"
 
 /**
   Módulo responsável por interpretar e executar comandos do arquivo `.geo`, 
@@ -37,15 +41,18 @@ typedef void* Cidade;
 Cidade executa_comando_geo(DadosDoArquivo fileData, char *caminho_output,  char *sufixo_comando);
 
 /**
- * @brief Retorna a fila contendo todas as formas geométricas criadas no contexto `Cidade`.
+ * @brief Retorna o vetor contendo todas as formas geométricas do contexto `Cidade`.
  * 
- * Essa fila pode ser usada para processamento adicional ou visualização das formas
- * fora do módulo `trata_geo`.
+ * As formas ficam na ordem em que foram inseridas (a ordem do `.geo`, seguida
+ * das criadas pelo `.qry`). O vetor pode ser percorrido para processamento
+ * adicional ou visualização das formas fora do módulo `trata_geo`, mas não
+ * deve ser alterado diretamente: use `insere_forma_cidade` e
+ * `remove_forma_cidade`.
  * 
  * @param cidade Contexto de execução retornado por `executa_comando_geo`.
- * @return Fila com os elementos gráficos processados.
+ * @return Vetor com os elementos gráficos processados.
  */
-Lista get_lista_cidade(Cidade cidade);
+Vetor get_formas_cidade(Cidade cidade);
 
 /**
  * @brief Retorna a lista de formas para SVG
@@ -75,6 +82,147 @@ void desaloca_geo(Cidade cidade);
 */
 Lista obtem_lista_para_desalocar(Cidade cidade); 
 
+/**
+ * @brief Insere uma forma na cidade (lista de formas, de SVG e de desalocação).
+ *
+ * Incrementa a versão da cidade.
+ *
+ * @param cidade Contexto de execução retornado por `executa_comando_geo`.
+ * @param forma Forma a ser inserida; passa a ser desalocada por `desaloca_geo`.
+ */
+void insere_forma_cidade(Cidade cidade, Forma forma);
+
+/**
+ * @brief Remove uma forma das listas da cidade, sem desalocá-la.
+ *
+ * Incrementa a versão da cidade.
+ *
+ * @param cidade Contexto de execução retornado por `executa_comando_geo`.
+ * @param forma Forma a ser removida; o chamador passa a ser responsável por ela.
+ */
+void remove_forma_cidade(Cidade cidade, Forma forma);
+
+/**
+ * @brief Remove um lote de formas e insere outro, numa só alteração.
+ *
+ * Equivale a chamar `remove_forma_cidade` para cada forma de `remover` e
+ * depois `insere_forma_cidade` para cada forma de `inserir`, mas percorre
+ * as formas da cidade uma única vez em vez de uma vez por forma removida, e
+ * incrementa a versão da cidade uma só vez.
+ *
+ * @param cidade Contexto de execução retornado por `executa_comando_geo`.
+ * @param remover Formas a remover (não são desalocadas; o chamador passa a
+ *                ser responsável por elas), ou NULL.
+ * @param inserir Formas a inserir, na ordem do vetor; passam a ser
+ *                desalocadas por `desaloca_geo`. Pode ser NULL.
+ */
+void substitui_formas_cidade(Cidade cidade, Vetor remover, Vetor inserir);
+
+/**
+ * @brief Retorna a versão do conjunto de formas da cidade.
+ *
+ * A versão muda a cada inserção ou remoção de forma. Alterar apenas atributos
+ * de uma forma (como a cor) não muda a versão. Dois instantes com a mesma
+ * versão têm os mesmos anteparos e o mesmo retângulo envolvente, logo a mesma
+ * região de visibilidade para um mesmo ponto.
+ *
+ * @param cidade Contexto de execução retornado por `executa_comando_geo`.
+ * @return Versão atual.
+ */
+unsigned int get_versao_cidade(Cidade cidade);
+
+/**
+ * @brief Busca uma forma da cidade pelo ID.
+ *
+ * A cidade mantém um índice hash (indice_ids.h) de ID para forma,
+ * atualizado na leitura do `.geo`, em `insere_forma_cidade` e em
+ * `remove_forma_cidade`. Custo O(1) esperado.
+ *
+ * @param cidade Contexto de execução retornado por `executa_comando_geo`.
+ * @param id ID procurado.
+ * @return A forma com esse ID (a mais antiga, se houver repetição), ou NULL.
+ */
+Forma busca_forma_id_cidade(Cidade cidade, int id);
+
+/**
+ * @brief Coleta as formas da cidade com ID na faixa [i, j].
+ *
+ * As formas são inseridas no final de `saida` na mesma ordem em que aparecem
+ * em `get_formas_cidade`, sem percorrê-las: custa O(log n + k log k) para k formas
+ * encontradas, mais os IDs ainda fora de ordem no índice (veja
+ * faixaIndiceIds()), por mais larga e esparsa que seja a faixa.
+ *
+ * @param cidade Contexto de execução retornado por `executa_comando_geo`.
+ * @param i Menor ID da faixa.
+ * @param j Maior ID da faixa.
+ * @param saida Vetor que recebe as formas.
+ * @return Número de formas encontradas.
+ */
+int busca_faixa_ids_cidade(Cidade cidade, int i, int j, Vetor saida);
+
+/**
+ * @brief Verifica se o ponto A enxerga o ponto B.
+ *
+ * O segmento AB é testado contra uma hierarquia de caixas envolventes
+ * (bvh_segmentos.h) dos anteparos da cidade, parando no primeiro que o
+ * cruza: O(log n) numa consulta típica, sem montar a região de visibilidade.
+ * A hierarquia é refeita na primeira consulta depois que a versão da cidade
+ * muda.
+ *
+ * Como em pontoVisivel(), só um cruzamento próprio bloqueia: AB que apenas
+ * encosta num anteparo continua livre.
+ *
+ * @param cidade Contexto de execução retornado por `executa_comando_geo`.
+ * @param ax Coordenada X de A.
+ * @param ay Coordenada Y de A.
+ * @param bx Coordenada X de B.
+ * @param by Coordenada Y de B.
+ * @return true se nenhum anteparo cruza AB.
+ */
+bool linhaDeVisao(Cidade cidade, float ax, float ay, float bx, float by);
+
+/**
+ * @brief Retorna a geometria das formas da cidade em colunas por tipo.
+ *
+ * As colunas (colunas_formas.h) são refeitas na primeira consulta depois de
+ * a versão da cidade mudar ou de as formas serem reordenadas, e as posições
+ * que elas devolvem se referem ao vetor de `get_formas_colunas_cidade`
+ * nesse momento. Não devem ser liberadas pelo chamador.
+ *
+ * @param cidade Contexto de execução retornado por `executa_comando_geo`.
+ * @return Colunas da versão atual.
+ */
+ColunasFormas get_colunas_cidade(Cidade cidade);
+
+/**
+ * @brief Retorna o vetor de formas a que se referem as posições das colunas.
+ *
+ * Sem a ordem espacial é o próprio vetor de `get_formas_cidade`. Com ela, é
+ * um segundo vetor com as mesmas formas, ordenadas ao longo da curva de
+ * Hilbert. Não deve ser alterado.
+ *
+ * @param cidade Contexto de execução retornado por `executa_comando_geo`.
+ * @return Vetor de formas das colunas.
+ */
+Vetor get_formas_colunas_cidade(Cidade cidade);
+
+/**
+ * @brief Ativa ou desativa a ordem espacial das formas das colunas.
+ *
+ * Ativada, a cidade mantém, além do vetor na ordem de inserção, um vetor com
+ * as mesmas formas ordenadas pela posição do centro do retângulo envolvente
+ * na curva de Hilbert (curva_hilbert.h), e as colunas passam a segui-lo:
+ * formas próximas no plano ficam próximas nas colunas. Estilos de texto vão
+ * para o fim. Formas novas entram no fim desse vetor, e ele é reordenado
+ * quando elas passam de um quarto do total (como depois de muitas
+ * clonagens). A ordem de inserção, a lista de SVG e a versão da cidade não
+ * mudam. Desativada, o vetor extra é descartado.
+ *
+ * @param cidade Contexto de execução retornado por `executa_comando_geo`.
+ * @param ativa true para manter as formas na ordem da curva de Hilbert.
+ */
+void define_ordem_espacial_cidade(Cidade cidade, bool ativa);
+
 /**
  * @brief Retorna o maior ID de forma processado durante a leitura do arquivo `.geo`.
  * 
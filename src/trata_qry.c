@@ -1,5 +1,6 @@
 #include "trata_qry.h"
 #include "lista.h"
+#include "vetor.h"
 #include "leitor_arquivos.h"
 #include "forma.h"
 #include "circulo.h"
@@ -9,6 +10,9 @@
 #include "anteparo.h"
 #include "visibilidade.h"
 #include "poligono.h"
+#include "cache_visibilidade.h"
+#include "sort.h"
+#include "sort_tipado.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -27,9 +31,14 @@ typedef struct {
     FILE* txt_file;
     char tipo_sort;
     int threshold;
+    int n_raios_vis;  // > 0: visibilidade aproximada por raios
     Lista visibility_polygons; 
+    CacheVisibilidade cache_vis;  // Contextos por (x, y, versão da cidade)
 } Qry_t;
 
+#define SEQ_MENOR(a, b) (getSeqForma(*(a)) < getSeqForma(*(b)))
+SORT_TIPADO(formas_seq, Forma, SEQ_MENOR)
+
 static void executa_comando_anteparo(Qry_t *qry, char *linha);
 static void executa_comando_destruicao(Qry_t *qry, char *linha);
 static void executa_comando_pintura(Qry_t *qry, char *linha);
@@ -37,7 +46,8 @@ static void executa_comando_clonagem(Qry_t *qry, char *linha);
 static void cria_svg_qry(Qry_t *qry, DadosDoArquivo fileData);
 
 Qry executa_comando_qry(DadosDoArquivo fileData, Cidade cidade, 
-                        char *caminho_output, int maior_id_inicial, char tipo_sort, int threshold) {
+                        char *caminho_output, int maior_id_inicial, char tipo_sort, int threshold,
+                        int n_raios_vis) {
     
     Qry_t *qry = malloc(sizeof(Qry_t));
     
@@ -52,7 +62,10 @@ Qry executa_comando_qry(DadosDoArquivo fileData, Cidade cidade,
     qry->maior_id_atual = maior_id_inicial;
     qry->tipo_sort = tipo_sort;
     qry->threshold = threshold;
+    qry->n_raios_vis = n_raios_vis;
     qry->visibility_polygons = criaLista(); // Inicializa lista de polígonos de visibilidade
+    qry->cache_vis = criaCacheVisibilidade(CACHE_VIS_CAPACIDADE_PADRAO, tipo_sort, threshold,
+                                         n_raios_vis);
     
    
     qry->caminho_output = malloc(strlen(caminho_output) + 1);
@@ -162,29 +175,19 @@ static void executa_comando_anteparo(Qry_t *qry, char *linha) {
     
     
     
-    Lista lista_formas = get_lista_cidade(qry->cidade);
-    Lista lista_svg = get_lista_svg_cidade(qry->cidade);
-    Lista lista_free = obtem_lista_para_desalocar(qry->cidade);
+    // Formas da faixa pelo índice de IDs da cidade, na ordem das formas da cidade
+    Vetor na_faixa = criaVetor(0);
+    int n_faixa = busca_faixa_ids_cidade(qry->cidade, i, j, na_faixa);
     
-    Lista to_remove = criaLista();
-    Lista to_add = criaLista();
+    Vetor to_remove = criaVetor(n_faixa);
+    Vetor to_add = criaVetor(n_faixa);
     
-    Celula aux = getInicioLista(lista_formas);
-    while(aux != NULL) {
-        Forma f = getConteudoCelula(aux);
+    for (int k_faixa = 0; k_faixa < n_faixa; k_faixa++) {
+        Forma f = getElementoVetor(na_faixa, k_faixa);
         tipo_forma tipo = getTipoForma(f);
-        void* data = getDataForma(f);
-        int id = -1;
-        
-        switch(tipo) {
-            case CIRCLE: id = getIDCirculo(data); break;
-            case RECTANGLE: id = getIDRetangulo(data); break;
-            case LINE: id = getIDLinha(data); break;
-            case TEXT: id = getIDTexto(data); break;
-            default: break;
-        }
+        int id = getIDForma(f);
         
-        if (id >= i && id <= j) {
+        if (tipo != ANTEPARO) {
           
             if (tipo == RECTANGLE) {
                 Anteparo anteparos[4];
@@ -195,13 +198,15 @@ static void executa_comando_anteparo(Qry_t *qry, char *linha) {
                 for(int k=0; k<4; k++) {
                     if (anteparos[k] != NULL) {
                         Forma novo = criaForma(ANTEPARO, anteparos[k]);
-                        insereFinalLista(to_add, novo);
+                        insereFinalVetor(to_add, novo);
+                        // criaForma incorpora o anteparo: os dados agora estão na forma
+                        Anteparo a = getDataForma(novo);
                         
                         if (qry->txt_file) {
                             fprintf(qry->txt_file, "  Anteparo ID %d: (%.2f, %.2f) -> (%.2f, %.2f)\n", 
-                                getIDAnteparo(anteparos[k]), 
-                                getX1Anteparo(anteparos[k]), getY1Anteparo(anteparos[k]),
-                                getX2Anteparo(anteparos[k]), getY2Anteparo(anteparos[k]));
+                                getIDAnteparo(a), 
+                                getX1Anteparo(a), getY1Anteparo(a),
+                                getX2Anteparo(a), getY2Anteparo(a));
                         }
                     }
                 }
@@ -209,7 +214,8 @@ static void executa_comando_anteparo(Qry_t *qry, char *linha) {
                 Anteparo a = transforma_em_anteparo(f, h_ou_v, ++qry->maior_id_atual);
                 if (a != NULL) {
                     Forma novo = criaForma(ANTEPARO, a);
-                    insereFinalLista(to_add, novo);
+                    insereFinalVetor(to_add, novo);
+                    a = getDataForma(novo);
                     
                     if (qry->txt_file) {
                         char *tipo_str = (tipo==CIRCLE?"Circulo":(tipo==LINE?"Linha":"Texto"));
@@ -220,105 +226,84 @@ static void executa_comando_anteparo(Qry_t *qry, char *linha) {
                     }
                 }
             }
-            insereFinalLista(to_remove, f);
+            insereFinalVetor(to_remove, f);
         }
-        aux = getProxCelula(aux);
     }
+    liberaVetor(na_faixa);
     
+    // Troca as formas convertidas pelos anteparos de uma vez só
+    substitui_formas_cidade(qry->cidade, to_remove, to_add);
     
-    while(!listaVazia(to_remove)) {
-        Forma f = removeInicioLista(to_remove);
-        removeElementoLista(lista_formas, f);
-        removeElementoLista(lista_svg, f);
-        removeElementoLista(lista_free, f);
+    while(!vetorVazio(to_remove)) {
+        Forma f = removeFinalVetor(to_remove);
         desalocaForma(f);
     }
-    liberaLista(to_remove);
-    
-   
-    while(!listaVazia(to_add)) {
-        Forma f = removeInicioLista(to_add);
-        insereFinalLista(lista_formas, f);
-        insereFinalLista(lista_svg, f);
-        insereFinalLista(lista_free, f);
-    }
-    liberaLista(to_add);
+    liberaVetor(to_remove);
+    liberaVetor(to_add);
 }
 
+// O polígono pertence ao contexto, que pertence ao cache: vale até a próxima consulta ao cache
 static Poligono calculaPoligonoVisibilidade(ContextoVisibilidade ctx, float x, float y) {
     (void)x; 
     (void)y; 
     
-    // Obtém a região de visibilidade como lista de segmentos
-    Lista segmentos_vis = getRegiaoVisibilidade(ctx);
+    Poligono regiao_visibilidade = getPoligonoVisibilidade(ctx);
     
-    if (!segmentos_vis || listaVazia(segmentos_vis)) {
+    if (!regiao_visibilidade || getNumVertices(regiao_visibilidade) == 0) {
         return NULL;
     }
     
-    // Cria polígono a partir dos segmentos
-    
-    Poligono regiao_visibilidade = criaPoligono();
-    if (!regiao_visibilidade) return NULL;
-    
-    // Adiciona todos os pontos iniciais dos segmentos
-    // Isso garante que toda a região visível seja coberta
-    for (Celula c = getInicioLista(segmentos_vis); c; c = getProxCelula(c)) {
-        SegmentoVisibilidade seg = getConteudoCelula(c);
-        float x1, y1, x2, y2;
-        getCoordenadasSegmentoVis(seg, &x1, &y1, &x2, &y2);
-        
-        Ponto p1 = criaPonto(x1, y1);
-        insereVertice(regiao_visibilidade, p1);
-        liberaPonto(p1);
-    }
-    
     return regiao_visibilidade;
 }
 
 
-static void destroiFormasEmColisao(Lista lista_formas, Poligono regiao_visibilidade, Qry_t *qry) {
-    Lista lista_svg = get_lista_svg_cidade(qry->cidade);
-    Lista lista_free = obtem_lista_para_desalocar(qry->cidade);
-    BoundingBox bb_poly_orig = getBoundingBox(regiao_visibilidade);
+// Formas da cidade atingidas pela bomba, na ordem de inserção. O teste rápido
+// (retângulo envolvente contra o de V(x)) percorre as colunas de geometria da
+// cidade; só as candidatas passam pelo teste preciso de formaAtingida
+static Vetor coletaFormasAtingidas(Qry_t *qry, ContextoVisibilidade ctx,
+                                   Poligono regiao_visibilidade) {
+    ColunasFormas colunas = get_colunas_cidade(qry->cidade);
+    Vetor formas = get_formas_colunas_cidade(qry->cidade);
     
     // Expande BB do polígono com uma margem de tolerância para garantir 
     // que as paredes que delimitam a visibilidade sejam capturadas
+    BoundingBox bb_poly = getBoundingBox(regiao_visibilidade);
     float margem = 1.0f;
-    BoundingBox bb_poly = criaBoundingBox(
-        getBBMinX(bb_poly_orig) - margem,
-        getBBMinY(bb_poly_orig) - margem,
-        getBBMaxX(bb_poly_orig) + margem,
-        getBBMaxY(bb_poly_orig) + margem
-    );
-    liberaBoundingBox(bb_poly_orig);
-    
-    
-    Lista formas_para_destruir = criaLista();
+    int* candidatas = malloc((getNumFormasColunas(colunas) + 1) * sizeof(int));
+    if (candidatas == NULL) {
+        printf("Erro de alocação para formas candidatas\n");
+        exit(1);
+    }
+    int n = candidatasColunasFormas(colunas,
+                                    getBBMinX(bb_poly) - margem, getBBMinY(bb_poly) - margem,
+                                    getBBMaxX(bb_poly) + margem, getBBMaxY(bb_poly) + margem,
+                                    candidatas);
+    liberaBoundingBox(bb_poly);
     
-    // Coleta formas a destruir
-    for (Celula c = getInicioLista(lista_formas); c; c = getProxCelula(c)) {
-        Forma f = getConteudoCelula(c);
-        
-        BoundingBox bb_forma = getBBForma(f);
-        
-        // Teste rápido: Bounding Box
-        if (haInterseccaoBB(bb_poly, bb_forma)) {
-            // Teste preciso: verifica se a forma intersecta o polígono
-            if (formaIntersectaPoligono(regiao_visibilidade, f)) {
-                insereFinalLista(formas_para_destruir, f);
-            }
+    Vetor atingidas = criaVetor(0);
+    for (int i = 0; i < n; i++) {
+        Forma f = getElementoVetor(formas, candidatas[i]);
+        if (formaAtingida(ctx, f)) {
+            insereFinalVetor(atingidas, f);
         }
-        liberaBoundingBox(bb_forma);
     }
-
-
-    liberaBoundingBox(bb_poly);
+    free(candidatas);
     
-    // Destrói as formas coletadas
-    int count = 0;
-    while (!listaVazia(formas_para_destruir)) {
-        Forma f = removeInicioLista(formas_para_destruir);
+    // As candidatas vêm agrupadas por tipo e, com a ordem espacial, na ordem da
+    // curva de Hilbert; os relatórios e as formas criadas seguem a de inserção
+    formas_seq_quick_sort((Forma*)getDadosVetor(atingidas), getTamanhoVetor(atingidas),
+                          SORT_LIMIAR_PADRAO);
+    return atingidas;
+}
+
+static void destroiFormasEmColisao(ContextoVisibilidade ctx,
+                                   Poligono regiao_visibilidade, Qry_t *qry) {
+    Vetor formas_para_destruir = coletaFormasAtingidas(qry, ctx, regiao_visibilidade);
+    
+    // Registra as formas coletadas e as retira da cidade de uma vez só
+    int count = getTamanhoVetor(formas_para_destruir);
+    for (int i = 0; i < count; i++) {
+        Forma f = getElementoVetor(formas_para_destruir, i);
         tipo_forma tipo = getTipoForma(f);
         void* data = getDataForma(f);
         
@@ -337,15 +322,14 @@ static void destroiFormasEmColisao(Lista lista_formas, Poligono regiao_visibilid
         if (qry->txt_file && id != -1) {
             fprintf(qry->txt_file, "  Destruído: %s ID %d\n", tipo_str, id);
         }
-        
-        removeElementoLista(lista_formas, f);
-        removeElementoLista(lista_svg, f);
-        removeElementoLista(lista_free, f);
-        desalocaForma(f);
-        count++;
     }
     
-    liberaLista(formas_para_destruir);
+    substitui_formas_cidade(qry->cidade, formas_para_destruir, NULL);
+    
+    while (!vetorVazio(formas_para_destruir)) {
+        desalocaForma(removeFinalVetor(formas_para_destruir));
+    }
+    liberaVetor(formas_para_destruir);
     
     if (qry->txt_file) {
         fprintf(qry->txt_file, "Total de formas destruídas: %d\n", count);
@@ -363,7 +347,8 @@ static void geraSVGVisibilidade(Poligono regiao_visibilidade, float x, float y,
         
         VisibilityData* vis_data = malloc(sizeof(VisibilityData));
         if (vis_data) {
-            vis_data->poligono = regiao_visibilidade;
+            // Cópia própria: o original é liberado junto com o contexto
+            vis_data->poligono = copiaPoligono(regiao_visibilidade);
             vis_data->bomb_x = x;
             vis_data->bomb_y = y;
             insereFinalLista(qry->visibility_polygons, vis_data);
@@ -425,10 +410,10 @@ static void geraSVGVisibilidade(Poligono regiao_visibilidade, float x, float y,
                     vb_x, vb_y, vb_w, vb_h);
             
             fprintf(svg_file, "<polygon points=\"");
-            Lista vertices = getVertices(regiao_visibilidade);
-            for (Celula c = getInicioLista(vertices); c; c = getProxCelula(c)) {
-                Ponto p = (Ponto)getConteudoCelula(c);
-                fprintf(svg_file, "%.2f,%.2f ", getPontoX(p), getPontoY(p));
+            int n_vertices = getNumVertices(regiao_visibilidade);
+            for (int i = 0; i < n_vertices; i++) {
+                fprintf(svg_file, "%.2f,%.2f ", getXVertice(regiao_visibilidade, i),
+                        getYVertice(regiao_visibilidade, i));
             }
             fprintf(svg_file, "\" fill=\"rgba(255,200,0,0.3)\" stroke=\"orange\" stroke-width=\"2\"/>\n");
             fprintf(svg_file, "<circle cx=\"%.2f\" cy=\"%.2f\" r=\"5\" fill=\"red\"/>\n", x, y);
@@ -440,6 +425,13 @@ static void geraSVGVisibilidade(Poligono regiao_visibilidade, float x, float y,
     free(nome_arq);
 }
 
+// No modo aproximado, registra no TXT o limite do erro da região da bomba
+static void registraAproximacao(Qry_t *qry, ContextoVisibilidade ctx) {
+    if (qry->n_raios_vis > 0 && qry->txt_file) {
+        fprintf(qry->txt_file, "  Visibilidade aproximada com %d raios (erro máximo %.2f)\n",
+                qry->n_raios_vis, getErroVisibilidade(ctx));
+    }
+}
 
 static void executa_comando_destruicao(Qry_t *qry, char *linha) {
     strtok(linha, " ");
@@ -457,9 +449,9 @@ static void executa_comando_destruicao(Qry_t *qry, char *linha) {
     
     printf("  Comando DESTRUIÇÃO: x=%.2f, y=%.2f, sufixo=%s\n", x, y, sufixo);
     
-    Lista lista_formas = get_lista_cidade(qry->cidade);
-    ContextoVisibilidade ctx = criaContextoVisibilidade(x, y, lista_formas, 
-                                                   qry->tipo_sort, qry->threshold); 
+    Vetor formas = get_formas_cidade(qry->cidade);
+    ContextoVisibilidade ctx = obtemContextoCache(qry->cache_vis, x, y,
+                                                    get_versao_cidade(qry->cidade), formas); 
     if (!ctx) {
         printf("Erro ao criar contexto de visibilidade\n");
         return;
@@ -472,17 +464,13 @@ static void executa_comando_destruicao(Qry_t *qry, char *linha) {
         if (qry->txt_file) {
             fprintf(qry->txt_file, "\nBomba de destruição em (%.2f, %.2f):\n", x, y);
         }
+        registraAproximacao(qry, ctx);
         
-        destroiFormasEmColisao(lista_formas, regiao_visibilidade, qry);
+        destroiFormasEmColisao(ctx, regiao_visibilidade, qry);
         
         geraSVGVisibilidade(regiao_visibilidade, x, y, sufixo, qry);
-        
-        if (strcmp(sufixo, "-") != 0) {
-            liberaPoligono(regiao_visibilidade);
-        }
     }
     
-    liberaContextoVisibilidade(ctx);
 }
 
 static void executa_comando_pintura(Qry_t *qry, char *linha) {
@@ -503,9 +491,9 @@ static void executa_comando_pintura(Qry_t *qry, char *linha) {
     printf("  Comando PINTURA: x=%.2f, y=%.2f, cor=%s, sufixo=%s\n", x, y, cor, sufixo);
     
 
-    Lista lista_formas = get_lista_cidade(qry->cidade);
-    ContextoVisibilidade ctx = criaContextoVisibilidade(x, y, lista_formas, 
-                                                        qry->tipo_sort, qry->threshold);
+    Vetor formas = get_formas_cidade(qry->cidade);
+    ContextoVisibilidade ctx = obtemContextoCache(qry->cache_vis, x, y,
+                                                    get_versao_cidade(qry->cidade), formas);
     
     if (!ctx) {
         printf("Erro ao criar contexto de visibilidade\n");
@@ -517,82 +505,59 @@ static void executa_comando_pintura(Qry_t *qry, char *linha) {
         if (qry->txt_file) {
             fprintf(qry->txt_file, "\nBomba de pintura em (%.2f, %.2f) com cor %s:\n", x, y, cor);
         }
-        
-        BoundingBox bb_poly_orig = getBoundingBox(regiao_visibilidade);
-        
-        float margem = 1.0f;
-        BoundingBox bb_poly = criaBoundingBox(
-            getBBMinX(bb_poly_orig) - margem,
-            getBBMinY(bb_poly_orig) - margem,
-            getBBMaxX(bb_poly_orig) + margem,
-            getBBMaxY(bb_poly_orig) + margem
-        );
-        liberaBoundingBox(bb_poly_orig);
-        
-        int count = 0;
-        for (Celula c = getInicioLista(lista_formas); c; c = getProxCelula(c)) {
-            Forma f = getConteudoCelula(c);
-            BoundingBox bb_forma = getBBForma(f);
+        registraAproximacao(qry, ctx);
+        
+        Vetor atingidas = coletaFormasAtingidas(qry, ctx, regiao_visibilidade);
+        int count = getTamanhoVetor(atingidas);
+        for (int i = 0; i < count; i++) {
+            Forma f = getElementoVetor(atingidas, i);
+            tipo_forma tipo = getTipoForma(f);
+            void* data = getDataForma(f);
+            int id = -1;
+            char *tipo_str = "Desconhecido";
             
-            if (haInterseccaoBB(bb_poly, bb_forma)) {
-
-                if (formaIntersectaPoligono(regiao_visibilidade, f)) {
-                    tipo_forma tipo = getTipoForma(f);
-                    void* data = getDataForma(f);
-                    int id = -1;
-                    char *tipo_str = "Desconhecido";
-                    
-                   
-                    setCorPForma(f, cor);
-                    setCorBForma(f, cor);
-                    
-                    
-                    switch(tipo) {
-                        case CIRCLE:
-                            id = getIDCirculo(data);
-                            tipo_str = "Circulo";
-                            break;
-                        case RECTANGLE:
-                            id = getIDRetangulo(data);
-                            tipo_str = "Retangulo";
-                            break;
-                        case LINE:
-                            id = getIDLinha(data);
-                            tipo_str = "Linha";
-                            break;
-                        case TEXT:
-                            id = getIDTexto(data);
-                            tipo_str = "Texto";
-                            break;
-                        case ANTEPARO:
-                            id = getIDAnteparo(data);
-                            tipo_str = "Anteparo";
-                            break;
-                        default:
-                            break;
-                    }
-                    
-                    if (qry->txt_file && id != -1) {
-                        fprintf(qry->txt_file, "  Pintado: %s ID %d\n", tipo_str, id);
-                    }
-                    count++;
-                }
+           
+            setCorPForma(f, cor);
+            setCorBForma(f, cor);
+            
+            
+            switch(tipo) {
+                case CIRCLE:
+                    id = getIDCirculo(data);
+                    tipo_str = "Circulo";
+                    break;
+                case RECTANGLE:
+                    id = getIDRetangulo(data);
+                    tipo_str = "Retangulo";
+                    break;
+                case LINE:
+                    id = getIDLinha(data);
+                    tipo_str = "Linha";
+                    break;
+                case TEXT:
+                    id = getIDTexto(data);
+                    tipo_str = "Texto";
+                    break;
+                case ANTEPARO:
+                    id = getIDAnteparo(data);
+                    tipo_str = "Anteparo";
+                    break;
+                default:
+                    break;
+            }
+            
+            if (qry->txt_file && id != -1) {
+                fprintf(qry->txt_file, "  Pintado: %s ID %d\n", tipo_str, id);
             }
-            liberaBoundingBox(bb_forma);
         }
-        liberaBoundingBox(bb_poly);
+        liberaVetor(atingidas);
         
         if (qry->txt_file) {
             fprintf(qry->txt_file, "Total de formas pintadas: %d\n", count);
         }
         
         geraSVGVisibilidade(regiao_visibilidade, x, y, sufixo, qry);
-        
-        if (strcmp(sufixo, "-") != 0) {
-            liberaPoligono(regiao_visibilidade);
-        }
     }
-    liberaContextoVisibilidade(ctx);
 }
 
 static void executa_comando_clonagem(Qry_t *qry, char *linha) {
@@ -618,12 +583,10 @@ static void executa_comando_clonagem(Qry_t *qry, char *linha) {
            x, y, dx, dy, sufixo);
     
     // Criar contexto de visibilidade
-    Lista lista_formas = get_lista_cidade(qry->cidade);
-    Lista lista_svg = get_lista_svg_cidade(qry->cidade);
-    Lista lista_free = obtem_lista_para_desalocar(qry->cidade);
+    Vetor formas = get_formas_cidade(qry->cidade);
     
-    ContextoVisibilidade ctx = criaContextoVisibilidade(x, y, lista_formas, 
-                                                        qry->tipo_sort, qry->threshold);
+    ContextoVisibilidade ctx = obtemContextoCache(qry->cache_vis, x, y,
+                                                    get_versao_cidade(qry->cidade), formas);
     
     if (!ctx) {
         printf("Erro ao criar contexto de visibilidade\n");
@@ -639,86 +602,46 @@ static void executa_comando_clonagem(Qry_t *qry, char *linha) {
             fprintf(qry->txt_file, "\nBomba de clonagem em (%.2f, %.2f) com deslocamento (%.2f, %.2f):\n", 
                     x, y, dx, dy);
         }
+        registraAproximacao(qry, ctx);
         
-        BoundingBox bb_poly_orig = getBoundingBox(regiao_visibilidade);
+        Vetor atingidas = coletaFormasAtingidas(qry, ctx, regiao_visibilidade);
+        int n_atingidas = getTamanhoVetor(atingidas);
         
-        float margem = 1.0f;
-        BoundingBox bb_poly = criaBoundingBox(
-            getBBMinX(bb_poly_orig) - margem,
-            getBBMinY(bb_poly_orig) - margem,
-            getBBMaxX(bb_poly_orig) + margem,
-            getBBMaxY(bb_poly_orig) + margem
-        );
-        liberaBoundingBox(bb_poly_orig);
+        // Todos os clones num só bloco; a forma i recebe o ID primeiro_id + i
+        int primeiro_id = qry->maior_id_atual + 1;
+        Vetor clones = criaVetor(n_atingidas);
+        int count = clonaFormasEmLote(atingidas, primeiro_id, dx, dy, clones);
+        qry->maior_id_atual += n_atingidas;
         
-        Lista clones = criaLista();
-        int count = 0;
-        
-        for (Celula c = getInicioLista(lista_formas); c; c = getProxCelula(c)) {
-            Forma f = getConteudoCelula(c);
-            BoundingBox bb_forma = getBBForma(f);
+        int k = 0;
+        for (int i = 0; i < n_atingidas && k < count; i++) {
+            Forma f = getElementoVetor(atingidas, i);
+            int id_clone = primeiro_id + i;
             
-            // Teste rápido: Bounding Box
-            if (haInterseccaoBB(bb_poly, bb_forma)) {
-                // Teste preciso: verifica se a forma está dentro do polígono
-                if (formaIntersectaPoligono(regiao_visibilidade, f)) {
-                    tipo_forma tipo = getTipoForma(f);
-                    void* data = getDataForma(f);
-                    int id_original = -1;
-                    int id_clone = ++qry->maior_id_atual;
-                    char *tipo_str = "Desconhecido";
-
-                   
-                    Forma clone_forma = clonaForma(f, id_clone, dx, dy);
-                    
-                    if (clone_forma != NULL) {
-                        // Obtém ID original e nome do tipo
-                        switch(tipo) {
-                            case CIRCLE:
-                                id_original = getIDCirculo(data);
-                                tipo_str = "Circulo";
-                                break;
-                            case RECTANGLE:
-                                id_original = getIDRetangulo(data);
-                                tipo_str = "Retangulo";
-                                break;
-                            case LINE:
-                                id_original = getIDLinha(data);
-                                tipo_str = "Linha";
-                                break;
-                            case TEXT:
-                                id_original = getIDTexto(data);
-                                tipo_str = "Texto";
-                                break;
-                            case ANTEPARO:
-                                id_original = getIDAnteparo(data);
-                                tipo_str = "Anteparo";
-                                break;
-                            default:
-                                break;
-                        }
-                        
-                        insereFinalLista(clones, clone_forma);
-                        
-                        if (qry->txt_file && id_original != -1) {
-                            fprintf(qry->txt_file, "  Clonado: %s ID %d -> Clone ID %d\n", 
-                                    tipo_str, id_original, id_clone);
-                        }
-                        count++;
-                    }
-                }
+            // Formas sem clone (estilos de texto) não aparecem em clones
+            if (getIDForma(getElementoVetor(clones, k)) != id_clone) continue;
+            k++;
+            
+            char *tipo_str = "Desconhecido";
+            switch(getTipoForma(f)) {
+                case CIRCLE: tipo_str = "Circulo"; break;
+                case RECTANGLE: tipo_str = "Retangulo"; break;
+                case LINE: tipo_str = "Linha"; break;
+                case TEXT: tipo_str = "Texto"; break;
+                case ANTEPARO: tipo_str = "Anteparo"; break;
+                default: break;
+            }
+            
+            if (qry->txt_file) {
+                fprintf(qry->txt_file, "  Clonado: %s ID %d -> Clone ID %d\n", 
+                        tipo_str, getIDForma(f), id_clone);
             }
-            liberaBoundingBox(bb_forma);
         }
-        liberaBoundingBox(bb_poly);
+        liberaVetor(atingidas);
         
-        while (!listaVazia(clones)) {
-            Forma clone = removeInicioLista(clones);
-            insereFinalLista(lista_formas, clone);
-            insereFinalLista(lista_svg, clone);
-            insereFinalLista(lista_free, clone);
-        }
-        liberaLista(clones);
+        // Os clones entram na cidade de uma vez, depois da varredura
+        substitui_formas_cidade(qry->cidade, NULL, clones);
+        liberaVetor(clones);
         
         if (qry->txt_file) {
             fprintf(qry->txt_file, "Total de formas clonadas: %d\n", count);
@@ -726,14 +649,8 @@ static void executa_comando_clonagem(Qry_t *qry, char *linha) {
         
         //Gerar SVG da região de visibilidade
         geraSVGVisibilidade(regiao_visibilidade, x, y, sufixo, qry);
-        
-        // Só libera o polígono se não foi armazenado para renderização posterior
-        if (strcmp(sufixo, "-") != 0) {
-            liberaPoligono(regiao_visibilidade);
-        }
     }
     
-    liberaContextoVisibilidade(ctx);
 }
 
 static void cria_svg_qry(Qry_t *qry, DadosDoArquivo fileData) {
@@ -779,14 +696,13 @@ static void cria_svg_qry(Qry_t *qry, DadosDoArquivo fileData) {
     }
     
     // Calcula o bounding box de todas as formas para definir o viewBox
-    Lista lista_formas = get_lista_cidade(qry->cidade);
+    Vetor formas = get_formas_cidade(qry->cidade);
     float min_x = INFINITY, min_y = INFINITY;
     float max_x = -INFINITY, max_y = -INFINITY;
     bool has_shapes = false;
     
-    Celula aux = getInicioLista(lista_formas);
-    while (aux != NULL) {
-        Forma f = getConteudoCelula(aux);
+    for (int i = 0; i < getTamanhoVetor(formas); i++) {
+        Forma f = getElementoVetor(formas, i);
         BoundingBox bb = getBBForma(f);
         if (bb != NULL) {
             has_shapes = true;
@@ -802,7 +718,6 @@ static void cria_svg_qry(Qry_t *qry, DadosDoArquivo fileData) {
             
             liberaBoundingBox(bb);
         }
-        aux = getProxCelula(aux);
     }
     
     // Também considera os polígonos de visibilidade
@@ -853,20 +768,9 @@ static void cria_svg_qry(Qry_t *qry, DadosDoArquivo fileData) {
             vb_x, vb_y, vb_w, vb_h);
     
    
-    Lista lista_svg_temp = criaLista();
-    
-   
-    // Reutiliza lista_formas e aux já declarados anteriormente
-    aux = getInicioLista(lista_formas);
-    while (aux != NULL) {
-        Forma f = getConteudoCelula(aux);
-        insereFinalLista(lista_svg_temp, f);
-        aux = getProxCelula(aux);
-    }
-    
-    
-    while (!listaVazia(lista_svg_temp)) {
-        Forma forma = removeFinalLista(lista_svg_temp);
+    // Formas em ordem inversa de inserção
+    for (int i = getTamanhoVetor(formas) - 1; i >= 0; i--) {
+        Forma forma = getElementoVetor(formas, i);
         if (forma != NULL) {
             escreveFormaSVG(forma, file);
         }
@@ -887,10 +791,10 @@ static void cria_svg_qry(Qry_t *qry, DadosDoArquivo fileData) {
             fprintf(file, "<g id=\"visibility-region\" opacity=\"0.5\">\n");
             fprintf(file, "  <polygon points=\"");
             
-            Lista vertices = getVertices(vis_data->poligono);
-            for (Celula v = getInicioLista(vertices); v; v = getProxCelula(v)) {
-                Ponto p = (Ponto)getConteudoCelula(v);
-                fprintf(file, "%.2f,%.2f ", getPontoX(p), getPontoY(p));
+            int n_vertices = getNumVertices(vis_data->poligono);
+            for (int v = 0; v < n_vertices; v++) {
+                fprintf(file, "%.2f,%.2f ", getXVertice(vis_data->poligono, v),
+                        getYVertice(vis_data->poligono, v));
             }
             
             fprintf(file, "\" fill=\"rgba(255,200,0,0.3)\" stroke=\"orange\" stroke-width=\"2\"/>\n");
@@ -903,7 +807,6 @@ static void cria_svg_qry(Qry_t *qry, DadosDoArquivo fileData) {
     fprintf(file, "</svg>\n");
     fclose(file);
     
-    liberaLista(lista_svg_temp);
     free(caminho_output_arquivo);
 }
 
@@ -939,6 +842,16 @@ void desaloca_qry(Qry qry) {
         liberaLista(qry_t->visibility_polygons);
     }
     
+    if (qry_t->cache_vis != NULL) {
+        int acertos = getAcertosCache(qry_t->cache_vis);
+        int atualizacoes = getAtualizacoesCache(qry_t->cache_vis);
+        int consultas = acertos + atualizacoes + getFalhasCache(qry_t->cache_vis);
+        printf("Cache de visibilidade: %d acertos e %d atualizações em %d consultas (%.1f%%)\n",
+               acertos, atualizacoes, consultas,
+               consultas ? 100.0 * (acertos + atualizacoes) / consultas : 0.0);
+        liberaCacheVisibilidade(qry_t->cache_vis);
+    }
+    
     if (qry_t->caminho_output != NULL) {
         free(qry_t->caminho_output);
     }
@@ -35,10 +35,13 @@ typedef void* Qry;
  * @param cidade Contexto da cidade com as formas geométricas.
  * @param caminho_output Caminho para o diretório de saída.
  * @param maior_id_inicial Maior ID usado no arquivo .geo (para gerar IDs únicos).
+ * @param n_raios_vis Se > 0, as regiões de visibilidade das bombas são
+ *                    aproximadas com esse número de raios (opção -vis approx:N).
  * @return Ponteiro opaco para o contexto Qry.
  */
 Qry executa_comando_qry(DadosDoArquivo fileData, Cidade cidade, 
-                        char *caminho_output, int maior_id_inicial, char tipo_sort, int threshold);
+                        char *caminho_output, int maior_id_inicial, char tipo_sort, int threshold,
+                        int n_raios_vis);
 
 /**
  * @brief Libera toda a memória alocada para o contexto `Qry`.
@@ -0,0 +1,154 @@
+#include "vetor.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Capacidade quando nenhuma é pedida
+#define VETOR_CAPACIDADE_PADRAO 8
+
+typedef struct {
+    void** dados;
+    int n;
+    int capacidade;
+} stVetor;
+
+Vetor criaVetor(int capacidade) {
+    stVetor* v = malloc(sizeof(stVetor));
+    if (v == NULL) {
+        printf("Erro de alocação para vetor\n");
+        exit(1);
+    }
+    v->dados = NULL;
+    v->n = 0;
+    v->capacidade = 0;
+    reservaVetor(v, capacidade > 0 ? capacidade : VETOR_CAPACIDADE_PADRAO);
+    return v;
+}
+
+void liberaVetor(Vetor V) {
+    if (!V) return;
+
+    stVetor* v = (stVetor*)V;
+    free(v->dados);
+    free(v);
+}
+
+void limpaVetor(Vetor V) {
+    if (!V) return;
+    ((stVetor*)V)->n = 0;
+}
+
+void reservaVetor(Vetor V, int capacidade) {
+    if (!V) return;
+    stVetor* v = (stVetor*)V;
+    if (capacidade <= v->capacidade) return;
+
+    void** dados = realloc(v->dados, capacidade * sizeof(void*));
+    if (dados == NULL) {
+        printf("Erro de alocação para vetor\n");
+        exit(1);
+    }
+    v->dados = dados;
+    v->capacidade = capacidade;
+}
+
+void insereFinalVetor(Vetor V, void* elemento) {
+    if (!V) return;
+    stVetor* v = (stVetor*)V;
+
+    if (v->n == v->capacidade) reservaVetor(v, 2 * v->capacidade);
+    v->dados[v->n++] = elemento;
+}
+
+void anexaVetor(Vetor destino, Vetor origem) {
+    if (!destino || !origem) return;
+    stVetor* d = (stVetor*)destino;
+    stVetor* o = (stVetor*)origem;
+    if (o->n == 0) return;
+
+    int necessario = d->n + o->n;
+    if (necessario > d->capacidade) {
+        int nova = d->capacidade;
+        while (nova < necessario) nova *= 2;
+        reservaVetor(d, nova);
+    }
+    memcpy(d->dados + d->n, o->dados, o->n * sizeof(void*));
+    d->n = necessario;
+}
+
+void* removeFinalVetor(Vetor V) {
+    if (!V) return NULL;
+    stVetor* v = (stVetor*)V;
+
+    if (v->n == 0) return NULL;
+    return v->dados[--v->n];
+}
+
+void truncaVetor(Vetor V, int tamanho) {
+    if (!V) return;
+    stVetor* v = (stVetor*)V;
+    if (tamanho >= 0 && tamanho < v->n) v->n = tamanho;
+}
+
+void* removeVetor(Vetor V, int i) {
+    if (!V) return NULL;
+    stVetor* v = (stVetor*)V;
+    if (i < 0 || i >= v->n) return NULL;
+
+    void* elemento = v->dados[i];
+    memmove(v->dados + i, v->dados + i + 1, (v->n - i - 1) * sizeof(void*));
+    v->n--;
+    return elemento;
+}
+
+void* removeTrocaVetor(Vetor V, int i) {
+    if (!V) return NULL;
+    stVetor* v = (stVetor*)V;
+    if (i < 0 || i >= v->n) return NULL;
+
+    void* elemento = v->dados[i];
+    v->dados[i] = v->dados[--v->n];
+    return elemento;
+}
+
+bool removeElementoVetor(Vetor V, void* elemento) {
+    if (!V) return false;
+    stVetor* v = (stVetor*)V;
+
+    for (int i = 0; i < v->n; i++) {
+        if (v->dados[i] == elemento) {
+            removeVetor(v, i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void* getElementoVetor(Vetor V, int i) {
+    if (!V) return NULL;
+    stVetor* v = (stVetor*)V;
+    if (i < 0 || i >= v->n) return NULL;
+    return v->dados[i];
+}
+
+void setElementoVetor(Vetor V, int i, void* elemento) {
+    if (!V) return;
+    stVetor* v = (stVetor*)V;
+    if (i < 0 || i >= v->n) return;
+    v->dados[i] = elemento;
+}
+
+void** getDadosVetor(Vetor V) {
+    if (!V) return NULL;
+    return ((stVetor*)V)->dados;
+}
+
+int getTamanhoVetor(Vetor V) {
+    if (!V) return 0;
+    return ((stVetor*)V)->n;
+}
+
+bool vetorVazio(Vetor V) {
+    return getTamanhoVetor(V) == 0;
+}
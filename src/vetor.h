@@ -0,0 +1,170 @@
+#ifndef VETOR_H
+#define VETOR_H
+
+#include <stdbool.h>
+
+/**
+ * @file vetor.h
+ * @brief Vetor dinâmico de ponteiros, armazenado de forma contígua.
+ *
+ * Alternativa à Lista para sequências que são muito percorridas: os
+ * elementos ficam lado a lado na memória, então percorrer o vetor não
+ * segue um ponteiro por elemento. Inserir no final custa O(1) amortizado
+ * (a capacidade dobra quando enche).
+ *
+ * O vetor guarda apenas os ponteiros; quem aloca os elementos é responsável
+ * por liberá-los.
+ */
+
+/**
+ * @brief Tipo opaco para o vetor dinâmico.
+ */
+typedef void* Vetor;
+
+/* ================= Criação e liberação ================= */
+
+/**
+ * @brief Cria um vetor vazio.
+ *
+ * @param capacidade Número de elementos para os quais já reservar espaço
+ *                   (0 para o padrão).
+ * @return O vetor criado.
+ */
+Vetor criaVetor(int capacidade);
+
+/**
+ * @brief Libera o vetor (os elementos não são liberados).
+ *
+ * @param v Vetor a ser liberado.
+ */
+void liberaVetor(Vetor v);
+
+/**
+ * @brief Esvazia o vetor, mantendo a capacidade.
+ *
+ * @param v Vetor.
+ */
+void limpaVetor(Vetor v);
+
+/* ================= Inserção ================= */
+
+/**
+ * @brief Garante espaço para ao menos `capacidade` elementos sem realocar.
+ *
+ * @param v Vetor.
+ * @param capacidade Capacidade mínima desejada.
+ */
+void reservaVetor(Vetor v, int capacidade);
+
+/**
+ * @brief Insere um elemento no final do vetor. O(1) amortizado.
+ *
+ * @param v Vetor.
+ * @param elemento Ponteiro a ser armazenado.
+ */
+void insereFinalVetor(Vetor v, void* elemento);
+
+/**
+ * @brief Insere no final de `destino` todos os elementos de `origem`, na
+ *        mesma ordem, com uma única realocação.
+ *
+ * @param destino Vetor que recebe os elementos.
+ * @param origem Vetor de onde os elementos são copiados (não é alterado).
+ */
+void anexaVetor(Vetor destino, Vetor origem);
+
+/* ================= Remoção ================= */
+
+/**
+ * @brief Remove e retorna o último elemento. O(1).
+ *
+ * @param v Vetor.
+ * @return O elemento removido, ou NULL se o vetor estiver vazio.
+ */
+void* removeFinalVetor(Vetor v);
+
+/**
+ * @brief Descarta os elementos a partir da posição `tamanho`. O(1).
+ *
+ * Útil depois de compactar o vetor por getDadosVetor().
+ *
+ * @param v Vetor.
+ * @param tamanho Novo tamanho (se for maior ou igual ao atual, nada muda).
+ */
+void truncaVetor(Vetor v, int tamanho);
+
+/**
+ * @brief Remove o elemento da posição i, preservando a ordem dos demais. O(n).
+ *
+ * @param v Vetor.
+ * @param i Posição do elemento.
+ * @return O elemento removido, ou NULL se a posição for inválida.
+ */
+void* removeVetor(Vetor v, int i);
+
+/**
+ * @brief Remove o elemento da posição i colocando o último em seu lugar. O(1).
+ *
+ * A ordem dos elementos não é preservada.
+ *
+ * @param v Vetor.
+ * @param i Posição do elemento.
+ * @return O elemento removido, ou NULL se a posição for inválida.
+ */
+void* removeTrocaVetor(Vetor v, int i);
+
+/**
+ * @brief Remove a primeira ocorrência do elemento, preservando a ordem. O(n).
+ *
+ * @param v Vetor.
+ * @param elemento Ponteiro procurado.
+ * @return true se o elemento foi encontrado e removido.
+ */
+bool removeElementoVetor(Vetor v, void* elemento);
+
+/* ================= Acesso ================= */
+
+/**
+ * @brief Retorna o elemento da posição i.
+ *
+ * @param v Vetor.
+ * @param i Posição (0 a getTamanhoVetor(v) - 1).
+ * @return O elemento, ou NULL se a posição for inválida.
+ */
+void* getElementoVetor(Vetor v, int i);
+
+/**
+ * @brief Substitui o elemento da posição i.
+ *
+ * @param v Vetor.
+ * @param i Posição (0 a getTamanhoVetor(v) - 1).
+ * @param elemento Novo elemento.
+ */
+void setElementoVetor(Vetor v, int i, void* elemento);
+
+/**
+ * @brief Acesso direto ao buffer de elementos, para laços apertados.
+ *
+ * @param v Vetor.
+ * @return Ponteiro para o primeiro elemento. Fica inválido depois de
+ *         qualquer inserção no vetor.
+ */
+void** getDadosVetor(Vetor v);
+
+/**
+ * @brief Retorna o número de elementos.
+ *
+ * @param v Vetor.
+ * @return Número de elementos (0 se v for NULL).
+ */
+int getTamanhoVetor(Vetor v);
+
+/**
+ * @brief Verifica se o vetor está vazio.
+ *
+ * @param v Vetor.
+ * @return true se não há elementos.
+ */
+bool vetorVazio(Vetor v);
+
+#endif
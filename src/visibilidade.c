@@ -1,14 +1,22 @@
 #include "visibilidade.h"
-#include "lista.h"
+#include "vetor.h"
 #include "arvore_binaria.h"
 #include "forma.h"
 #include "anteparo.h"
+#include "circulo.h"
+#include "retangulo.h"
+#include "linha.h"
+#include "texto.h"
 #include "sort.h"
+#include "sort_tipado.h"
+#include "intersecao_segmentos.h"
+#include "grade_segmentos.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <stdint.h>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -16,6 +24,21 @@
 
 #define EPSILON 1e-9
 
+// Recuo de ângulo tolerado entre vértices consecutivos de V(x) (arestas radiais em float)
+#define TOLERANCIA_ANGULAR 1e-5f
+
+// Folga angular depois do setor alterado antes de reaproveitar a varredura anterior
+#define MARGEM_CONVERGENCIA 1e-3f
+
+// Rotação do raio usada para desempatar segmentos que se encontram no raio atual
+#define ROTACAO_DESEMPATE 1e-3
+
+// Abaixo disso não compensa procurar um raio de corte para os anteparos
+#define CORTE_MIN_ANTEPAROS 64
+
+// Marcador especial para segmentos do retângulo envolvente
+#define MARCADOR_RETANGULO ((Anteparo)0x1)
+
 
 
 typedef struct {
@@ -25,7 +48,11 @@ typedef struct {
 
 typedef struct {
     Ponto2D pto_ini, pto_fim;
+    Ponto2D orig_ini, orig_fim;  // Extremidades do anteparo inteiro (o segmento pode ser um pedaço dele)
     Anteparo source;
+    bool removido;  // Retirado por atualizaContextoVisibilidade; não tem mais vértices
+    NoArvore no;    // Nó no status da varredura (NULL se não está ativo)
+    bool cobertura; // O anteparo faz parte da cobertura que justifica raio_corte
 } SegmentoInterno;
 
 typedef enum { INICIO, FIM } TipoVertice;
@@ -36,17 +63,37 @@ typedef struct {
     SegmentoInterno* pSeg;
     Ponto2D ponto;
     CodigoVertice codigo;
+    float ang;   // Ângulo em relação ao observador (chave de ordenação)
+    float dist;  // Distância ao observador (desempate)
 } Vertice;
 
+// Vértices de V(x) em ordem angular crescente, para classificar pontos em O(log n)
+typedef struct {
+    int estado;    // 0 = não construído, 1 = pronto, -1 = V(x) não é monótono: usa crossing number
+    int n;
+    float* ang;    // Ângulo de cada vértice em relação ao observador, crescente
+    Ponto2D* pts;  // Vértices na mesma ordem de 'ang'
+} IndiceAngular;
+
 typedef struct {
     Ponto2D x;  // Ponto observador
     SegmentoInterno* segmentos;
     int n_segmentos;
     Vertice* vertices;
     int n_vertices;
-    ArvoreBinaria SegsAtvs;
+    ArvoreBinaria SegsAtvs;  // Segmentos ativos, do mais próximo ao mais distante no raio atual
+    Ponto2D raio;            // Vértice em processamento: define o raio que ordena SegsAtvs
     Ponto2D biombo;
-    Lista regiao_visibilidade;
+    Poligono regiao;  // Vértices de V(x) emitidos direto pela varredura
+    IndiceAngular indice;  // Construído na primeira consulta a pontoVisivel
+    int cap_segmentos;
+    int* emitidos;         // Vértices de V(x) já emitidos após cada vértice da varredura
+    Ponto2D* biombo_apos;  // Biombo após cada vértice da varredura
+    bool fechado;          // O último vértice de V(x) é o de fechamento
+    float env_min_x, env_min_y, env_max_x, env_max_y;  // Retângulo envolvente
+    float raio_corte;      // Anteparos inteiros além disso não entram (INFINITY: todos entram)
+    int n_raios;           // > 0: V(x) aproximado por esse número de raios, sem varredura
+    float erro;            // Limite do erro da aproximação (0 se exato)
     char tipo_sort;
     int threshold;
 } CtxVis;
@@ -72,6 +119,10 @@ static float normalizar_angulo(float ang) {
 
 
 static Ponto2D interseccao(Ponto2D x, Ponto2D v, SegmentoInterno* s) {
+    // Raio pela extremidade: o cálculo abaixo pode errar o segmento por arredondamento
+    if (s->pto_ini.x == v.x && s->pto_ini.y == v.y) return s->pto_ini;
+    if (s->pto_fim.x == v.x && s->pto_fim.y == v.y) return s->pto_fim;
+    
     float dx = v.x - x.x;
     float dy = v.y - x.y;
     
@@ -100,67 +151,156 @@ static Ponto2D interseccao(Ponto2D x, Ponto2D v, SegmentoInterno* s) {
 
 
 
-// Contexto global temporário para ordenação (necessário porque qsort não aceita contexto)
-static Ponto2D g_origem_ordenacao;
-
-static int cmpVertices(const void* a, const void* b) {
-    const Vertice* va = *(Vertice**)a;
-    const Vertice* vb = *(Vertice**)b;
-    
-    //Ângulo
-    float ang_a = angulo(g_origem_ordenacao, va->ponto);
-    float ang_b = angulo(g_origem_ordenacao, vb->ponto);
-    if (ang_a < ang_b - EPSILON) return -1;
-    if (ang_a > ang_b + EPSILON) return 1;
+// Ordem da varredura: ângulo crescente, depois distância decrescente, depois INICIO antes de FIM
+static inline int cmpVertices(const Vertice* va, const Vertice* vb) {
+    if (va->ang < vb->ang - EPSILON) return -1;
+    if (va->ang > vb->ang + EPSILON) return 1;
     
-    //Distância (maior primeiro = mais próximo)
-    float dist_a = distancia(g_origem_ordenacao, va->ponto);
-    float dist_b = distancia(g_origem_ordenacao, vb->ponto);
-    if (dist_a > dist_b + EPSILON) return -1;
-    if (dist_a < dist_b - EPSILON) return 1;
+    if (va->dist > vb->dist + EPSILON) return -1;
+    if (va->dist < vb->dist - EPSILON) return 1;
     
-    //Tipo (INICIO antes de FIM)
     if (va->tipo == INICIO && vb->tipo == FIM) return -1;
     if (va->tipo == FIM && vb->tipo == INICIO) return 1;
     
     return 0;
 }
 
-static int cmpSegmentos(const void* a, const void* b, void* ctx) {
-    (void)ctx;
+#define VERTICE_MENOR(a, b) (cmpVertices((a), (b)) < 0)
+
+// Versão por ponteiro genérico, para as rotinas de sort.h
+static int cmpVerticesGenerico(const void* a, const void* b) {
+    return cmpVertices((const Vertice*)a, (const Vertice*)b);
+}
+SORT_TIPADO(vertices, Vertice, VERTICE_MENOR)
+
+// Bits de um float mapeados para uma ordem de inteiro sem sinal igual à numérica
+static inline uint32_t floatOrdenavel(float f) {
+    f += 0.0f;  // -0 vira +0, para os dois zeros terem a mesma chave
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+}
+
+// Chave de 64 bits com a mesma ordem de cmpVertices:
+// 32 bits de ângulo crescente | 31 bits de distância invertida | 1 bit de tipo (INICIO = 0)
+static inline uint64_t chaveVertice(const Vertice* v) {
+    uint32_t dist;
+    float d = v->dist + 0.0f;
+    memcpy(&dist, &d, sizeof(dist));
+    dist = 0x7FFFFFFFu - (dist & 0x7FFFFFFFu);  // distância >= 0: basta inverter para decrescer
+
+    return ((uint64_t)floatOrdenavel(v->ang) << 32) |
+           ((uint64_t)dist << 1) |
+           (uint64_t)(v->tipo == FIM);
+}
+
+// Ordena os vértices por radix sort das chaves e aplica a permutação nos registros.
+// Retorna o novo array (o antigo é liberado), ou o mesmo se faltar memória.
+static Vertice* ordenaVerticesRadix(Vertice* vertices, int n, size_t limiar) {
+    if ((size_t)n <= limiar) {
+        vertices_insercao(vertices, 0, n);
+        return vertices;
+    }
+
+    ChaveRadix* chaves = malloc(n * sizeof(ChaveRadix));
+    Vertice* ordenados = malloc(n * sizeof(Vertice));
+    if (!chaves || !ordenados) {
+        free(chaves);
+        free(ordenados);
+        vertices_merge_sort(vertices, n, limiar);
+        return vertices;
+    }
+
+    for (int i = 0; i < n; i++) {
+        chaves[i].chave = chaveVertice(&vertices[i]);
+        chaves[i].indice = i;
+    }
+    radix_sort_chaves(chaves, n);
+
+    for (int i = 0; i < n; i++) {
+        ordenados[i] = vertices[chaves[i].indice];
+    }
+
+    free(chaves);
+    free(vertices);
+    return ordenados;
+}
+
+// Distância do observador até a reta do segmento, ao longo do raio que passa por p.
+// Segmento radial (paralelo ao raio): distância da extremidade mais próxima
+static double distanciaNoRaio(Ponto2D x, Ponto2D p, const SegmentoInterno* s) {
+    if (s->pto_ini.x == p.x && s->pto_ini.y == p.y) return distancia(x, s->pto_ini);
+    if (s->pto_fim.x == p.x && s->pto_fim.y == p.y) return distancia(x, s->pto_fim);
+    
+    double dx = (double)p.x - x.x;
+    double dy = (double)p.y - x.y;
+    double norma = sqrt(dx*dx + dy*dy);
+    
+    double x1 = (double)s->pto_ini.x - x.x;
+    double y1 = (double)s->pto_ini.y - x.y;
+    double seg_dx = (double)s->pto_fim.x - s->pto_ini.x;
+    double seg_dy = (double)s->pto_fim.y - s->pto_ini.y;
+    double comp = sqrt(seg_dx*seg_dx + seg_dy*seg_dy);
+    double det = (norma == 0.0) ? 0.0 : (seg_dx * dy - seg_dy * dx) / norma;
+    if (fabs(det) <= EPSILON * comp) {
+        return fmin(distancia(x, s->pto_ini), distancia(x, s->pto_fim));
+    }
+    return (seg_dx * y1 - seg_dy * x1) / det;
+}
+
+// Ordem dos segmentos ativos: distância ao observador no raio atual. Como os anteparos
+// cruzados foram divididos, essa ordem é a mesma em todos os raios em que ambos estão ativos
+static int cmpSegmentos(const void* a, const void* b, void* contexto) {
+    if (a == b) return 0;
+    const CtxVis* ctx = contexto;
     const SegmentoInterno* sa = a;
     const SegmentoInterno* sb = b;
     
+    double da = distanciaNoRaio(ctx->x, ctx->raio, sa);
+    double db = distanciaNoRaio(ctx->x, ctx->raio, sb);
+    double tol = 1e-5 * fmax(1.0, fmax(da, db));
+    if (da < db - tol) return -1;
+    if (da > db + tol) return 1;
+    
+    // Encontram-se no raio atual (extremidade comum): decide um pouco adiante na varredura
+    double dx = (double)ctx->raio.x - ctx->x.x;
+    double dy = (double)ctx->raio.y - ctx->x.y;
+    double c = cos(ROTACAO_DESEMPATE), s = sin(ROTACAO_DESEMPATE);
+    Ponto2D adiante = {ctx->x.x + dx * c - dy * s, ctx->x.y + dx * s + dy * c};
+    da = distanciaNoRaio(ctx->x, adiante, sa);
+    db = distanciaNoRaio(ctx->x, adiante, sb);
+    if (da < db) return -1;
+    if (da > db) return 1;
     
     return (sa < sb) ? -1 : 1;
 }
 
 // ALGORITMO PRINCIPAL
 
+// O primeiro segmento do status é o mais próximo; os seguintes só são consultados
+// se ele não cruza o raio por erro de arredondamento
 static SegmentoInterno* segAtivoMaisProx(CtxVis* ctx, Ponto2D v) {
-    if (arvoreVazia(ctx->SegsAtvs)) return NULL;
-    
-    int tamanho;
-    void** segs = arvoreParaArray(ctx->SegsAtvs, &tamanho);
-    
-    SegmentoInterno* mais_proximo = NULL;
-    float menor_dist = INFINITY;
-    
-    for (int i = 0; i < tamanho; i++) {
-        SegmentoInterno* s = (SegmentoInterno*)segs[i];
-        Ponto2D inter = interseccao(ctx->x, v, s);
-        
-        if (inter.x != INFINITY) {
-            float d = distancia(ctx->x, inter);
-            if (d < menor_dist) {
-                menor_dist = d;
-                mais_proximo = s;
-            }
-        }
+    for (NoArvore no = getMenorNo(ctx->SegsAtvs); no; no = getProximoNo(no)) {
+        SegmentoInterno* s = getDadoNo(no);
+        if (interseccao(ctx->x, v, s).x != INFINITY) return s;
     }
-    
-    free(segs);
-    return mais_proximo;
+    return NULL;
+}
+
+static void insereSegmentoAtivo(CtxVis* ctx, SegmentoInterno* s) {
+    s->no = insereArvoreBinaria(ctx->SegsAtvs, s);
+}
+
+static void removeSegmentoAtivo(CtxVis* ctx, SegmentoInterno* s) {
+    // Segmento que cruza o ângulo -pi tem o FIM antes do INICIO: ainda não está no status
+    if (s->no == NULL) return;
+    removeNoArvore(ctx->SegsAtvs, s->no);
+    s->no = NULL;
+}
+
+// Cada aresta de V(x) é registrada pelo seu ponto inicial; a final é o início da seguinte
+static void emiteVertice(CtxVis* ctx, Ponto2D p) {
+    insereVerticeXY(ctx->regiao, p.x, p.y);
 }
 
 static bool encoberto(CtxVis* ctx, Vertice* v) {
@@ -176,24 +316,17 @@ static bool encoberto(CtxVis* ctx, Vertice* v) {
     return dist_inter < dist_v - EPSILON;
 }
 
-ContextoVisibilidade criaContextoVisibilidade(float x, float y, Lista formas,
-                                              char tipo_sort, int threshold) {
-    if (!formas) return NULL;
-    
-    CtxVis* ctx = malloc(sizeof(CtxVis));
-    ctx->x.x = x;
-    ctx->x.y = y;
-    ctx->tipo_sort = tipo_sort;
-    ctx->threshold = threshold;
-    ctx->regiao_visibilidade = criaLista();
-    ctx->SegsAtvs = criaArvoreBinaria(cmpSegmentos, NULL);
+// Retângulo que envolve o observador e TODAS as formas, com margem.
+// Isso garante que a região de visibilidade sempre cubra todas as formas potencialmente visíveis
+static void calculaEnvolvente(float x, float y, Vetor formas,
+                              float* min_x, float* min_y, float* max_x, float* max_y) {
+    *min_x = x;
+    *max_x = x;
+    *min_y = y;
+    *max_y = y;
     
-    // Cria retângulo envolvente considerando TODAS as formas
-    // Isso garante que a região de visibilidade sempre cubra todas as formas potencialmente visíveis
-    float min_x = x, max_x = x, min_y = y, max_y = y;
-    
-    for (Celula c = getInicioLista(formas); c; c = getProxCelula(c)) {
-        Forma f = getConteudoCelula(c);
+    for (int q = 0; q < getTamanhoVetor(formas); q++) {
+        Forma f = getElementoVetor(formas, q);
         BoundingBox bb = getBBForma(f);
         if (bb) {
             float bb_min_x = getBBMinX(bb);
@@ -201,264 +334,1313 @@ ContextoVisibilidade criaContextoVisibilidade(float x, float y, Lista formas,
             float bb_max_x = getBBMaxX(bb);
             float bb_max_y = getBBMaxY(bb);
             
-            if (bb_min_x < min_x) min_x = bb_min_x;
-            if (bb_max_x > max_x) max_x = bb_max_x;
-            if (bb_min_y < min_y) min_y = bb_min_y;
-            if (bb_max_y > max_y) max_y = bb_max_y;
+            if (bb_min_x < *min_x) *min_x = bb_min_x;
+            if (bb_max_x > *max_x) *max_x = bb_max_x;
+            if (bb_min_y < *min_y) *min_y = bb_min_y;
+            if (bb_max_y > *max_y) *max_y = bb_max_y;
             
             liberaBoundingBox(bb);
         }
     }
     
     float margem = 50.0f;
-    min_x -= margem;
-    max_x += margem;
-    min_y -= margem;
-    max_y += margem;
+    *min_x -= margem;
+    *max_x += margem;
+    *min_y -= margem;
+    *max_y += margem;
+}
+
+// Orienta o segmento: menor ângulo = INICIO, maior ângulo = FIM
+static void orientaSegmento(Ponto2D x, SegmentoInterno* s) {
+    float ang1 = normalizar_angulo(angulo(x, s->pto_ini));
+    float ang2 = normalizar_angulo(angulo(x, s->pto_fim));
     
-    // Conta anteparos
-    int n_ant = 0;
-    for (Celula c = getInicioLista(formas); c; c = getProxCelula(c)) {
-        if (getTipoForma(getConteudoCelula(c)) == ANTEPARO) n_ant++;
+    // Se ang1 > ang2, troca para que pto_ini tenha o menor ângulo
+    // Também trata o caso de wrap-around (quando |ang1 - ang2| > PI)
+    bool deve_trocar = false;
+    
+    if (fabs(ang1 - ang2) > M_PI) {
+        // Cruzando o ângulo zero: o maior ângulo é na verdade o "início"
+        // Então se ang1 < ang2, ang1 está perto de 0, ang2 perto de 2PI
+        // Neste caso, ang2 é o início real
+        deve_trocar = (ang1 < ang2);
+    } else {
+        // Caso normal: menor ângulo é início
+        deve_trocar = (ang1 > ang2);
     }
     
-    ctx->n_segmentos = n_ant + 4;
-    ctx->segmentos = malloc(ctx->n_segmentos * sizeof(SegmentoInterno));
+    if (deve_trocar) {
+        Ponto2D temp = s->pto_ini;
+        s->pto_ini = s->pto_fim;
+        s->pto_fim = temp;
+    }
+}
+
+// Vértices INICIO e FIM de um segmento, com as chaves de ordenação calculadas uma vez
+static void criaVerticesSegmento(CtxVis* ctx, SegmentoInterno* s, Vertice* vi, Vertice* vf) {
+    CodigoVertice cod = (s->source == NULL) ? RE : ORIG;
     
-    // Marcador especial para segmentos do retângulo envolvente
-    Anteparo MARCADOR_RETANGULO = (Anteparo)0x1;
-    
-    // Adiciona retângulo envolvente
-    int idx = 0;
-    ctx->segmentos[idx].pto_ini = (Ponto2D){min_x, min_y};
-    ctx->segmentos[idx].pto_fim = (Ponto2D){max_x, min_y};
-    ctx->segmentos[idx].source = MARCADOR_RETANGULO;
-    idx++;
-    
-    ctx->segmentos[idx].pto_ini = (Ponto2D){max_x, min_y};
-    ctx->segmentos[idx].pto_fim = (Ponto2D){max_x, max_y};
-    ctx->segmentos[idx].source = MARCADOR_RETANGULO;
-    idx++;
-    
-    ctx->segmentos[idx].pto_ini = (Ponto2D){max_x, max_y};
-    ctx->segmentos[idx].pto_fim = (Ponto2D){min_x, max_y};
-    ctx->segmentos[idx].source = MARCADOR_RETANGULO;
-    idx++;
-    
-    ctx->segmentos[idx].pto_ini = (Ponto2D){min_x, max_y};
-    ctx->segmentos[idx].pto_fim = (Ponto2D){min_x, min_y};
-    ctx->segmentos[idx].source = MARCADOR_RETANGULO;
-    idx++;
-    
-    //Adiciona anteparos
-    for (Celula c = getInicioLista(formas); c; c = getProxCelula(c)) {
-        Forma f = getConteudoCelula(c);
-        if (getTipoForma(f) != ANTEPARO) continue;
+    vi->tipo = INICIO;
+    vi->pSeg = s;
+    vi->ponto = s->pto_ini;
+    vi->codigo = cod;
+    vi->ang = angulo(ctx->x, vi->ponto);
+    vi->dist = distancia(ctx->x, vi->ponto);
+    
+    vf->tipo = FIM;
+    vf->pSeg = s;
+    vf->ponto = s->pto_fim;
+    vf->codigo = cod;
+    vf->ang = angulo(ctx->x, vf->ponto);
+    vf->dist = distancia(ctx->x, vf->ponto);
+}
+
+// Ordena os próprios registros de vértice, sem array de ponteiros nem cópia posterior.
+// Os algoritmos de comparação usam insertion sort nos subarrays de até 'threshold'
+// elementos; o radix sort usa inserção só quando o conjunto inteiro cabe no limiar
+static void ordenaVertices(CtxVis* ctx) {
+    size_t limiar = ctx->threshold > 0 ? (size_t)ctx->threshold : 0;
+    if (ctx->tipo_sort == 'm') {
+        vertices_merge_sort(ctx->vertices, ctx->n_vertices, limiar);
+    } else if (ctx->tipo_sort == 'r') {
+        ctx->vertices = ordenaVerticesRadix(ctx->vertices, ctx->n_vertices, limiar);
+    } else if (ctx->tipo_sort == 'p') {
+        // Abaixo de SORT_CORTE_PARALELO vértices cai no merge sort sequencial
+        merge_sort_paralelo(ctx->vertices, ctx->n_vertices, sizeof(Vertice),
+                            cmpVerticesGenerico, limiar, 0);
+    } else {
+        vertices_quick_sort(ctx->vertices, ctx->n_vertices, limiar);
+    }
+}
+
+// Um passo da varredura angular
+static void processaVertice(CtxVis* ctx, Vertice* v) {
+    ctx->raio = v->ponto;
+    if (v->tipo == INICIO) {
+        // Vértice de início
+        if (!encoberto(ctx, v)) {
+            // v está na frente
+            SegmentoInterno* s = segAtivoMaisProx(ctx, v->ponto);
+            if (s != NULL) {
+                Ponto2D y = interseccao(ctx->x, v->ponto, s);
+                if (y.x != INFINITY && distancia(ctx->biombo, y) > EPSILON) {
+                    emiteVertice(ctx, ctx->biombo);
+                    
+                    if (distancia(y, v->ponto) > EPSILON) {
+                        emiteVertice(ctx, y);
+                    }
+                }
+            }
+            ctx->biombo = v->ponto;
+        }
+        insereSegmentoAtivo(ctx, v->pSeg);
         
-        Anteparo a = getDataForma(f);
-        ctx->segmentos[idx].pto_ini.x = getX1Anteparo(a);
-        ctx->segmentos[idx].pto_ini.y = getY1Anteparo(a);
-        ctx->segmentos[idx].pto_fim.x = getX2Anteparo(a);
-        ctx->segmentos[idx].pto_fim.y = getY2Anteparo(a);
-        ctx->segmentos[idx].source = a;
-        idx++;
+    } else {
+        // Vértice de fim
+        if (!encoberto(ctx, v)) {
+            // v está na frente
+            if (distancia(ctx->biombo, v->ponto) > EPSILON) {
+                emiteVertice(ctx, ctx->biombo);
+            }
+            
+            removeSegmentoAtivo(ctx, v->pSeg);
+            SegmentoInterno* sy = segAtivoMaisProx(ctx, v->ponto);
+            
+            if (sy != NULL) {
+                Ponto2D y = interseccao(ctx->x, v->ponto, sy);
+                if (y.x != INFINITY && distancia(v->ponto, y) > EPSILON) {
+                    emiteVertice(ctx, v->ponto);
+                    ctx->biombo = y;
+                } else {
+                    ctx->biombo = v->ponto;
+                }
+            } else {
+                ctx->biombo = v->ponto;
+            }
+        } else {
+            removeSegmentoAtivo(ctx, v->pSeg);
+        }
+    }
+}
+
+// Segmentos que cruzam o ângulo -pi têm o FIM antes do INICIO na ordem da varredura:
+// já estão ativos quando ela começa, no raio para -pi
+// O segmento passa pelo ângulo -pi (começa antes e termina depois da emenda)?
+static bool cruzaEmenda(CtxVis* ctx, SegmentoInterno* s) {
+    return angulo(ctx->x, s->pto_ini) > angulo(ctx->x, s->pto_fim);
+}
+
+static void iniciaStatus(CtxVis* ctx) {
+    limpaArvoreBinaria(ctx->SegsAtvs, NULL);
+    for (int i = 0; i < ctx->n_segmentos; i++) {
+        ctx->segmentos[i].no = NULL;
     }
     
-    //Orienta segmentos: menor ângulo = INICIO, maior ângulo = FIM
+    ctx->raio = (Ponto2D){ctx->x.x - 1.0f, ctx->x.y};
     for (int i = 0; i < ctx->n_segmentos; i++) {
-        float ang1 = normalizar_angulo(angulo(ctx->x, ctx->segmentos[i].pto_ini));
-        float ang2 = normalizar_angulo(angulo(ctx->x, ctx->segmentos[i].pto_fim));
-        
-        // Se ang1 > ang2, troca para que pto_ini tenha o menor ângulo
-        // Também trata o caso de wrap-around (quando |ang1 - ang2| > PI)
-        bool deve_trocar = false;
-        
-        if (fabs(ang1 - ang2) > M_PI) {
-            // Cruzando o ângulo zero: o maior ângulo é na verdade o "início"
-            // Então se ang1 < ang2, ang1 está perto de 0, ang2 perto de 2PI
-            // Neste caso, ang2 é o início real
-            deve_trocar = (ang1 < ang2);
-        } else {
-            // Caso normal: menor ângulo é início
-            deve_trocar = (ang1 > ang2);
+        SegmentoInterno* s = &ctx->segmentos[i];
+        if (s->removido) continue;
+        if (cruzaEmenda(ctx, s)) {
+            insereSegmentoAtivo(ctx, s);
+        }
+    }
+}
+
+// Começa a varredura com o status inicial e o biombo no ponto visível em -pi
+static void iniciaVarredura(CtxVis* ctx) {
+    iniciaStatus(ctx);
+    if (ctx->n_vertices == 0) return;
+    
+    ctx->biombo = ctx->vertices[0].ponto;
+    SegmentoInterno* s = segAtivoMaisProx(ctx, ctx->raio);
+    if (s != NULL) {
+        Ponto2D y = interseccao(ctx->x, ctx->raio, s);
+        if (y.x != INFINITY) ctx->biombo = y;
+    }
+}
+
+// Registra o estado da varredura depois do i-ésimo vértice, para retomá-la dali
+static void registraPasso(CtxVis* ctx, int i) {
+    ctx->emitidos[i] = getNumVertices(ctx->regiao);
+    ctx->biombo_apos[i] = ctx->biombo;
+}
+
+// Fecha o polígono: adiciona segmento do biombo atual de volta ao primeiro vértice
+static void fechaPoligono(CtxVis* ctx) {
+    ctx->fechado = false;
+    if (ctx->n_vertices > 0 && getNumVertices(ctx->regiao) > 0) {
+        Ponto2D primeiro = ctx->vertices[0].ponto;
+        if (distancia(ctx->biombo, primeiro) > EPSILON) {
+            emiteVertice(ctx, ctx->biombo);
+            ctx->fechado = true;
+        }
+    }
+}
+
+static SegmentoPlano planoAnteparo(Anteparo a) {
+    SegmentoPlano p = {getX1Anteparo(a), getY1Anteparo(a), getX2Anteparo(a), getY2Anteparo(a)};
+    return p;
+}
+
+// Segmento interno a partir de um pedaço do anteparo 'a' (ainda não orientado)
+static void preencheSegmento(SegmentoInterno* s, const PedacoSegmento* pedaco,
+                             const SegmentoPlano* orig, Anteparo a) {
+    s->pto_ini = (Ponto2D){pedaco->x1, pedaco->y1};
+    s->pto_fim = (Ponto2D){pedaco->x2, pedaco->y2};
+    s->orig_ini = (Ponto2D){orig->x1, orig->y1};
+    s->orig_fim = (Ponto2D){orig->x2, orig->y2};
+    s->source = a;
+    s->removido = false;
+    s->no = NULL;
+    s->cobertura = false;
+}
+
+static float distanciaAoSegmento(Ponto2D x, const SegmentoPlano* s) {
+    double dx = (double)s->x2 - s->x1;
+    double dy = (double)s->y2 - s->y1;
+    double l2 = dx*dx + dy*dy;
+    double t = (l2 == 0.0) ? 0.0 : (((double)x.x - s->x1) * dx + ((double)x.y - s->y1) * dy) / l2;
+    if (t < 0.0) t = 0.0;
+    if (t > 1.0) t = 1.0;
+    double px = s->x1 + t * dx - x.x;
+    double py = s->y1 + t * dy - x.y;
+    return sqrt(px*px + py*py);
+}
+
+// Direções ocupadas por um anteparo visto do observador, em [-pi, pi]
+typedef struct {
+    float ini, fim;
+} IntervaloAngular;
+
+#define INTERVALO_MENOR(a, b) ((a)->ini < (b)->ini)
+SORT_TIPADO(intervalos, IntervaloAngular, INTERVALO_MENOR)
+
+// Intervalo do segmento; dois se ele passa pelo ângulo -pi. Retorna quantos
+// (nenhum se o segmento passa rente ao observador)
+static int intervalosDoSegmento(Ponto2D x, const SegmentoPlano* s, IntervaloAngular* saida) {
+    if (distanciaAoSegmento(x, s) < 1e-3f) return 0;
+    
+    float a1 = angulo(x, (Ponto2D){s->x1, s->y1});
+    float a2 = angulo(x, (Ponto2D){s->x2, s->y2});
+    float lo = fmin(a1, a2), hi = fmax(a1, a2);
+    if (hi - lo <= M_PI) {
+        saida[0] = (IntervaloAngular){lo, hi};
+        return 1;
+    }
+    saida[0] = (IntervaloAngular){hi, (float)M_PI};
+    saida[1] = (IntervaloAngular){(float)-M_PI, lo};
+    return 2;
+}
+
+// Os intervalos cobrem todas as direções? (ordena 'iv')
+static bool cobreTodasDirecoes(IntervaloAngular* iv, int n) {
+    intervalos_quick_sort(iv, n, SORT_LIMIAR_PADRAO);
+    
+    float alcance = (float)-M_PI;
+    for (int i = 0; i < n; i++) {
+        if (iv[i].ini > alcance) return false;
+        if (iv[i].fim > alcance) alcance = iv[i].fim;
+    }
+    return alcance >= (float)M_PI;
+}
+
+// Anteparo achado na busca por cobertura, com a distância da extremidade mais longe
+typedef struct {
+    float longe;
+    int indice;
+} AnteparoAchado;
+
+#define ACHADO_MENOR(a, b) ((a)->longe < (b)->longe)
+SORT_TIPADO(achados, AnteparoAchado, ACHADO_MENOR)
+
+// Os k primeiros anteparos achados cobrem todas as direções?
+static bool prefixoCobre(Ponto2D x, const SegmentoPlano* planos, AnteparoAchado* achados,
+                         int k, IntervaloAngular* iv) {
+    int n_iv = 0;
+    for (int i = 0; i < k; i++) {
+        n_iv += intervalosDoSegmento(x, &planos[achados[i].indice], &iv[n_iv]);
+    }
+    return cobreTodasDirecoes(iv, n_iv);
+}
+
+// Raio além do qual nenhum anteparo pode ser visto: cresce anéis de células a partir
+// do observador até que os anteparos achados cubram todas as direções. Todo raio é
+// então barrado antes da extremidade mais distante deles; entre os achados, usa só
+// os mais próximos que ainda cobrem tudo. Marca em 'cobertura' os anteparos usados.
+// INFINITY se não há cobertura
+static float raioDeCorte(Ponto2D x, const SegmentoPlano* planos, int n, bool* cobertura) {
+    for (int i = 0; i < n; i++) cobertura[i] = false;
+    if (n < CORTE_MIN_ANTEPAROS) return INFINITY;
+    
+    GradeSegmentos g = criaGradeSegmentos(planos, n);
+    int* anel_atual = malloc(n * sizeof(int));
+    AnteparoAchado* achados = malloc(n * sizeof(AnteparoAchado));
+    IntervaloAngular* iv = malloc(2 * n * sizeof(IntervaloAngular));
+    if (!g || !anel_atual || !achados || !iv) {
+        liberaGradeSegmentos(g);
+        free(anel_atual);
+        free(achados);
+        free(iv);
+        return INFINITY;
+    }
+    
+    int n_achados = 0, n_verificados = 0;
+    bool coberto = false;
+    int n_aneis = getNumAneisGrade(g, x.x, x.y);
+    iniciaConsultaGrade(g);
+    
+    for (int anel = 0; anel < n_aneis && !coberto; anel++) {
+        int m = segmentosDoAnel(g, x.x, x.y, anel, anel_atual);
+        for (int i = 0; i < m; i++) {
+            const SegmentoPlano* s = &planos[anel_atual[i]];
+            if (distanciaAoSegmento(x, s) < 1e-3f) continue;  // Rente ao observador
+            achados[n_achados].indice = anel_atual[i];
+            achados[n_achados].longe = fmax(distancia(x, (Ponto2D){s->x1, s->y1}),
+                                            distancia(x, (Ponto2D){s->x2, s->y2}));
+            n_achados++;
         }
         
-        if (deve_trocar) {
-            Ponto2D temp = ctx->segmentos[i].pto_ini;
-            ctx->segmentos[i].pto_ini = ctx->segmentos[i].pto_fim;
-            ctx->segmentos[i].pto_fim = temp;
+        // Só verifica de novo quando os achados dobram, e no último anel
+        if (n_achados >= 2 * n_verificados + 4 || anel == n_aneis - 1) {
+            n_verificados = n_achados;
+            coberto = prefixoCobre(x, planos, achados, n_achados, iv);
         }
     }
     
+    float raio = INFINITY;
+    if (coberto) {
+        // Menor prefixo, em ordem de distância, que ainda cobre todas as direções
+        achados_quick_sort(achados, n_achados, SORT_LIMIAR_PADRAO);
+        int lo = 1, hi = n_achados;
+        while (lo < hi) {
+            int meio = lo + (hi - lo) / 2;
+            if (prefixoCobre(x, planos, achados, meio, iv)) hi = meio;
+            else lo = meio + 1;
+        }
+        raio = achados[lo - 1].longe;
+        for (int i = 0; i < lo; i++) cobertura[achados[i].indice] = true;
+    }
+    
+    liberaGradeSegmentos(g);
+    free(anel_atual);
+    free(achados);
+    free(iv);
+    return raio;
+}
+
+ContextoVisibilidade criaContextoVisibilidade(float x, float y, Vetor formas,
+                                              char tipo_sort, int threshold) {
+    if (!formas) return NULL;
+    
+    CtxVis* ctx = malloc(sizeof(CtxVis));
+    ctx->x.x = x;
+    ctx->x.y = y;
+    ctx->tipo_sort = tipo_sort;
+    ctx->threshold = threshold;
+    ctx->SegsAtvs = criaArvoreBinariaComPool(cmpSegmentos, ctx, 0);
+    ctx->indice.estado = 0;
+    ctx->indice.n = 0;
+    ctx->indice.ang = NULL;
+    ctx->indice.pts = NULL;
+    ctx->n_raios = 0;
+    ctx->erro = 0.0f;
+    
+    calculaEnvolvente(x, y, formas, &ctx->env_min_x, &ctx->env_min_y,
+                      &ctx->env_max_x, &ctx->env_max_y);
+    float min_x = ctx->env_min_x;
+    float min_y = ctx->env_min_y;
+    float max_x = ctx->env_max_x;
+    float max_y = ctx->env_max_y;
+    
+    // Anteparos divididos nos pontos em que se cruzam
+    int n_ant = 0;
+    for (int q = 0; q < getTamanhoVetor(formas); q++) {
+        if (getTipoForma(getElementoVetor(formas, q)) == ANTEPARO) n_ant++;
+    }
+    
+    Anteparo* ants = malloc((n_ant + 1) * sizeof(Anteparo));
+    SegmentoPlano* planos = malloc((n_ant + 1) * sizeof(SegmentoPlano));
+    if (!ants || !planos) {
+        printf("Erro de alocação para anteparos da visibilidade\n");
+        exit(1);
+    }
+    
+    int k = 0;
+    for (int q = 0; q < getTamanhoVetor(formas); q++) {
+        Forma f = getElementoVetor(formas, q);
+        if (getTipoForma(f) != ANTEPARO) continue;
+        ants[k] = getDataForma(f);
+        planos[k] = planoAnteparo(ants[k]);
+        k++;
+    }
+    
+    // Descarta os anteparos escondidos atrás de um anel fechado de anteparos próximos
+    bool* cobertura = malloc((n_ant + 1) * sizeof(bool));
+    if (!cobertura) {
+        printf("Erro de alocação para anteparos da visibilidade\n");
+        exit(1);
+    }
+    ctx->raio_corte = raioDeCorte(ctx->x, planos, n_ant, cobertura);
+    if (ctx->raio_corte != INFINITY) {
+        int mantidos = 0;
+        for (int i = 0; i < n_ant; i++) {
+            if (distanciaAoSegmento(ctx->x, &planos[i]) > ctx->raio_corte) continue;
+            ants[mantidos] = ants[i];
+            planos[mantidos] = planos[i];
+            cobertura[mantidos] = cobertura[i];
+            mantidos++;
+        }
+        n_ant = mantidos;
+    }
+    
+    PedacoSegmento* pedacos = NULL;
+    int n_pedacos = divideSegmentosCruzados(planos, n_ant, &pedacos);
+    
+    ctx->n_segmentos = n_pedacos + 4;
+    ctx->cap_segmentos = ctx->n_segmentos;
+    ctx->segmentos = malloc(ctx->n_segmentos * sizeof(SegmentoInterno));
+    
+    // Adiciona retângulo envolvente (sempre nas quatro primeiras posições)
+    Ponto2D cantos[4] = {{min_x, min_y}, {max_x, min_y}, {max_x, max_y}, {min_x, max_y}};
+    for (int i = 0; i < 4; i++) {
+        SegmentoInterno* seg = &ctx->segmentos[i];
+        seg->pto_ini = cantos[i];
+        seg->pto_fim = cantos[(i + 1) % 4];
+        seg->orig_ini = seg->pto_ini;
+        seg->orig_fim = seg->pto_fim;
+        seg->source = MARCADOR_RETANGULO;
+        seg->cobertura = false;
+    }
+    
+    // Pedaços de um mesmo anteparo ficam contíguos
+    for (int p = 0; p < n_pedacos; p++) {
+        int o = pedacos[p].origem;
+        preencheSegmento(&ctx->segmentos[4 + p], &pedacos[p], &planos[o], ants[o]);
+        ctx->segmentos[4 + p].cobertura = cobertura[o];
+    }
+    free(pedacos);
+    free(planos);
+    free(ants);
+    free(cobertura);
+    
+    for (int i = 0; i < ctx->n_segmentos; i++) {
+        ctx->segmentos[i].removido = false;
+        ctx->segmentos[i].no = NULL;
+        orientaSegmento(ctx->x, &ctx->segmentos[i]);
+    }
+    
     // Cria vértices
     ctx->n_vertices = ctx->n_segmentos * 2;
     ctx->vertices = malloc(ctx->n_vertices * sizeof(Vertice));
     
     for (int i = 0; i < ctx->n_segmentos; i++) {
-        CodigoVertice cod = (ctx->segmentos[i].source == NULL) ? RE : ORIG;
-        
-        ctx->vertices[2*i].tipo = INICIO;
-        ctx->vertices[2*i].pSeg = &ctx->segmentos[i];
-        ctx->vertices[2*i].ponto = ctx->segmentos[i].pto_ini;
-        ctx->vertices[2*i].codigo = cod;
-        
-        ctx->vertices[2*i+1].tipo = FIM;
-        ctx->vertices[2*i+1].pSeg = &ctx->segmentos[i];
-        ctx->vertices[2*i+1].ponto = ctx->segmentos[i].pto_fim;
-        ctx->vertices[2*i+1].codigo = cod;
+        criaVerticesSegmento(ctx, &ctx->segmentos[i], &ctx->vertices[2*i], &ctx->vertices[2*i+1]);
     }
     
-    // Ordena vértices
-    g_origem_ordenacao = ctx->x;
+    // Cada vértice da varredura emite no máximo dois vértices de V(x), mais o de fechamento
+    ctx->regiao = criaPoligonoCapacidade(2 * ctx->n_vertices + 1);
+    
+    ordenaVertices(ctx);
+    
+    ctx->emitidos = malloc(ctx->n_vertices * sizeof(int));
+    ctx->biombo_apos = malloc(ctx->n_vertices * sizeof(Ponto2D));
     
-    Vertice** arr = malloc(ctx->n_vertices * sizeof(Vertice*));
+    iniciaVarredura(ctx);
+    
+    //Executa varredura angular
     for (int i = 0; i < ctx->n_vertices; i++) {
-        arr[i] = &ctx->vertices[i];
+        processaVertice(ctx, &ctx->vertices[i]);
+        registraPasso(ctx, i);
     }
     
-    if (ctx->n_vertices <= ctx->threshold) {
-        insertion_sort(arr, ctx->n_vertices, sizeof(Vertice*), cmpVertices);
-    } else if (ctx->tipo_sort == 'm') {
-        merge_sort(arr, ctx->n_vertices, sizeof(Vertice*), cmpVertices);
-    } else {
-        quick_sort(arr, ctx->n_vertices, sizeof(Vertice*), cmpVertices);
+    fechaPoligono(ctx);
+    
+    return ctx;
+}
+
+ContextoVisibilidade criaContextoVisibilidadeAprox(float x, float y, Vetor formas, int n_raios) {
+    if (!formas || n_raios < 3) return NULL;
+    
+    CtxVis* ctx = malloc(sizeof(CtxVis));
+    if (!ctx) {
+        printf("Erro de alocação para contexto de visibilidade\n");
+        exit(1);
     }
+    ctx->x.x = x;
+    ctx->x.y = y;
+    ctx->segmentos = NULL;
+    ctx->n_segmentos = 0;
+    ctx->cap_segmentos = 0;
+    ctx->vertices = NULL;
+    ctx->n_vertices = 0;
+    ctx->SegsAtvs = NULL;
+    ctx->emitidos = NULL;
+    ctx->biombo_apos = NULL;
+    ctx->fechado = false;
+    ctx->indice.estado = 0;
+    ctx->indice.n = 0;
+    ctx->indice.ang = NULL;
+    ctx->indice.pts = NULL;
+    ctx->raio_corte = INFINITY;
+    ctx->n_raios = n_raios;
+    ctx->erro = 0.0f;
+    ctx->tipo_sort = 'q';
+    ctx->threshold = 0;
     
-    Vertice* ordenados = malloc(ctx->n_vertices * sizeof(Vertice));
-    for (int i = 0; i < ctx->n_vertices; i++) {
-        ordenados[i] = *arr[i];
+    calculaEnvolvente(x, y, formas, &ctx->env_min_x, &ctx->env_min_y,
+                      &ctx->env_max_x, &ctx->env_max_y);
+    
+    // Anteparos e os quatro lados do retângulo envolvente: todo raio atinge algum
+    int n_ant = 0;
+    for (int q = 0; q < getTamanhoVetor(formas); q++) {
+        if (getTipoForma(getElementoVetor(formas, q)) == ANTEPARO) n_ant++;
+    }
+    SegmentoPlano* planos = malloc((n_ant + 4) * sizeof(SegmentoPlano));
+    if (!planos) {
+        printf("Erro de alocação para anteparos da visibilidade\n");
+        exit(1);
     }
-    free(arr);
-    free(ctx->vertices);
-    ctx->vertices = ordenados;
     
-    //Inicializa biombo
-    if (ctx->n_vertices > 0) {
-        ctx->biombo = ctx->vertices[0].ponto;
+    int k = 0;
+    for (int q = 0; q < getTamanhoVetor(formas); q++) {
+        Forma f = getElementoVetor(formas, q);
+        if (getTipoForma(f) == ANTEPARO) planos[k++] = planoAnteparo(getDataForma(f));
     }
+    float x0 = ctx->env_min_x, y0 = ctx->env_min_y, x1 = ctx->env_max_x, y1 = ctx->env_max_y;
+    planos[k++] = (SegmentoPlano){x0, y0, x1, y0};
+    planos[k++] = (SegmentoPlano){x1, y0, x1, y1};
+    planos[k++] = (SegmentoPlano){x1, y1, x0, y1};
+    planos[k++] = (SegmentoPlano){x0, y1, x0, y0};
     
-    //Executa varredura angular
-    for (int i = 0; i < ctx->n_vertices; i++) {
-        Vertice* v = &ctx->vertices[i];
+    GradeSegmentos g = criaGradeSegmentos(planos, k);
+    ctx->regiao = criaPoligonoCapacidade(n_raios);
+    
+    // Raios no meio de cada passo, para nenhum cair sobre a emenda em -pi
+    double passo = 2 * M_PI / n_raios;
+    float primeira = 0.0f, anterior = 0.0f;
+    for (int i = 0; i < n_raios; i++) {
+        double theta = -M_PI + (i + 0.5) * passo;
+        float dx = (float)cos(theta), dy = (float)sin(theta);
+        float t = 0.0f;
+        if (lancaRaioGrade(g, planos, x, y, dx, dy, &t) < 0) continue;
         
-        if (v->tipo == INICIO) {
-            // Vértice de início
-            if (!encoberto(ctx, v)) {
-                // v está na frente
-                SegmentoInterno* s = segAtivoMaisProx(ctx, v->ponto);
-                if (s != NULL) {
-                    Ponto2D y = interseccao(ctx->x, v->ponto, s);
-                    if (y.x != INFINITY && distancia(ctx->biombo, y) > EPSILON) {
-                        SegmentoInterno* seg1 = malloc(sizeof(SegmentoInterno));
-                        seg1->pto_ini = ctx->biombo;
-                        seg1->pto_fim = y;
-                        seg1->source = NULL;
-                        insereFinalLista(ctx->regiao_visibilidade, seg1);
-                        
-                        if (distancia(y, v->ponto) > EPSILON) {
-                            SegmentoInterno* seg2 = malloc(sizeof(SegmentoInterno));
-                            seg2->pto_ini = y;
-                            seg2->pto_fim = v->ponto;
-                            seg2->source = NULL;
-                            insereFinalLista(ctx->regiao_visibilidade, seg2);
-                        }
-                    }
-                }
-                ctx->biombo = v->ponto;
-            }
-            insereArvoreBinaria(ctx->SegsAtvs, v->pSeg);
-            
+        if (getNumVertices(ctx->regiao) == 0) primeira = t;
+        else ctx->erro = fmax(ctx->erro, fmax(anterior, t));
+        insereVerticeXY(ctx->regiao, x + t * dx, y + t * dy);
+        anterior = t;
+    }
+    ctx->erro = fmax(ctx->erro, fmax(anterior, primeira));
+    
+    // Entre dois raios vizinhos a aproximação é a corda: um detalhe mais estreito
+    // que o arco entre eles, na maior profundidade dos dois, pode passar despercebido
+    ctx->erro *= 2 * sin(passo / 2);
+    
+    liberaGradeSegmentos(g);
+    free(planos);
+    return ctx;
+}
+
+float getErroVisibilidade(ContextoVisibilidade C) {
+    if (!C) return 0.0f;
+    return ((CtxVis*)C)->erro;
+}
+
+// Referência a um anteparo, para comparar o conjunto do contexto com o do vetor de formas
+typedef struct {
+    uintptr_t ptr;
+    int indice;  // Posição em ctx->segmentos, ou no array de anteparos atuais
+} RefAnteparo;
+
+#define REF_MENOR(a, b) ((a)->ptr < (b)->ptr)
+SORT_TIPADO(refs, RefAnteparo, REF_MENOR)
+
+// O endereço pode ter sido reaproveitado por outro anteparo: confere também as coordenadas
+static bool mesmoSegmento(SegmentoInterno* s, Anteparo a) {
+    return s->orig_ini.x == getX1Anteparo(a) && s->orig_ini.y == getY1Anteparo(a) &&
+           s->orig_fim.x == getX2Anteparo(a) && s->orig_fim.y == getY2Anteparo(a);
+}
+
+static SegmentoPlano planoSegmento(SegmentoInterno* s) {
+    SegmentoPlano p = {s->orig_ini.x, s->orig_ini.y, s->orig_fim.x, s->orig_fim.y};
+    return p;
+}
+
+// Marca como removidos os pedaços do anteparo que começam em 'inicio'. Retorna quantos
+static int removeGrupo(CtxVis* ctx, int inicio) {
+    Anteparo a = ctx->segmentos[inicio].source;
+    int n = 0;
+    for (int i = inicio; i < ctx->n_segmentos && ctx->segmentos[i].source == a &&
+                         !ctx->segmentos[i].removido; i++) {
+        ctx->segmentos[i].removido = true;
+        n++;
+    }
+    return n;
+}
+
+bool atualizaContextoVisibilidade(ContextoVisibilidade C, Vetor formas) {
+    if (!C || !formas) return false;
+    CtxVis* ctx = (CtxVis*)C;
+    
+    // A aproximação por raios não guarda a varredura: é refeita
+    if (ctx->n_raios > 0) return false;
+    
+    // Retângulo envolvente diferente muda V(x) longe dos anteparos alterados
+    float min_x, min_y, max_x, max_y;
+    calculaEnvolvente(ctx->x.x, ctx->x.y, formas, &min_x, &min_y, &max_x, &max_y);
+    if (min_x != ctx->env_min_x || min_y != ctx->env_min_y ||
+        max_x != ctx->env_max_x || max_y != ctx->env_max_y) {
+        return false;
+    }
+    
+    // Diferença entre os anteparos do contexto e os do vetor, por endereço
+    int n_atuais = 0;
+    for (int q = 0; q < getTamanhoVetor(formas); q++) {
+        if (getTipoForma(getElementoVetor(formas, q)) == ANTEPARO) n_atuais++;
+    }
+    
+    Anteparo* atuais = malloc((n_atuais + 1) * sizeof(Anteparo));
+    SegmentoPlano* planos = malloc((n_atuais + 1) * sizeof(SegmentoPlano));
+    RefAnteparo* ref_atuais = malloc((n_atuais + 1) * sizeof(RefAnteparo));
+    RefAnteparo* ref_ctx = malloc(ctx->n_segmentos * sizeof(RefAnteparo));
+    int* removidos = malloc(ctx->n_segmentos * sizeof(int));
+    int* mantidos = malloc(2 * ctx->n_segmentos * sizeof(int));
+    int* adicionados = malloc((n_atuais + 1) * sizeof(int));
+    bool* cobre_atual = malloc((n_atuais + 1) * sizeof(bool));
+    int* seg_do_vertice = malloc(ctx->n_vertices * sizeof(int));
+    if (!atuais || !planos || !ref_atuais || !ref_ctx || !removidos || !mantidos ||
+        !adicionados || !cobre_atual || !seg_do_vertice) {
+        free(atuais);
+        free(planos);
+        free(ref_atuais);
+        free(ref_ctx);
+        free(removidos);
+        free(mantidos);
+        free(adicionados);
+        free(cobre_atual);
+        free(seg_do_vertice);
+        return false;
+    }
+    
+    // Anteparos inteiros além do raio de corte continuam escondidos pela cobertura
+    int k = 0;
+    for (int q = 0; q < getTamanhoVetor(formas); q++) {
+        Forma f = getElementoVetor(formas, q);
+        if (getTipoForma(f) != ANTEPARO) continue;
+        atuais[k] = getDataForma(f);
+        planos[k] = planoAnteparo(atuais[k]);
+        if (distanciaAoSegmento(ctx->x, &planos[k]) > ctx->raio_corte) continue;
+        ref_atuais[k].ptr = (uintptr_t)atuais[k];
+        ref_atuais[k].indice = k;
+        cobre_atual[k] = false;
+        k++;
+    }
+    n_atuais = k;
+    
+    // As quatro primeiras posições são o retângulo envolvente. Cada anteparo entra
+    // uma vez, pelo primeiro dos seus pedaços
+    int n_ctx = 0;
+    for (int i = 4; i < ctx->n_segmentos; i++) {
+        SegmentoInterno* seg = &ctx->segmentos[i];
+        if (seg->removido) continue;
+        if (!seg[-1].removido && seg[-1].source == seg->source) continue;
+        ref_ctx[n_ctx].ptr = (uintptr_t)seg->source;
+        ref_ctx[n_ctx].indice = i;
+        n_ctx++;
+    }
+    
+    refs_quick_sort(ref_atuais, n_atuais, SORT_LIMIAR_PADRAO);
+    refs_quick_sort(ref_ctx, n_ctx, SORT_LIMIAR_PADRAO);
+    
+    int n_rem = 0, n_add = 0, n_mant = 0;
+    int i = 0, j = 0;
+    while (i < n_ctx || j < n_atuais) {
+        if (j == n_atuais || (i < n_ctx && ref_ctx[i].ptr < ref_atuais[j].ptr)) {
+            removidos[n_rem++] = ref_ctx[i++].indice;
+        } else if (i == n_ctx || ref_atuais[j].ptr < ref_ctx[i].ptr) {
+            adicionados[n_add++] = ref_atuais[j++].indice;
         } else {
-            // Vértice de fim
-            if (!encoberto(ctx, v)) {
-                // v está na frente
-                if (distancia(ctx->biombo, v->ponto) > EPSILON) {
-                    SegmentoInterno* seg1 = malloc(sizeof(SegmentoInterno));
-                    seg1->pto_ini = ctx->biombo;
-                    seg1->pto_fim = v->ponto;
-                    seg1->source = NULL;
-                    insereFinalLista(ctx->regiao_visibilidade, seg1);
-                }
-                
-                removeArvoreBinaria(ctx->SegsAtvs, v->pSeg);
-                SegmentoInterno* sy = segAtivoMaisProx(ctx, v->ponto);
-                
-                if (sy != NULL) {
-                    Ponto2D y = interseccao(ctx->x, v->ponto, sy);
-                    if (y.x != INFINITY && distancia(v->ponto, y) > EPSILON) {
-                        SegmentoInterno* seg2 = malloc(sizeof(SegmentoInterno));
-                        seg2->pto_ini = v->ponto;
-                        seg2->pto_fim = y;
-                        seg2->source = NULL;
-                        insereFinalLista(ctx->regiao_visibilidade, seg2);
-                        ctx->biombo = y;
-                    } else {
-                        ctx->biombo = v->ponto;
-                    }
-                } else {
-                    ctx->biombo = v->ponto;
-                }
+            if (!mesmoSegmento(&ctx->segmentos[ref_ctx[i].indice], atuais[ref_atuais[j].indice])) {
+                removidos[n_rem++] = ref_ctx[i].indice;
+                adicionados[n_add++] = ref_atuais[j].indice;
             } else {
-                removeArvoreBinaria(ctx->SegsAtvs, v->pSeg);
+                mantidos[2 * n_mant] = ref_ctx[i].indice;
+                mantidos[2 * n_mant + 1] = ref_atuais[j].indice;
+                n_mant++;
             }
+            i++;
+            j++;
         }
     }
     
-    // Fecha o polígono: adiciona segmento do biombo atual de volta ao primeiro vértice
-    if (ctx->n_vertices > 0 && !listaVazia(ctx->regiao_visibilidade)) {
-        Ponto2D primeiro = ctx->vertices[0].ponto;
-        if (distancia(ctx->biombo, primeiro) > EPSILON) {
-            SegmentoInterno* seg_final = malloc(sizeof(SegmentoInterno));
-            seg_final->pto_ini = ctx->biombo;
-            seg_final->pto_fim = primeiro;
-            seg_final->source = NULL;
-            insereFinalLista(ctx->regiao_visibilidade, seg_final);
+    free(ref_atuais);
+    free(ref_ctx);
+    
+    // Sem um anteparo da cobertura o raio de corte pode não valer mais
+    bool cobertura_desfeita = false;
+    for (int r = 0; r < n_rem; r++) {
+        if (ctx->segmentos[removidos[r]].cobertura) cobertura_desfeita = true;
+    }
+    
+    if (cobertura_desfeita || (n_rem == 0 && n_add == 0)) {
+        free(atuais);
+        free(planos);
+        free(removidos);
+        free(mantidos);
+        free(adicionados);
+        free(cobre_atual);
+        free(seg_do_vertice);
+        return !cobertura_desfeita;
+    }
+    
+    // Anteparos mantidos que cruzam um alterado têm outros pedaços agora: são refeitos
+    int n_rem_grupos = n_rem, n_add_diretos = n_add;
+    for (int m = 0; m < n_mant; m++) {
+        SegmentoPlano pm = planoSegmento(&ctx->segmentos[mantidos[2 * m]]);
+        bool afetado = false;
+        for (int r = 0; r < n_rem_grupos && !afetado; r++) {
+            SegmentoPlano pr = planoSegmento(&ctx->segmentos[removidos[r]]);
+            afetado = cruzamentoSegmentos(&pm, &pr, NULL, NULL);
+        }
+        for (int a = 0; a < n_add_diretos && !afetado; a++) {
+            afetado = cruzamentoSegmentos(&pm, &planos[adicionados[a]], NULL, NULL);
+        }
+        if (afetado) {
+            removidos[n_rem++] = mantidos[2 * m];
+            adicionados[n_add++] = mantidos[2 * m + 1];
+            cobre_atual[mantidos[2 * m + 1]] = ctx->segmentos[mantidos[2 * m]].cobertura;
         }
     }
+    free(mantidos);
     
-    return ctx;
+    // Pedaços dos anteparos adicionados, divididos contra todos os anteparos atuais
+    PedacoSegmento* pedacos = NULL;
+    int n_pedacos = 0, cap_pedacos = 0;
+    for (int a = 0; a < n_add; a++) {
+        PedacoSegmento* p = NULL;
+        int np = divideSegmentoContra(&planos[adicionados[a]], planos, n_atuais, adicionados[a], &p);
+        if (n_pedacos + np > cap_pedacos) {
+            cap_pedacos = 2 * (n_pedacos + np);
+            pedacos = realloc(pedacos, cap_pedacos * sizeof(PedacoSegmento));
+            if (!pedacos) {
+                printf("Erro de alocação para pedaços de anteparos\n");
+                exit(1);
+            }
+        }
+        memcpy(&pedacos[n_pedacos], p, np * sizeof(PedacoSegmento));
+        n_pedacos += np;
+        free(p);
+    }
+    free(adicionados);
+    
+    // Vértices guardam ponteiros para os segmentos: passa para índices antes do realloc
+    for (int v = 0; v < ctx->n_vertices; v++) {
+        seg_do_vertice[v] = (int)(ctx->vertices[v].pSeg - ctx->segmentos);
+    }
+    
+    // Novos segmentos vão para o fim do array
+    if (ctx->n_segmentos + n_pedacos > ctx->cap_segmentos) {
+        int nova_cap = 2 * (ctx->n_segmentos + n_pedacos);
+        SegmentoInterno* segs = realloc(ctx->segmentos, nova_cap * sizeof(SegmentoInterno));
+        if (!segs) {
+            free(atuais);
+            free(planos);
+            free(removidos);
+            free(pedacos);
+            free(cobre_atual);
+            free(seg_do_vertice);
+            return false;
+        }
+        ctx->segmentos = segs;
+        ctx->cap_segmentos = nova_cap;
+    }
+    
+    // Segmento que passa por -pi está no status desde o início da varredura e
+    // volta a estar no fim: se um deles muda, ela é refeita inteira
+    bool emenda_alterada = false;
+    int n_rem_segs = 0;
+    for (int r = 0; r < n_rem; r++) {
+        int n_grupo = removeGrupo(ctx, removidos[r]);
+        for (int p = removidos[r]; p < removidos[r] + n_grupo; p++) {
+            if (cruzaEmenda(ctx, &ctx->segmentos[p])) emenda_alterada = true;
+        }
+        n_rem_segs += n_grupo;
+    }
+    
+    Vertice* novos = malloc((2 * n_pedacos + 1) * sizeof(Vertice));
+    if (!novos) {
+        printf("Erro de alocação para vértices da visibilidade\n");
+        exit(1);
+    }
+    for (int p = 0; p < n_pedacos; p++) {
+        SegmentoInterno* seg = &ctx->segmentos[ctx->n_segmentos++];
+        int o = pedacos[p].origem;
+        preencheSegmento(seg, &pedacos[p], &planos[o], atuais[o]);
+        seg->cobertura = cobre_atual[o];
+        orientaSegmento(ctx->x, seg);
+        if (cruzaEmenda(ctx, seg)) emenda_alterada = true;
+        criaVerticesSegmento(ctx, seg, &novos[2*p], &novos[2*p+1]);
+    }
+    free(pedacos);
+    free(atuais);
+    free(planos);
+    free(cobre_atual);
+    n_rem = n_rem_segs;
+    n_add = n_pedacos;
+    vertices_merge_sort(novos, 2 * n_add, SORT_LIMIAR_PADRAO);
+    
+    // Intercala os novos vértices com os antigos que sobraram. 'antigo' guarda a posição
+    // de cada vértice na varredura anterior (-1 se for novo); [lo, hi] cobre as alterações
+    int n_ant = ctx->n_vertices;
+    int n_novo = n_ant - 2 * n_rem + 2 * n_add;
+    Vertice* vnovo = malloc((n_novo + 1) * sizeof(Vertice));
+    int* antigo = malloc((n_novo + 1) * sizeof(int));
+    if (!vnovo || !antigo) {
+        printf("Erro de alocação para vértices da visibilidade\n");
+        exit(1);
+    }
+    int lo = n_novo, hi = -1;
+    float ang_limite = -INFINITY;
+    
+    i = 0;
+    j = 0;
+    k = 0;
+    while (i < n_ant || j < 2 * n_add) {
+        if (i < n_ant && ctx->segmentos[seg_do_vertice[i]].removido) {
+            if (k < lo) lo = k;
+            if (k > hi) hi = k;
+            if (ctx->vertices[i].ang > ang_limite) ang_limite = ctx->vertices[i].ang;
+            i++;
+        } else if (j < 2 * n_add && (i == n_ant || VERTICE_MENOR(&novos[j], &ctx->vertices[i]))) {
+            if (k < lo) lo = k;
+            if (k > hi) hi = k;
+            if (novos[j].ang > ang_limite) ang_limite = novos[j].ang;
+            vnovo[k] = novos[j++];
+            antigo[k++] = -1;
+        } else {
+            vnovo[k] = ctx->vertices[i];
+            vnovo[k].pSeg = &ctx->segmentos[seg_do_vertice[i]];
+            antigo[k++] = i++;
+        }
+    }
+    free(novos);
+    free(removidos);
+    free(seg_do_vertice);
+    
+    if (emenda_alterada) {
+        lo = 0;
+        hi = n_novo - 1;
+    }
+    
+    // Troca o resultado anterior pelo novo, guardando o anterior para os trechos que não mudam
+    Poligono regiao_ant = ctx->regiao;
+    int* emitidos_ant = ctx->emitidos;
+    Ponto2D* biombo_ant = ctx->biombo_apos;
+    int n_regiao_ant = getNumVertices(regiao_ant) - (ctx->fechado ? 1 : 0);
+    
+    free(ctx->vertices);
+    ctx->vertices = vnovo;
+    ctx->n_vertices = n_novo;
+    ctx->regiao = criaPoligonoCapacidade(2 * n_novo + 1);
+    ctx->emitidos = malloc((n_novo + 1) * sizeof(int));
+    ctx->biombo_apos = malloc((n_novo + 1) * sizeof(Ponto2D));
+    if (!ctx->regiao || !ctx->emitidos || !ctx->biombo_apos) {
+        printf("Erro de alocação para a varredura da visibilidade\n");
+        exit(1);
+    }
+    
+    // Antes de 'lo' a varredura é idêntica à anterior
+    for (int t = 0; t < lo; t++) {
+        ctx->emitidos[t] = emitidos_ant[antigo[t]];
+        ctx->biombo_apos[t] = biombo_ant[antigo[t]];
+    }
+    int ja_emitidos = (lo > 0) ? emitidos_ant[antigo[lo - 1]] : 0;
+    for (int t = 0; t < ja_emitidos; t++) {
+        insereVerticeXY(ctx->regiao, getXVertice(regiao_ant, t), getYVertice(regiao_ant, t));
+    }
+    
+    // Retoma a varredura em 'lo' com o status que ela teria ali
+    if (lo == 0) {
+        iniciaVarredura(ctx);
+    } else {
+        iniciaStatus(ctx);
+        for (int t = 0; t < lo; t++) {
+            ctx->raio = vnovo[t].ponto;
+            if (vnovo[t].tipo == INICIO) insereSegmentoAtivo(ctx, vnovo[t].pSeg);
+            else removeSegmentoAtivo(ctx, vnovo[t].pSeg);
+        }
+        ctx->biombo = biombo_ant[antigo[lo - 1]];
+    }
+    
+    // Passado o setor alterado, se o biombo volta a coincidir com o da varredura
+    // anterior o resto dela é reaproveitado
+    int t = lo;
+    bool convergiu = false;
+    for (; t < n_novo; t++) {
+        processaVertice(ctx, &vnovo[t]);
+        registraPasso(ctx, t);
+        
+        int a = antigo[t];
+        if (t > hi && a >= 0 && vnovo[t].ang > ang_limite + MARGEM_CONVERGENCIA &&
+            ctx->biombo.x == biombo_ant[a].x && ctx->biombo.y == biombo_ant[a].y) {
+            convergiu = true;
+            break;
+        }
+    }
+    
+    if (convergiu) {
+        int delta = ctx->emitidos[t] - emitidos_ant[antigo[t]];
+        for (int u = emitidos_ant[antigo[t]]; u < n_regiao_ant; u++) {
+            insereVerticeXY(ctx->regiao, getXVertice(regiao_ant, u), getYVertice(regiao_ant, u));
+        }
+        for (int u = t + 1; u < n_novo; u++) {
+            ctx->emitidos[u] = emitidos_ant[antigo[u]] + delta;
+            ctx->biombo_apos[u] = biombo_ant[antigo[u]];
+        }
+        ctx->biombo = ctx->biombo_apos[n_novo - 1];
+    }
+    
+    fechaPoligono(ctx);
+    
+    liberaPoligono(regiao_ant);
+    free(emitidos_ant);
+    free(biombo_ant);
+    free(antigo);
+    
+    // O índice angular era do polígono anterior
+    free(ctx->indice.ang);
+    free(ctx->indice.pts);
+    ctx->indice.estado = 0;
+    ctx->indice.n = 0;
+    ctx->indice.ang = NULL;
+    ctx->indice.pts = NULL;
+    
+    return true;
+}
+
+int getNumSegmentosVisibilidade(ContextoVisibilidade C) {
+    if (!C) return 0;
+    CtxVis* ctx = (CtxVis*)C;
+    
+    int n = 0;
+    for (int i = 0; i < ctx->n_segmentos; i++) {
+        if (!ctx->segmentos[i].removido) n++;
+    }
+    return n;
 }
 
-Lista getRegiaoVisibilidade(ContextoVisibilidade C) {
+Poligono getPoligonoVisibilidade(ContextoVisibilidade C) {
     if (!C) return NULL;
-    return ((CtxVis*)C)->regiao_visibilidade;
+    return ((CtxVis*)C)->regiao;
+}
+
+// V(x) é estrelado em relação ao observador: percorrendo os vértices, o ângulo só
+// cresce (a menos de TOLERANCIA_ANGULAR), exceto uma única volta de +pi para -pi. Nesse caso guarda os vértices a
+// partir do de menor ângulo; senão marca o índice como inválido.
+static void constroiIndiceAngular(CtxVis* ctx) {
+    IndiceAngular* ind = &ctx->indice;
+    ind->estado = -1;
+    
+    int n = getNumVertices(ctx->regiao);
+    if (n < 3) return;
+    
+    float* ang = malloc(n * sizeof(float));
+    Ponto2D* pts = malloc(n * sizeof(Ponto2D));
+    if (!ang || !pts) {
+        free(ang);
+        free(pts);
+        return;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        pts[i].x = getXVertice(ctx->regiao, i);
+        pts[i].y = getYVertice(ctx->regiao, i);
+        if (distancia(ctx->x, pts[i]) < EPSILON) {
+            free(ang);
+            free(pts);
+            return;
+        }
+        ang[i] = angulo(ctx->x, pts[i]);
+    }
+    
+    int descidas = 0, inicio = 0;
+    bool monotono = true;
+    for (int i = 0; i < n && monotono; i++) {
+        int j = (i + 1) % n;
+        float passo = ang[j] - ang[i];
+        if (passo < -TOLERANCIA_ANGULAR) {
+            descidas++;
+            inicio = j;
+            passo += 2 * M_PI;
+        }
+        // Uma aresta que gira meia volta ou mais não separa o plano pelo lado
+        if (passo >= M_PI) monotono = false;
+    }
+    
+    if (!monotono || descidas != 1) {
+        free(ang);
+        free(pts);
+        return;
+    }
+    
+    ind->ang = malloc(n * sizeof(float));
+    ind->pts = malloc(n * sizeof(Ponto2D));
+    if (ind->ang && ind->pts) {
+        for (int k = 0; k < n; k++) {
+            ind->ang[k] = ang[(inicio + k) % n];
+            ind->pts[k] = pts[(inicio + k) % n];
+            // Arestas radiais podem recuar por arredondamento; a busca precisa de ordem
+            if (k > 0 && ind->ang[k] < ind->ang[k - 1]) ind->ang[k] = ind->ang[k - 1];
+        }
+        ind->n = n;
+        ind->estado = 1;
+    } else {
+        free(ind->ang);
+        free(ind->pts);
+        ind->ang = NULL;
+        ind->pts = NULL;
+    }
+    
+    free(ang);
+    free(pts);
 }
 
-void getCoordenadasSegmentoVis(SegmentoVisibilidade seg,
-                               float* x1, float* y1,
-                               float* x2, float* y2) {
-    if (!seg) return;
-    SegmentoInterno* s = (SegmentoInterno*)seg;
-    if (x1) *x1 = s->pto_ini.x;
-    if (y1) *y1 = s->pto_ini.y;
-    if (x2) *x2 = s->pto_fim.x;
-    if (y2) *y2 = s->pto_fim.y;
+// Aresta k liga pts[k] a pts[k+1] e cobre o setor [ang[k], ang[k+1]); a aresta n-1
+// fecha o polígono e cobre o setor que atravessa a costura em -pi
+static int arestaDoAngulo(IndiceAngular* ind, float theta) {
+    int n = ind->n;
+    if (theta < ind->ang[0] || theta >= ind->ang[n - 1]) return n - 1;
+    
+    // Último vértice com ângulo <= theta
+    int lo = 0, hi = n - 1;
+    while (hi - lo > 1) {
+        int meio = lo + (hi - lo) / 2;
+        if (ind->ang[meio] <= theta) lo = meio;
+        else hi = meio;
+    }
+    return lo;
+}
+
+// Vértices em sentido anti-horário: o interior fica à esquerda da aresta
+static bool ladoInterno(IndiceAngular* ind, int k, float px, float py) {
+    Ponto2D a = ind->pts[k];
+    Ponto2D b = ind->pts[(k + 1) % ind->n];
+    double ex = (double)b.x - a.x;
+    double ey = (double)b.y - a.y;
+    double qx = (double)px - a.x;
+    double qy = (double)py - a.y;
+    return ex * qy - ey * qx >= 0;
+}
+
+// Busca binária da aresta cujo setor angular contém o ponto e teste de lado dela
+static bool dentroPorIndice(CtxVis* ctx, float px, float py) {
+    IndiceAngular* ind = &ctx->indice;
+    float theta = angulo(ctx->x, (Ponto2D){px, py});
+    return ladoInterno(ind, arestaDoAngulo(ind, theta), px, py);
+}
+
+static bool classificaPonto(CtxVis* ctx, float px, float py) {
+    if (fabs(px - ctx->x.x) < EPSILON && fabs(py - ctx->x.y) < EPSILON) {
+        return true;
+    }
+    
+    if (ctx->indice.estado == 1) {
+        return dentroPorIndice(ctx, px, py);
+    }
+    return isInsideXY(ctx->regiao, px, py);
 }
 
 bool pontoVisivel(ContextoVisibilidade C, float px, float py) {
     if (!C) return false;
     CtxVis* ctx = (CtxVis*)C;
     
-    if (fabs(px - ctx->x.x) < EPSILON && fabs(py - ctx->x.y) < EPSILON) {
-        return true;
+    if (ctx->indice.estado == 0) constroiIndiceAngular(ctx);
+    return classificaPonto(ctx, px, py);
+}
+
+void pontosVisiveis(ContextoVisibilidade C, const float* xs, const float* ys, int n, bool* saida) {
+    if (!C || !xs || !ys || !saida) return;
+    CtxVis* ctx = (CtxVis*)C;
+    
+    if (ctx->indice.estado == 0) constroiIndiceAngular(ctx);
+    for (int i = 0; i < n; i++) {
+        saida[i] = classificaPonto(ctx, xs[i], ys[i]);
     }
+}
+
+/* ================= Perfil angular de profundidade ================= */
+
+static float normalizaTheta(float theta) {
+    while (theta < -M_PI) theta += 2 * M_PI;
+    while (theta >= M_PI) theta -= 2 * M_PI;
+    return theta;
+}
+
+static float distPontoSegmento(float px, float py, float x1, float y1, float x2, float y2) {
+    float dx = x2 - x1;
+    float dy = y2 - y1;
+    float len2 = dx*dx + dy*dy;
+    float t = 0;
     
-    int interseccoes = 0;
-    for (Celula c = getInicioLista(ctx->regiao_visibilidade); c; c = getProxCelula(c)) {
-        SegmentoInterno* s = (SegmentoInterno*)getConteudoCelula(c);
-        
-        float y1 = s->pto_ini.y;
-        float y2 = s->pto_fim.y;
+    if (len2 >= EPSILON) {
+        t = ((px - x1) * dx + (py - y1) * dy) / len2;
+        t = fmax(0, fmin(1, t));
+    }
+    
+    dx = px - (x1 + t * dx);
+    dy = py - (y1 + t * dy);
+    return sqrt(dx*dx + dy*dy);
+}
+
+// Intervalo angular [*lo, *hi] ocupado por pontos vistos do observador.
+// Os ângulos são medidos a partir do primeiro ponto, então o intervalo pode passar de +-pi.
+static void intervaloAngular(CtxVis* ctx, const float* xs, const float* ys, int n,
+                             float* lo, float* hi) {
+    float base = angulo(ctx->x, (Ponto2D){xs[0], ys[0]});
+    float dmin = 0, dmax = 0;
+    for (int i = 1; i < n; i++) {
+        float d = normalizaTheta(angulo(ctx->x, (Ponto2D){xs[i], ys[i]}) - base);
+        if (d < dmin) dmin = d;
+        if (d > dmax) dmax = d;
+    }
+    *lo = base + dmin;
+    *hi = base + dmax;
+}
+
+// Arestas de V(x) cujos setores cobrem [lo, hi], em ordem angular
+typedef struct {
+    int atual;
+    int ultima;
+    int restantes;
+} PercursoArestas;
+
+static PercursoArestas iniciaPercurso(IndiceAngular* ind, float lo, float hi) {
+    // Uma aresta a mais de cada lado: um ponto da forma exatamente no ângulo de um
+    // vértice de V(x) pode tocar a aresta anterior ou a seguinte
+    int n = ind->n;
+    int ini = arestaDoAngulo(ind, normalizaTheta(lo));
+    int fim = arestaDoAngulo(ind, normalizaTheta(hi));
+    
+    // Arestas radiais seguidas têm vértices de mesmo ângulo e a busca para no último
+    // deles; um extremo da forma sobre esse raio pode tocar qualquer uma, então o
+    // percurso cobre a sequência inteira
+    float ang_ini = ind->ang[ini], ang_fim = ind->ang[fim];
+    while (ini > 0 && ind->ang[ini - 1] >= ang_ini - TOLERANCIA_ANGULAR) ini--;
+    while (fim < n - 1 && ind->ang[fim + 1] <= ang_fim + TOLERANCIA_ANGULAR) fim++;
+    
+    PercursoArestas p;
+    p.atual = (ini + n - 1) % n;
+    p.ultima = (fim + 1) % n;
+    p.restantes = n;
+    return p;
+}
+
+static int proximaAresta(PercursoArestas* p, int n) {
+    if (p->restantes <= 0) return -1;
+    int k = p->atual;
+    p->restantes = (k == p->ultima) ? 0 : p->restantes - 1;
+    p->atual = (k + 1) % n;
+    return k;
+}
+
+// Setor [*ini, *fim] coberto pela aresta k, em ângulos relativos a 'centro' (*ini em [-pi, pi))
+static void setorAresta(IndiceAngular* ind, int k, float centro, float* ini, float* fim) {
+    float a0 = ind->ang[k];
+    float a1 = (k + 1 < ind->n) ? ind->ang[k + 1] : ind->ang[0] + 2 * M_PI;
+    *ini = normalizaTheta(a0 - centro);
+    *fim = *ini + (a1 - a0);
+}
+
+// Distância do observador até a reta por a e b, ao longo do raio de ângulo theta.
+// Reta radial (paralela ao raio): o mais próximo dos dois pontos
+static float distanciaNoAngulo(Ponto2D x, float theta, Ponto2D a, Ponto2D b) {
+    double dx = cos(theta), dy = sin(theta);
+    double ex = (double)b.x - a.x, ey = (double)b.y - a.y;
+    double ax = (double)a.x - x.x, ay = (double)a.y - x.y;
+    double den = dx * ey - dy * ex;
+    if (fabs(den) < EPSILON) {
+        float da = distancia(x, a), db = distancia(x, b);
+        return da < db ? da : db;
+    }
+    return (float)((ax * ey - ay * ex) / den);
+}
+
+float profundidadeVisibilidade(ContextoVisibilidade C, float theta) {
+    if (!C) return 0.0f;
+    CtxVis* ctx = (CtxVis*)C;
+    
+    if (ctx->indice.estado == 0) constroiIndiceAngular(ctx);
+    if (ctx->indice.estado != 1) return -1.0f;
+    
+    IndiceAngular* ind = &ctx->indice;
+    int k = arestaDoAngulo(ind, normalizaTheta(theta));
+    return distanciaNoAngulo(ctx->x, theta, ind->pts[k], ind->pts[(k + 1) % ind->n]);
+}
+
+// No raio de ângulo theta, o segmento p1-p2 vem antes da aresta a-b de V(x)?
+// 'dmin' é a distância do observador ao segmento. As profundidades são limitadas
+// pelo que cada segmento alcança, para um raio quase paralelo não dar valor espúrio
+static bool segmentoAntesDaAresta(CtxVis* ctx, float theta, Ponto2D p1, Ponto2D p2, float dmin,
+                                  Ponto2D a, Ponto2D b) {
+    float fronteira = fmin(distanciaNoAngulo(ctx->x, theta, a, b),
+                           fmax(distancia(ctx->x, a), distancia(ctx->x, b)));
+    float prof = fmax(distanciaNoAngulo(ctx->x, theta, p1, p2), dmin);
+    return prof <= fronteira;
+}
+
+static bool segmentoAtingido(CtxVis* ctx, float x1, float y1, float x2, float y2) {
+    IndiceAngular* ind = &ctx->indice;
+    Ponto2D p1 = {x1, y1}, p2 = {x2, y2};
+    
+    // Segmento passando pelo observador: o próprio observador é visível
+    float dmin = distPontoSegmento(ctx->x.x, ctx->x.y, x1, y1, x2, y2);
+    if (dmin < EPSILON) return true;
+    
+    float xs[2] = {x1, x2}, ys[2] = {y1, y2};
+    float lo, hi;
+    intervaloAngular(ctx, xs, ys, 2, &lo, &hi);
+    float centro = (lo + hi) / 2, meia = (hi - lo) / 2;
+    
+    // Em cada pedaço do setor do segmento coberto por uma só aresta, fronteira e
+    // segmento são retas e a ordem das duas ao longo do raio troca no máximo uma
+    // vez: basta comparar as profundidades nas pontas do pedaço. Segmento rente à
+    // aresta (um anteparo que delimita V(x)) conta como atingido.
+    PercursoArestas p = iniciaPercurso(ind, lo, hi);
+    for (int k = proximaAresta(&p, ind->n); k >= 0; k = proximaAresta(&p, ind->n)) {
+        Ponto2D a = ind->pts[k];
+        Ponto2D b = ind->pts[(k + 1) % ind->n];
+        if (segmentosSeTocam(x1, y1, x2, y2, a.x, a.y, b.x, b.y)) return true;
         
-        if ((y1 <= py && y2 > py) || (y2 <= py && y1 > py)) {
-            float x_inter = s->pto_ini.x + (py - s->pto_ini.y) * (s->pto_fim.x - s->pto_ini.x) / (s->pto_fim.y - s->pto_ini.y);
-            if (x_inter > px) {
-                interseccoes++;
+        float ini, fim;
+        setorAresta(ind, k, centro, &ini, &fim);
+        for (int volta = 0; volta < 2; volta++, ini -= 2 * M_PI, fim -= 2 * M_PI) {
+            float t0 = fmax(ini, -meia), t1 = fmin(fim, meia);
+            if (t0 > t1) continue;
+            if (segmentoAntesDaAresta(ctx, centro + t0, p1, p2, dmin, a, b) ||
+                segmentoAntesDaAresta(ctx, centro + t1, p1, p2, dmin, a, b)) {
+                return true;
             }
         }
     }
+    return false;
+}
+
+static bool circuloAtingido(CtxVis* ctx, float cx, float cy, float r) {
+    IndiceAngular* ind = &ctx->indice;
+    
+    if (dentroPorIndice(ctx, cx, cy)) return true;
+    
+    float d = distancia(ctx->x, (Ponto2D){cx, cy});
+    if (d <= r) return true;  // Observador dentro do círculo
+    
+    float centro = angulo(ctx->x, (Ponto2D){cx, cy});
+    float meia_abertura = asin(r / d);
+    
+    PercursoArestas p = iniciaPercurso(ind, centro - meia_abertura, centro + meia_abertura);
+    for (int k = proximaAresta(&p, ind->n); k >= 0; k = proximaAresta(&p, ind->n)) {
+        Ponto2D a = ind->pts[k];
+        Ponto2D b = ind->pts[(k + 1) % ind->n];
+        if (distPontoSegmento(cx, cy, a.x, a.y, b.x, b.y) <= r) return true;
+    }
+    return false;
+}
+
+static bool retanguloAtingido(CtxVis* ctx, float rx, float ry, float w, float h) {
+    if (ctx->x.x >= rx && ctx->x.x <= rx + w && ctx->x.y >= ry && ctx->x.y <= ry + h) {
+        return true;  // Observador dentro do retângulo
+    }
     
-    return (interseccoes % 2) == 1;
+    // Com o observador fora, V(x) só entra no retângulo atravessando algum lado
+    float vx[4] = {rx, rx + w, rx + w, rx};
+    float vy[4] = {ry, ry, ry + h, ry + h};
+    for (int i = 0; i < 4; i++) {
+        int j = (i + 1) % 4;
+        if (segmentoAtingido(ctx, vx[i], vy[i], vx[j], vy[j])) return true;
+    }
+    return false;
+}
+
+bool formaAtingida(ContextoVisibilidade C, Forma f) {
+    if (!C || !f) return false;
+    CtxVis* ctx = (CtxVis*)C;
+    
+    if (ctx->indice.estado == 0) constroiIndiceAngular(ctx);
+    if (ctx->indice.estado != 1) {
+        return formaIntersectaPoligono(ctx->regiao, f);
+    }
+    
+    void* data = getDataForma(f);
+    
+    switch (getTipoForma(f)) {
+        case CIRCLE:
+            return circuloAtingido(ctx, getXCirculo(data), getYCirculo(data), getRaioCirculo(data));
+            
+        case RECTANGLE:
+            return retanguloAtingido(ctx, getXRetangulo(data), getYRetangulo(data),
+                                     getLarguraRetangulo(data), getAlturaRetangulo(data));
+            
+        case LINE:
+            return segmentoAtingido(ctx, getX1Linha(data), getY1Linha(data),
+                                    getX2Linha(data), getY2Linha(data));
+            
+        case ANTEPARO:
+            return segmentoAtingido(ctx, getX1Anteparo(data), getY1Anteparo(data),
+                                    getX2Anteparo(data), getY2Anteparo(data));
+            
+        case TEXT: {
+            // Texto é tratado como o segmento horizontal de 10 unidades por caractere
+            float tx = getXTexto(data);
+            float ty = getYTexto(data);
+            char anc = getAncoraTexto(data);
+            float L = 10.0f * strlen(getTxtTexto(data));
+            float x1 = tx - L/2;
+            if (anc == 'i' || anc == 'I') x1 = tx;
+            else if (anc == 'f' || anc == 'F') x1 = tx - L;
+            return segmentoAtingido(ctx, x1, ty, x1 + L, ty);
+        }
+        
+        default:
+            return false;
+    }
 }
 
 void liberaContextoVisibilidade(ContextoVisibilidade C) {
@@ -467,13 +1649,13 @@ void liberaContextoVisibilidade(ContextoVisibilidade C) {
     
     free(ctx->segmentos);
     free(ctx->vertices);
+    free(ctx->emitidos);
+    free(ctx->biombo_apos);
     liberaArvoreBinaria(ctx->SegsAtvs, NULL);
     
-    while (!listaVazia(ctx->regiao_visibilidade)) {
-        SegmentoInterno* s = removeInicioLista(ctx->regiao_visibilidade);
-        free(s);
-    }
-    liberaLista(ctx->regiao_visibilidade);
+    liberaPoligono(ctx->regiao);
+    free(ctx->indice.ang);
+    free(ctx->indice.pts);
     
     free(ctx);
 }
@@ -16,8 +16,9 @@
  */
 
 #include <stdbool.h>
-#include "lista.h"
+#include "vetor.h"
 #include "forma.h"
+#include "poligono.h"
 
 /**
  * @typedef ContextoVisibilidade
@@ -30,37 +31,36 @@
  */
 typedef void* ContextoVisibilidade;
 
-/**
- * @typedef SegmentoVisibilidade
- * @brief Tipo opaco que representa um segmento da região de visibilidade.
- *
- * Cada segmento delimita parte da fronteira da área visível a partir do
- * ponto observador.
- */
-typedef void* SegmentoVisibilidade;
-
 /**
  * @brief Cria um contexto de visibilidade para um observador.
  *
  * Inicializa todas as estruturas de dados necessárias para realizar cálculos
  * de visibilidade a partir de um ponto observador (bx, by). Extrai os anteparos
- * da lista de formas fornecida e executa o algoritmo de varredura angular para
+ * do vetor de formas fornecido e executa o algoritmo de varredura angular para
  * calcular a região de visibilidade.
  *
  * O algoritmo:
  * 1. Cria retângulo envolvente
- * 2. Traça raio inicial e divide segmentos interceptados
- * 3. Ordena vértices por ângulo, distância e tipo
- * 4. Executa varredura angular mantendo segmentos ativos
- * 5. Constrói região de visibilidade V(x)
+ * 2. Descarta os anteparos escondidos atrás de um anel fechado de anteparos
+ *    próximos: cresce anéis de células em torno do observador
+ *    (grade_segmentos.h) até que os anteparos achados cubram todas as
+ *    direções, e ignora os que ficam inteiros além deles
+ * 3. Divide os anteparos nos pontos em que se cruzam (intersecao_segmentos.h)
+ * 4. Ordena vértices por ângulo, distância e tipo
+ * 5. Traça raio inicial (ângulo -pi) com os segmentos que ele intercepta
+ * 6. Executa varredura angular mantendo os segmentos ativos ordenados por
+ *    distância ao observador
+ * 7. Constrói região de visibilidade V(x)
  *
  * @param bx Coordenada X do ponto observador (bomba).
  * @param by Coordenada Y do ponto observador (bomba).
- * @param formas Lista de formas geométricas contendo os anteparos (obstáculos).
- * @param tipo_sort Tipo de ordenação ('q' para quicksort, 'm' para mergesort).
+ * @param formas Vetor de formas geométricas contendo os anteparos (obstáculos).
+ * @param tipo_sort Tipo de ordenação ('q' para introsort, 'm' para mergesort,
+ *                  'p' para mergesort paralelo em conjuntos grandes,
+ *                  'r' para radix sort sobre chave de 64 bits).
  *                  Usado para ordenar vértices por ângulo.
  * @param threshold Limiar para uso de insertion sort em sub-arrays pequenos.
- *                  Usado em conjunto com tipo_sort para otimização.
+ *                  Aplicado às folhas da recursão do algoritmo escolhido.
  *
  * @return ContextoVisibilidade Contexto inicializado, ou NULL em caso de erro.
  *
@@ -73,47 +73,107 @@ typedef void* SegmentoVisibilidade;
 ContextoVisibilidade criaContextoVisibilidade(
     float bx,
     float by,
-    Lista formas,
+    Vetor formas,
     char tipo_sort,
     int threshold
 );
 
 /**
- * @brief Retorna a região de visibilidade calculada.
+ * @brief Cria um contexto com V(x) aproximado por raios, sem varredura angular.
+ *
+ * Lança `n_raios` raios igualmente espaçados a partir do observador contra uma
+ * grade dos anteparos (grade_segmentos.h), cada um percorrendo só as células
+ * que corta, e liga os pontos atingidos num polígono de `n_raios` vértices.
+ * Dispensa a ordenação dos vértices e o status da varredura; serve para
+ * prévias, em que a região exata não é necessária.
+ *
+ * O contexto é usado pelas mesmas funções do exato (getPoligonoVisibilidade(),
+ * pontoVisivel(), formaAtingida()...). atualizaContextoVisibilidade() sempre
+ * o recusa.
+ *
+ * @param bx Coordenada X do ponto observador (bomba).
+ * @param by Coordenada Y do ponto observador (bomba).
+ * @param formas Vetor de formas geométricas contendo os anteparos.
+ * @param n_raios Número de raios (resolução angular de 2*pi/n_raios).
+ *
+ * @return Contexto criado, ou NULL se `formas` for NULL ou n_raios < 3.
+ *
+ * @see getErroVisibilidade()
+ */
+ContextoVisibilidade criaContextoVisibilidadeAprox(
+    float bx,
+    float by,
+    Vetor formas,
+    int n_raios
+);
+
+/**
+ * @brief Limite do erro de um contexto aproximado.
+ *
+ * Maior arco entre dois raios vizinhos, medido na maior das duas
+ * profundidades atingidas. Um anteparo ou forma mais estreito que isso pode
+ * passar entre os raios sem ser visto.
+ *
+ * @param C Contexto de visibilidade.
+ * @return Limite do erro, ou 0 para um contexto exato.
+ */
+float getErroVisibilidade(ContextoVisibilidade C);
+
+/**
+ * @brief Retorna o polígono da região de visibilidade calculada.
  *
- * Retorna uma lista de segmentos que delimitam a área visível a partir do
- * ponto observador. Cada segmento é do tipo SegmentoVisibilidade.
+ * Os vértices são emitidos pela varredura angular diretamente no buffer
+ * contíguo do polígono, na ordem angular em torno do observador.
  *
  * @param C Contexto de visibilidade previamente criado.
  *
- * @return Lista de SegmentoVisibilidade* que formam a região de visibilidade,
- *         ou NULL se o contexto for inválido.
+ * @return Polígono V(x) (pode ter zero vértices), ou NULL se o contexto
+ *         for inválido.
  *
- * @note A lista retornada pertence ao contexto e será liberada automaticamente
- *       quando liberaContextoVisibilidade() for chamado. Não libere a lista
- *       manualmente.
- * @note Os segmentos na lista estão ordenados conforme foram gerados durante
- *       a varredura angular.
+ * @note O polígono pertence ao contexto e é liberado por
+ *       liberaContextoVisibilidade(). Para mantê-lo depois disso, use
+ *       copiaPoligono().
  *
  * @see criaContextoVisibilidade()
  */
-Lista getRegiaoVisibilidade(ContextoVisibilidade C);
+Poligono getPoligonoVisibilidade(ContextoVisibilidade C);
 
 /**
- * @brief Obtém as coordenadas de um segmento de visibilidade.
+ * @brief Número de segmentos que entraram na varredura.
  *
- * @param seg Segmento de visibilidade.
- * @param x1 Ponteiro para armazenar coordenada X do ponto inicial.
- * @param y1 Ponteiro para armazenar coordenada Y do ponto inicial.
- * @param x2 Ponteiro para armazenar coordenada X do ponto final.
- * @param y2 Ponteiro para armazenar coordenada Y do ponto final.
+ * Conta os quatro lados do retângulo envolvente e os pedaços dos anteparos
+ * que não foram descartados por estarem escondidos.
  *
- * @note Todos os ponteiros devem ser não-nulos.
+ * @param C Contexto de visibilidade previamente criado.
+ * @return Número de segmentos, ou 0 se o contexto for inválido.
  */
-void getCoordenadasSegmentoVis(
-    SegmentoVisibilidade seg,
-    float* x1, float* y1,
-    float* x2, float* y2
+int getNumSegmentosVisibilidade(ContextoVisibilidade C);
+
+/**
+ * @brief Atualiza o contexto depois que anteparos foram inseridos ou removidos.
+ *
+ * Compara os anteparos do contexto com os do vetor (por endereço e
+ * coordenadas). Os vértices dos segmentos alterados são retirados ou
+ * intercalados na ordem angular já existente, sem reordenar tudo. A varredura
+ * é retomada no primeiro vértice alterado, a partir do estado guardado da
+ * varredura anterior. Passado o último vértice alterado, assim que o estado
+ * volta a coincidir com o anterior, o restante de V(x) é reaproveitado. O
+ * resultado é o mesmo de criaContextoVisibilidade() com o vetor atual.
+ *
+ * @param C Contexto de visibilidade previamente criado.
+ * @param formas Vetor de formas atual.
+ *
+ * @return true se o contexto foi atualizado (ou já estava em dia); false se
+ *         não puder ser atualizado, por exemplo porque o retângulo envolvente
+ *         das formas mudou ou saiu um anteparo do anel que escondia os
+ *         demais. Nesse caso o contexto fica como estava e deve ser recriado.
+ *
+ * @note O polígono obtido antes por getPoligonoVisibilidade() é liberado
+ *       quando há alteração.
+ */
+bool atualizaContextoVisibilidade(
+    ContextoVisibilidade C,
+    Vetor formas
 );
 
 /**
@@ -130,7 +190,10 @@ void getCoordenadasSegmentoVis(
  * @return true se o ponto é visível (não obstruído), false caso contrário.
  *
  * @note Um ponto coincidente com o observador é sempre considerado visível.
- * @note A verificação usa ray casting na região de visibilidade calculada.
+ * @note Na primeira consulta é montado um índice dos vértices de V(x) por
+ *       ângulo; cada consulta faz uma busca binária e um teste de lado da
+ *       aresta, O(log n). Se V(x) não for monótono em ângulo em torno do
+ *       observador, usa ray casting no polígono.
  *
  * @see criaContextoVisibilidade()
  */
@@ -140,6 +203,72 @@ bool pontoVisivel(
     float py
 );
 
+/**
+ * @brief Classifica vários pontos de uma vez quanto à visibilidade.
+ *
+ * Equivale a chamar pontoVisivel() para cada ponto, aproveitando o mesmo
+ * índice angular.
+ *
+ * @param C Contexto de visibilidade previamente criado.
+ * @param xs Coordenadas X dos pontos.
+ * @param ys Coordenadas Y dos pontos.
+ * @param n Número de pontos.
+ * @param saida Recebe, para cada ponto, true se visível.
+ */
+void pontosVisiveis(
+    ContextoVisibilidade C,
+    const float* xs,
+    const float* ys,
+    int n,
+    bool* saida
+);
+
+/**
+ * @brief Perfil angular de profundidade de V(x).
+ *
+ * Distância do observador até a fronteira da região visível na direção
+ * `theta`, isto é, até o anteparo mais próximo (ou o retângulo envolvente)
+ * naquela direção.
+ *
+ * @param C Contexto de visibilidade previamente criado.
+ * @param theta Direção em radianos, como em atan2.
+ *
+ * @return Distância até a fronteira, ou -1 se V(x) não for monótono em
+ *         ângulo (nesse caso o perfil não está disponível).
+ */
+float profundidadeVisibilidade(
+    ContextoVisibilidade C,
+    float theta
+);
+
+/**
+ * @brief Verifica se a explosão a partir do observador atinge a forma.
+ *
+ * A forma é atingida se alguma parte dela está na região visível. Com o
+ * perfil angular, isso se resolve olhando só o setor angular ocupado pela
+ * forma: busca-se por busca binária a primeira aresta de V(x) do setor e
+ * percorrem-se apenas as que o cobrem, O(log V + k). Segmentos (linhas,
+ * anteparos, textos e lados de retângulo) são atingidos se, em algum ângulo
+ * do setor, ficam antes da profundidade de profundidadeVisibilidade();
+ * círculos, se o centro é visível ou alguma dessas arestas passa a até um
+ * raio do centro.
+ *
+ * Segmentos que encostam numa aresta de V(x) contam como atingidos, com a
+ * mesma tolerância de formaIntersectaPoligono() (segmentosSeTocam()): um
+ * anteparo visível fica exatamente sobre a fronteira. O resultado é o mesmo
+ * de formaIntersectaPoligono() sobre o polígono de visibilidade, à qual
+ * recorre quando V(x) não é monótono em ângulo.
+ *
+ * @param C Contexto de visibilidade previamente criado.
+ * @param f Forma a testar.
+ *
+ * @return true se a forma é atingida.
+ */
+bool formaAtingida(
+    ContextoVisibilidade C,
+    Forma f
+);
+
 /**
  * @brief Libera toda a memória alocada para o contexto de visibilidade.
  *
@@ -147,7 +276,7 @@ bool pontoVisivel(
  * - Array de segmentos
  * - Array de vértices ordenados
  * - Árvore binária de segmentos ativos
- * - Lista de segmentos da região de visibilidade
+ * - Polígono da região de visibilidade
  * - Outras estruturas de dados temporárias
  *
  * @param C Contexto de visibilidade a ser liberado.